@@ -2,8 +2,8 @@
  * @file Version.h
  * @brief Version information about DwfUtil lib 
  * @author Sign Coding Dwarf
- * @version 2.0
- * @date 15 May 2016
+ * @version 2.1
+ * @date 19 October 2026
  *
  * Definition of DwfUtils version constants and numeric form.
  *
@@ -35,7 +35,7 @@ limitations under the License.
 * @def DWFUTILS_VERSION_MINOR
 * @brief Minor version number
 */
-#define DWFUTILS_VERSION_MINOR 0
+#define DWFUTILS_VERSION_MINOR 1
 
 /*! 
 * @def DWFUTILS_VERSION_REVISION
@@ -55,7 +55,7 @@ limitations under the License.
 * @brief Version as a numeric constant for compilation purport
 *
 * To check if library has indeed current version do 
-* \a \#if \a DWFUTILS_VERSION_NUMERIC==111552336
+* \a \#if \a DWFUTILS_VERSION_NUMERIC==111580308
 *
 */
 #define DWFUTILS_VERSION_NUMERIC DWFUTILS_VERSION
@@ -0,0 +1,652 @@
+/*!
+ * @file binaryLogger.h
+ * @brief Class used to log records in split files with deferred formatting
+ * @author Sign Coding Dwarf
+ * @version 1.0
+ * @date 19 October 2026
+ *
+ * Definition of the logger copying raw arguments and a format id into a buffer owned by the calling thread. Text formatting is done by a background thread writing into a fileSplitter, or offline by decodeBinaryLog when binary files are written.
+ * Logging a record only costs a few copies so that formatting never lands on the logging thread. <br>
+ * To test if it is available with your library version use <br>
+ * \a \#if \a DWFUTILS_VERSION_NUMERIC>=111580308
+ *
+ */
+
+/*
+Copyright 2016 SignCodingDwarf
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+
+#ifndef BINARYLOGGER
+#define BINARYLOGGER
+
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <type_traits>
+#include <iostream>
+#include <cstring>
+#include <stdint.h>
+
+#include "common_defines.h"
+#include "fileSplitter.h"
+
+/*!
+* @def BINARYLOGGER_BUFFER_SIZE
+* @brief Default size of the buffer of each logging thread in bytes. Must be a power of two.
+*/
+#ifndef BINARYLOGGER_BUFFER_SIZE
+#define BINARYLOGGER_BUFFER_SIZE (1 << 20)
+#endif
+
+/*!
+* @def BINARYLOGGER_MIN_BUFFER_SIZE
+* @brief Smallest size of the buffer of each logging thread in bytes. Must be a power of two.
+*/
+#ifndef BINARYLOGGER_MIN_BUFFER_SIZE
+#define BINARYLOGGER_MIN_BUFFER_SIZE (1 << 12)
+#endif
+
+/*!
+* @def BINARYLOGGER_POLL_TIME
+* @brief Time slept by the background thread when no record is available, in microseconds
+*/
+#ifndef BINARYLOGGER_POLL_TIME
+#define BINARYLOGGER_POLL_TIME 1000
+#endif
+
+/*!
+* @def BINARY_LOG
+* @brief Log a record with a format registered once per call site
+* @param logger : binaryLogger used
+* @param format : format of the record, each {} being replaced by the next argument
+*
+* Remaining macro arguments are the arguments of the record. The format is only registered the first time the call site is reached.
+*/
+#define BINARY_LOG(logger, format, ...) \
+	do \
+	{ \
+		static const unsigned int binaryLogFormatId = dwf_utils::registerFormat(format); \
+		(logger).log(binaryLogFormatId, ##__VA_ARGS__); \
+	} while(0)
+
+/*!
+* @namespace dwf_utils
+* @brief A namespace used to regroup all utilitary functions or classes spanning through multiple applications
+*/
+namespace dwf_utils
+{
+	/*!
+	* @enum binaryLogMode
+	* @brief Output of the binaryLogger
+	*/
+	enum binaryLogMode
+	{
+		BINLOG_TEXT, /*!< Records are formatted by the background thread and written as text */
+		BINLOG_RAW /*!< Records are written as binary and formatted offline with decodeBinaryLog. Formats are written in baseName.formats */
+	};
+
+	/*!
+	* @enum binaryArgType
+	* @brief Tag written before each argument of a binary record
+	*/
+	enum binaryArgType
+	{
+		BINARG_END = 0, /*!< No more argument */
+		BINARG_INT = 'i', /*!< Signed integer stored on 8 bytes */
+		BINARG_UINT = 'u', /*!< Unsigned integer stored on 8 bytes */
+		BINARG_DOUBLE = 'd', /*!< Floating point number stored as a double */
+		BINARG_CHAR = 'c', /*!< Character stored on 1 byte */
+		BINARG_BOOL = 'b', /*!< Boolean stored on 1 byte */
+		BINARG_STRING = 's' /*!< String stored as its length on 4 bytes followed by its characters */
+	};
+
+	/*! \struct binaryArg
+	* \brief Encoding of a logged argument
+	* \tparam T : type of the argument
+	*
+	* Types without specialization cannot be logged. Each specialization gives the encoded size of an argument and writes it after its tag.
+	*
+	*/
+	template <class T, class Enable = void>
+	struct binaryArg;
+
+	/*! \struct binaryArg
+	* \brief Encoding of signed integers
+	*/
+	template <class T>
+	struct binaryArg<T, typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value && !std::is_same<T, char>::value>::type>
+	{
+		static size_t size(T)
+		{
+			return 1 + sizeof(long long);
+		}
+
+		static char* encode(char* out, T data)
+		{
+			long long value = data;
+			*out = BINARG_INT;
+			memcpy(out + 1, &value, sizeof(value));
+			return out + 1 + sizeof(value);
+		}
+	};
+
+	/*! \struct binaryArg
+	* \brief Encoding of unsigned integers
+	*/
+	template <class T>
+	struct binaryArg<T, typename std::enable_if<std::is_integral<T>::value && std::is_unsigned<T>::value && !std::is_same<T, char>::value && !std::is_same<T, bool>::value>::type>
+	{
+		static size_t size(T)
+		{
+			return 1 + sizeof(unsigned long long);
+		}
+
+		static char* encode(char* out, T data)
+		{
+			unsigned long long value = data;
+			*out = BINARG_UINT;
+			memcpy(out + 1, &value, sizeof(value));
+			return out + 1 + sizeof(value);
+		}
+	};
+
+	/*! \struct binaryArg
+	* \brief Encoding of floating point numbers
+	*/
+	template <class T>
+	struct binaryArg<T, typename std::enable_if<std::is_floating_point<T>::value>::type>
+	{
+		static size_t size(T)
+		{
+			return 1 + sizeof(double);
+		}
+
+		static char* encode(char* out, T data)
+		{
+			double value = data;
+			*out = BINARG_DOUBLE;
+			memcpy(out + 1, &value, sizeof(value));
+			return out + 1 + sizeof(value);
+		}
+	};
+
+	/*! \struct binaryArg
+	* \brief Encoding of characters
+	*/
+	template <>
+	struct binaryArg<char>
+	{
+		static size_t size(char)
+		{
+			return 2;
+		}
+
+		static char* encode(char* out, char data)
+		{
+			out[0] = BINARG_CHAR;
+			out[1] = data;
+			return out + 2;
+		}
+	};
+
+	/*! \struct binaryArg
+	* \brief Encoding of booleans
+	*/
+	template <>
+	struct binaryArg<bool>
+	{
+		static size_t size(bool)
+		{
+			return 2;
+		}
+
+		static char* encode(char* out, bool data)
+		{
+			out[0] = BINARG_BOOL;
+			out[1] = data ? 1 : 0;
+			return out + 2;
+		}
+	};
+
+	/*! \struct binaryArg
+	* \brief Encoding of C strings
+	*
+	* The characters are copied, the string may be released once logged.
+	*
+	*/
+	template <>
+	struct binaryArg<const char*>
+	{
+		static size_t size(const char* data)
+		{
+			return 1 + sizeof(uint32_t) + strlen(data);
+		}
+
+		static char* encode(char* out, const char* data)
+		{
+			uint32_t length = static_cast<uint32_t>(strlen(data));
+			*out = BINARG_STRING;
+			memcpy(out + 1, &length, sizeof(length));
+			memcpy(out + 1 + sizeof(length), data, length);
+			return out + 1 + sizeof(length) + length;
+		}
+	};
+
+	/*! \struct binaryArg
+	* \brief Encoding of modifiable C strings
+	*/
+	template <>
+	struct binaryArg<char*> : public binaryArg<const char*>
+	{
+	};
+
+	/*! \struct binaryArg
+	* \brief Encoding of strings
+	*/
+	template <>
+	struct binaryArg<std::string>
+	{
+		static size_t size(std::string const& data)
+		{
+			return 1 + sizeof(uint32_t) + data.size();
+		}
+
+		static char* encode(char* out, std::string const& data)
+		{
+			uint32_t length = static_cast<uint32_t>(data.size());
+			*out = BINARG_STRING;
+			memcpy(out + 1, &length, sizeof(length));
+			memcpy(out + 1 + sizeof(length), data.data(), length);
+			return out + 1 + sizeof(length) + length;
+		}
+	};
+
+	/*!
+	* @brief Register a record format
+	* @param format : format of the records, each {} being replaced by the next argument
+	* @return Id of the format, shared by all binaryLogger instances
+	*
+	* Thread safe. Each call gives a new id, even for a format already registered.
+	*
+	*/
+	unsigned int registerFormat(std::string const& format);
+
+	/*!
+	* @brief Get a registered format
+	* @param id : Id of the format
+	* @param format : receives the format
+	* @return EXEC_SUCCESS if the format is registered and EXEC_FAILURE otherwise
+	*
+	* Thread safe.
+	*
+	*/
+	int getFormat(unsigned int id, std::string& format);
+
+	/*!
+	* @brief Get the name of the formats file of a binaryLogger
+	* @param baseName : base name of the files of the logger
+	* @return baseName.formats
+	*
+	*/
+	std::string formatsName(std::string const& baseName);
+
+	/*!
+	* @brief Format the arguments of a record
+	* @param format : format of the record
+	* @param args : encoded arguments of the record
+	* @param size : number of bytes of the arguments
+	* @param text : string to which the formatted record is appended
+	* @return EXEC_SUCCESS if arguments could be decoded and EXEC_FAILURE otherwise
+	*
+	* Each {} of the format is replaced by the next argument, as written by operator<< on an ostream with default flags. {} without matching argument is kept.
+	*
+	*/
+	int formatBinaryRecord(std::string const& format, const char* args, size_t size, std::string& text);
+
+	/*!
+	* @brief Format binary files offline
+	* @param formatsFile : formats file written by the binaryLogger
+	* @param files : binary files to format, in the order they were written
+	* @param out : flux receiving the text
+	* @return EXEC_SUCCESS if all the records could be formatted and EXEC_FAILURE otherwise
+	*
+	* Gives the same text as a binaryLogger using BINLOG_TEXT.
+	*
+	*/
+	int decodeBinaryLog(std::string const& formatsFile, std::vector<std::string> const& files, std::ostream& out);
+
+	/*! \class binaryLogger
+	* \brief Logger with deferred formatting writing into split files
+	*
+	* Each logging thread owns a ring buffer in which records are copied as a record size, a format id and tagged arguments. A background thread takes the records of all buffers and writes them in a fileSplitter, either formatted or as binary.
+	* Records of a given thread keep their order. Records of different threads never interleave but are not ordered between them.
+	* When the buffer of a thread is full, the thread waits for the background thread.
+	*
+	*/
+	class binaryLogger
+	{
+	public:
+		/*!
+		* @brief Constructor of the binaryLogger class
+		* @param baseName : base name of the files. All files wil be named baseName_<Id>.extension
+		* @param extension : extension of the files
+		* @param fileSize : Maximum number of records (or of bytes with SPLIT_BYTES criterion) written before triggering writing to a new file
+		* @param mode : formatting done by the background thread. Default is BINLOG_TEXT.
+		* @param options : optional behaviours of the underlying fileSplitter
+		* @param bufferSize : size of the buffer of each logging thread in bytes, rounded up to a power of two of at least BINARYLOGGER_MIN_BUFFER_SIZE. Default is BINARYLOGGER_BUFFER_SIZE.
+		*
+		* Constructor of the binaryLogger class. Opens the first file and starts the background thread.
+		* With BINLOG_RAW, a committed record is a valid split point so SPLIT_BYTES files are split on records.
+		*
+		*/
+		binaryLogger(std::string baseName, std::string extension, unsigned long fileSize, binaryLogMode mode = BINLOG_TEXT, splitterOptions const& options = splitterOptions(), size_t bufferSize = BINARYLOGGER_BUFFER_SIZE);
+
+		/*!
+		* @brief Destructor of the binaryLogger class
+		*
+		* Destructor of the binaryLogger class. Writes all logged records then stops the background thread.
+		* No thread must log records anymore.
+		* Virtual function.
+		*
+		*/
+		virtual ~binaryLogger();
+
+		/*!
+		* @brief Log a record
+		* @tparam Args : types of the arguments. Each type must have a binaryArg specialization.
+		* @param formatId : id of the format returned by registerFormat
+		* @param args : arguments of the record
+		* @return TRUE if the record was logged and FALSE if it does not fit in half of the buffer
+		*
+		* Copy the record in the buffer of the calling thread. May be called from any thread.
+		*
+		*/
+		template <class... Args>
+		bool log(unsigned int formatId, Args const&... args)
+		{
+			size_t size = (2 * sizeof(uint32_t) + argsSize(args...) + 7) & ~static_cast<size_t>(7); // Records are aligned so that wrap markers always fit
+			threadBuffer* buffer = localBuffer();
+			char* record = buffer->reserve(size);
+			if(record == NULL)
+			{
+				m_dropped.fetch_add(1, std::memory_order_relaxed);
+				return false;
+			}
+			uint32_t header[2] = {static_cast<uint32_t>(size), formatId};
+			memcpy(record, header, sizeof(header));
+			char* end = encodeArgs(record + sizeof(header), args...);
+			memset(end, BINARG_END, record + size - end);
+			buffer->commit(size);
+			return true;
+		}
+
+		/*!
+		* @brief Wait for logged records
+		*
+		* Wait until all records logged before this call are written and flushed to the file.
+		*
+		*/
+		void flush();
+
+		/*!
+		* @brief Know if file is available for writing
+		* @return TRUE if the underlying fileSplitter can be used for writing and FALSE otherwise
+		*
+		* Constant function.
+		*
+		*/
+		bool getStatus() const;
+
+		/*!
+		* @brief Get number of records too large to be logged
+		* @return Number of log calls that returned FALSE
+		*
+		* Constant function.
+		*
+		*/
+		unsigned long long getDropped() const;
+
+		/*!
+		* @brief Get number of waits of logging threads
+		* @return Number of times a logging thread found its buffer full
+		*
+		* Constant function.
+		*
+		*/
+		unsigned long long getWaits() const;
+
+	protected:
+		/*! \struct threadBuffer
+		* \brief Ring buffer of a logging thread
+		*
+		* Single producer single consumer ring. Positions are byte counts since creation. A record never wraps, a null size marks the end of the data before the wrap.
+		*
+		*/
+		struct threadBuffer
+		{
+			explicit threadBuffer(size_t size) : m_data(size), m_mask(size - 1), m_head(0), m_cachedTail(0), m_skip(0), m_waits(0), m_tail(0)
+			{
+			}
+
+			/*!
+			* @brief Get room for a record
+			* @param size : size of the record, multiple of 8
+			* @return Pointer to the room or NULL if the record is larger than half of the buffer
+			*
+			* Waits for the consumer if the buffer is full.
+			*
+			*/
+			char* reserve(size_t size)
+			{
+				if(size > m_data.size() / 2)
+				{
+					return NULL;
+				}
+				unsigned long long head = m_head.load(std::memory_order_relaxed);
+				size_t offset = head & m_mask;
+				m_skip = offset + size > m_data.size() ? m_data.size() - offset : 0;
+				while(head + m_skip + size - m_cachedTail > m_data.size())
+				{
+					m_cachedTail = m_tail.load(std::memory_order_acquire); // Only read when the cached value is not enough
+					if(head + m_skip + size - m_cachedTail > m_data.size())
+					{
+						m_waits.fetch_add(1, std::memory_order_relaxed);
+						std::this_thread::yield();
+					}
+				}
+				if(m_skip > 0)
+				{
+					uint32_t wrap = 0;
+					memcpy(&m_data[offset], &wrap, sizeof(wrap));
+					offset = 0;
+				}
+				return &m_data[offset];
+			}
+
+			/*!
+			* @brief Publish the reserved record
+			* @param size : size of the record
+			*
+			*/
+			void commit(size_t size)
+			{
+				m_head.store(m_head.load(std::memory_order_relaxed) + m_skip + size, std::memory_order_release);
+			}
+
+			std::vector<char> m_data; /*!< Ring memory */
+			size_t m_mask; /*!< Size of the ring minus one */
+			std::atomic<unsigned long long> m_head; /*!< Position after the last published record, written by producer */
+			unsigned long long m_cachedTail; /*!< Copy of m_tail owned by producer */
+			size_t m_skip; /*!< Bytes skipped before the reserved record */
+			std::atomic<unsigned long long> m_waits; /*!< Number of times the ring was full */
+			char m_pad[64]; /*!< Keeps producer and consumer data on different cache lines */
+			std::atomic<unsigned long long> m_tail; /*!< Position of the first record not consumed, written by consumer */
+		};
+
+		/*!
+		* @brief Get the buffer of the calling thread
+		* @return Buffer of the calling thread, created at its first call
+		*
+		* Only a thread local comparison is done once the buffer is known.
+		*
+		*/
+		threadBuffer* localBuffer()
+		{
+			static thread_local unsigned long long instance = 0;
+			static thread_local threadBuffer* buffer = NULL;
+			if(instance != m_instance) // First call of this thread or call on another logger
+			{
+				buffer = attachThread();
+				instance = m_instance;
+			}
+			return buffer;
+		}
+
+		/*!
+		* @brief Find or create the buffer of the calling thread
+		* @return Buffer of the calling thread
+		*
+		*/
+		threadBuffer* attachThread();
+
+		/*!
+		* @brief Background thread loop
+		*
+		* Takes records and writes them in the fileSplitter until the class is destroyed.
+		*
+		*/
+		void writerLoop();
+
+		/*!
+		* @brief Write all available records
+		* @return TRUE if at least one record was written and FALSE otherwise
+		*
+		*/
+		bool drain();
+
+		/*!
+		* @brief Write a record in the fileSplitter
+		* @param record : record with its header
+		* @param size : size of the record
+		*
+		*/
+		void writeRecord(const char* record, size_t size);
+
+		/*!
+		* @brief Get size of encoded arguments
+		* @return 0
+		*
+		*/
+		static size_t argsSize()
+		{
+			return 0;
+		}
+
+		/*!
+		* @brief Get size of encoded arguments
+		* @param first : first argument
+		* @param rest : other arguments
+		* @return Number of bytes of the encoded arguments
+		*
+		*/
+		template <class T, class... Args>
+		static size_t argsSize(T const& first, Args const&... rest)
+		{
+			return binaryArg<typename std::decay<T const>::type>::size(first) + argsSize(rest...);
+		}
+
+		/*!
+		* @brief Encode arguments
+		* @param out : position of the first argument
+		* @return out
+		*
+		*/
+		static char* encodeArgs(char* out)
+		{
+			return out;
+		}
+
+		/*!
+		* @brief Encode arguments
+		* @param out : position of the first argument
+		* @param first : first argument
+		* @param rest : other arguments
+		* @return Position after the last argument
+		*
+		*/
+		template <class T, class... Args>
+		static char* encodeArgs(char* out, T const& first, Args const&... rest)
+		{
+			return encodeArgs(binaryArg<typename std::decay<T const>::type>::encode(out, first), rest...);
+		}
+
+		unsigned long long m_instance; /*!< Unique id of the logger, used to find thread buffers */
+		binaryLogMode m_mode; /*!< Output of the logger */
+		size_t m_bufferSize; /*!< Size of thread buffers */
+		fileSplitter m_splitter; /*!< Splitter owned by background thread */
+		int m_formatsFd; /*!< Descriptor of the formats file with BINLOG_RAW, -1 otherwise */
+		std::vector<std::string> m_formats; /*!< Formats known by background thread, indexed by id */
+		std::vector<bool> m_formatWritten; /*!< Formats already written in the formats file, indexed by id */
+		std::string m_text; /*!< Formatted record */
+		std::vector<std::unique_ptr<threadBuffer> > m_buffers; /*!< Buffers of all logging threads */
+		std::map<std::thread::id, threadBuffer*> m_threads; /*!< Buffer of each logging thread */
+		mutable std::mutex m_threadsMutex; /*!< Mutex protecting buffer lists */
+		std::atomic<unsigned long long> m_dropped; /*!< Number of records too large */
+		std::atomic<bool> m_status; /*!< Copy of splitter status readable from any thread */
+		std::atomic<bool> m_stop; /*!< Background thread stop request */
+		std::atomic<unsigned long long> m_flushRequest; /*!< Number of flush requests */
+		unsigned long long m_flushDone; /*!< Number of flush requests done, protected by m_mutex */
+		std::mutex m_mutex; /*!< Mutex protecting background thread sleep and flush waits */
+		std::condition_variable m_wakeUp; /*!< Wakes background thread up */
+		std::condition_variable m_flushed; /*!< Wakes flush waiters up */
+		std::thread m_writer; /*!< Background thread */
+
+	private:
+		binaryLogger(binaryLogger const&); // Not copyable
+		binaryLogger& operator=(binaryLogger const&);
+	};
+}
+
+#endif
+
+//  ______________________________
+// |                              |
+// |    ______________________    |       
+// |   |                      |   |
+// |   |         sign         |   |
+// |   |        coding        |   |
+// |   |        dw@rf         |   |
+// |   |         1.0          |   |
+// |   |______________________|   |
+// |                              |
+// |______________________________|
+//               |  |           
+//               |  |             
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |__|
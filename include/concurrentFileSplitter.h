@@ -0,0 +1,302 @@
+/*!
+ * @file concurrentFileSplitter.h
+ * @brief Class used to share a file splitting between several producer threads
+ * @author Sign Coding Dwarf
+ * @version 1.0
+ * @date 19 October 2026
+ *
+ * Definition of the class allowing several threads to write complete records into the same set of split files.
+ * Each producer builds its record locally and submits it through a lock-free queue. A single writer thread owns the underlying fileSplitter so records never interleave. <br>
+ * To test if it is available with your library version use <br>
+ * \a \#if \a DWFUTILS_VERSION_NUMERIC>=111580308
+ *
+ */
+
+/*
+Copyright 2016 SignCodingDwarf
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+
+#ifndef CONCURRENTFILESPLITTER
+#define CONCURRENTFILESPLITTER
+
+#include <string>
+#include <sstream>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "common_defines.h"
+#include "fileSplitter.h"
+#include "mpscQueue.h"
+
+/*!
+* @namespace dwf_utils
+* @brief A namespace used to regroup all utilitary functions or classes spanning through multiple applications
+*/
+namespace dwf_utils
+{
+	/*! \class concurrentFileSplitter
+	* \brief Class allowing several threads to write records into split files
+	*
+	* Class used to share one fileSplitter between several producer threads. Producers submit complete records which are written in submission order by a dedicated writer thread.
+	* Records of a given producer keep their order. Records of different producers never interleave.
+	*
+	*/
+	class concurrentFileSplitter
+	{
+	public:
+		/*! \class record
+		* \brief Record built by a producer thread
+		*
+		* Local buffer used to build a record with operator<< calls. The record is submitted as a whole when destroyed or when submit is called.
+		*
+		*/
+		class record
+		{
+		public:
+			/*!
+			* @brief Constructor of the record class
+			* @param splitter : concurrentFileSplitter to which the record is submitted
+			*
+			*/
+			explicit record(concurrentFileSplitter& splitter);
+
+			/*!
+			* @brief Destructor of the record class
+			*
+			* Destructor of the record class. Submits the record if it was not already done.
+			*
+			*/
+			~record();
+
+			/*!
+			* @brief Submit record
+			*
+			* Submit record content to the splitter. Further insertions start a new record.
+			*
+			*/
+			void submit();
+
+			/*!
+			* @brief Declaration of operator<<
+			* @tparam T : type of the data to write
+			* @param data : data to add to the record
+			* @return A reference to the modified record allowing to channel multiple insertion in flux
+			*
+			* operator<< allowing to add data to the record. T must contain operator<<.
+			*
+			*/
+			template <class T>
+			record& operator<<(T const& data)
+			{
+				m_buffer << data;
+				return *this;
+			}
+
+			/*!
+			* @brief Overload of operator<<
+			* @param pf : functor on a manipulator of ostream fluxes.
+			* @return A reference to the modified record allowing to channel multiple insertion in flux
+			*
+			* Overload of operator<< allowing to use manipulators such as endl.
+			*
+			*/
+			record& operator<<(std::ostream& (*pf)(std::ostream&))
+			{
+				pf(m_buffer);
+				return *this;
+			}
+
+		protected:
+			concurrentFileSplitter& m_splitter; /*!< Splitter to which the record is submitted */
+			std::ostringstream m_buffer; /*!< Record content */
+		};
+
+		/*!
+		* @brief Constructor of the concurrentFileSplitter class
+		* @param baseName : base name of the files. All files wil be named baseName_<Id>.extension
+		* @param extension : extension of the files. All files wil be named baseName_<Id>.extension. Dot is automatically added befor extension if not present.
+		* @param fileSize : Maximum number of records (or of bytes with SPLIT_BYTES criterion) written before triggering writing to a new file
+		* @param options : optional behaviours of the underlying fileSplitter
+		*
+		* Constructor of the concurrentFileSplitter class. Opens the baseName_0.extension file and starts the writer thread.
+		*
+		*/
+		concurrentFileSplitter(std::string baseName, std::string extension, unsigned long fileSize, splitterOptions const& options = splitterOptions());
+
+		/*!
+		* @brief Destructor of the concurrentFileSplitter class
+		*
+		* Destructor of the concurrentFileSplitter class. Writes all submitted records then stops the writer thread.
+		* No producer must submit records anymore.
+		* Virtual function.
+		*
+		*/
+		virtual ~concurrentFileSplitter();
+
+		/*!
+		* @brief Submit a complete record
+		* @param data : record content. It is written without any modification.
+		*
+		* Submit a record to be written. May be called from any thread. Never waits for the file writing.
+		*
+		*/
+		void submit(std::string data);
+
+		/*!
+		* @brief Wait for submitted records
+		*
+		* Wait until all records submitted by the calling thread before this call are written and flushed to the file.
+		*
+		*/
+		void flush();
+
+		/*!
+		* @brief Wait until submitted records are on disk
+		* @return EXEC_SUCCESS if records are on disk and EXEC_FAILURE otherwise or with the DURABLE_NONE policy
+		*
+		* Wait until all records submitted by the calling thread before this call are flushed to disk, according to the durability policy of the options.
+		* With the DURABLE_GROUP policy, threads waiting at the same time share a single flush.
+		*
+		*/
+		int waitDurable();
+
+		/*!
+		* @brief Get statistics of the flushes to disk
+		* @return Flush statistics, empty with the DURABLE_NONE policy
+		*
+		* Constant function.
+		*
+		*/
+		durabilityStats getDurabilityStats() const;
+
+		/*!
+		* @brief Know if file is available for writing
+		* @return TRUE if file can be used for writing and FALSE otherwise
+		*
+		* Know if the underlying fileSplitter is available for writing.
+		* Constant function.
+		*
+		*/
+		bool getStatus() const;
+
+		/*!
+		* @brief Get number of records waiting for writing
+		* @return Approximate number of records in queue
+		*
+		* Constant function.
+		*
+		*/
+		size_t getQueueDepth() const;
+
+		/*!
+		* @brief Get statistics of the splitter
+		* @return Snapshot of the statistics of the underlying fileSplitter, with queue depth and dropped records
+		*
+		* Constant function.
+		*
+		*/
+		splitterStats getStats() const;
+
+	protected:
+		/*!
+		* @brief Writer thread loop
+		*
+		* Pops records and writes them in the fileSplitter until the class is destroyed.
+		*
+		*/
+		void writerLoop();
+
+		/*!
+		* @brief Write all available records
+		* @return TRUE if at least one record was written and FALSE otherwise
+		*
+		*/
+		bool drain();
+
+		/*!
+		* @brief Wait for the writer thread to reach the current point of the queue
+		* @param ticket : receives a durability ticket of the written records if not NULL
+		*
+		* Records submitted by the calling thread before this call are written and flushed to the file.
+		*
+		*/
+		void waitWriter(unsigned long long* ticket);
+
+		/*! \struct pendingRecord
+		* \brief Element of the record queue
+		*/
+		struct pendingRecord
+		{
+			pendingRecord() : m_data(), m_flushed(NULL), m_ticket(NULL)
+			{
+			}
+
+			std::string m_data; /*!< Record content */
+			bool* m_flushed; /*!< Flag set once written when the element is a flush request, NULL otherwise */
+			unsigned long long* m_ticket; /*!< Receives a durability ticket when the flush request needs one, NULL otherwise */
+		};
+
+		/*!
+		* @brief Wake writer thread up if it is sleeping
+		*
+		*/
+		void wakeWriter();
+
+		fileSplitter m_splitter; /*!< Splitter owned by writer thread */
+		mpscQueue<pendingRecord> m_queue; /*!< Records waiting for writing */
+		std::atomic<bool> m_status; /*!< Copy of splitter status readable from any thread */
+		std::atomic<bool> m_stop; /*!< Writer thread stop request */
+		std::atomic<bool> m_sleeping; /*!< Indicates writer thread waits for records */
+		std::atomic<unsigned long long> m_maxDepth; /*!< Largest queue depth found by writer thread */
+		std::atomic<unsigned long long> m_dropped; /*!< Number of records popped while files could not be written */
+		std::mutex m_mutex; /*!< Mutex protecting writer sleep and flush waits */
+		std::condition_variable m_wakeUp; /*!< Wakes writer thread up */
+		std::condition_variable m_flushDone; /*!< Wakes flush waiters up */
+		std::thread m_writer; /*!< Writer thread */
+
+	private:
+		concurrentFileSplitter(concurrentFileSplitter const&); // Not copyable
+		concurrentFileSplitter& operator=(concurrentFileSplitter const&);
+	};
+}
+
+#endif
+
+//  ______________________________
+// |                              |
+// |    ______________________    |       
+// |   |                      |   |
+// |   |         sign         |   |
+// |   |        coding        |   |
+// |   |        dw@rf         |   |
+// |   |         1.0          |   |
+// |   |______________________|   |
+// |                              |
+// |______________________________|
+//               |  |           
+//               |  |             
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |__|
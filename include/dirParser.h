@@ -8,6 +8,10 @@
  * Definition of the class used to parse working directory and programm location. Adapted to work both on Windows and Linux.
  * Can be inherited according to application needs to add other directories.
  * Based on http://stackoverflow.com/questions/143174/how-do-i-get-the-directory-that-a-program-is-running-from
+ * On Linux, directories are also kept open so that files can be opened relative to them with openat, without resolving their path again.
+ * They are watched with inotify so that update only reads paths again after a change. <br>
+ * Descriptors are available with your library version if <br>
+ * \a \#if \a DWFUTILS_VERSION_NUMERIC>=111580308
  *
  */
 
@@ -40,6 +44,9 @@ limitations under the License.
 #elif __linux__
 	#include <unistd.h>
 	#include <limits.h>
+	#include <vector>
+	#include <fcntl.h>
+	#include <sys/stat.h>
  #endif
 
 /*! 
@@ -52,11 +59,24 @@ namespace dwf_utils
 	* \brief Class for working directory and program location parsing
 	*
 	* Class used to parse working directory and program location. Can be inherited according to application needs to define applicative folders.
+	* On Linux, program location, working directory and registered folders are kept open. Files can then be opened or checked relative to them with openAt and statAt.
 	* 
 	*/
 	class dirParser
 	{
 	public:
+#ifdef __linux__
+		/*!
+		* @enum baseDir
+		* @brief Identifiers of the directories always opened
+		*/
+		enum baseDir
+		{
+			EXE_DIR = 0, /*!< Program location */
+			WORKING_DIR = 1 /*!< Working directory */
+		};
+#endif
+
 		/*!
 		* @brief Constructor of the dirParser class
 		* @param maxPathLength : maximal size of the paths. Default is system maximal size PATH_MAX. 
@@ -69,12 +89,33 @@ namespace dwf_utils
 		/*!
 		* @brief Destructor of the dirParser class
 		*
-		* Destructor of the dirParser class. Currently does nothing.
+		* Destructor of the dirParser class. Closes the directories kept open.
 		* Virtual function.
 		*
 		*/
 		virtual ~dirParser(void);
 
+#ifdef __linux__
+		/*!
+		* @brief Copy constructor of the dirParser class
+		* @param other : dirParser to copy
+		*
+		* Directories kept open by other are duplicated.
+		*
+		*/
+		dirParser(dirParser const& other);
+
+		/*!
+		* @brief Assignment operator of the dirParser class
+		* @param other : dirParser to copy
+		* @return Reference to this dirParser
+		*
+		* Directories kept open are closed and the ones of other are duplicated.
+		*
+		*/
+		dirParser& operator=(dirParser const& other);
+#endif
+
 		/*!
 		* @brief Know if directories could be loaded
 		* @return TRUE if directories could be loaded and FALSE otherwise
@@ -90,20 +131,20 @@ namespace dwf_utils
 		* @return Program location as a string terminated by the / or \\ character or an empty string if could not be loaded.
 		*
 		* Get program locationr (i.e. directory in which the executable is located).
-		* Constant function.
+		* Reference is valid until next update. Constant function.
 		*
 		*/
-		std::string getExeLoc() const;
+		std::string const& getExeLoc() const;
 
 		/*!
 		* @brief Get working directory
 		* @return Working directory as a string terminated by the / or \\ character or an empty string if could not be loaded.
 		*
 		* Get working directory (i.e. directory from which the executable is run).
-		* Constant function.
+		* Reference is valid until next update. Constant function.
 		*
 		*/
-		std::string getWDir() const;
+		std::string const& getWDir() const;
 
 		/*!
 		* @brief Get maximal length of path names
@@ -129,12 +170,108 @@ namespace dwf_utils
 		* @return TRUE if values could be updated, false otherwise
 		*
 		* Function allowing to update the working directory and program location during execution.
+		* Values are only read again if hasChanged, so that update may be called often.
 		* Its output can also be obtained through a getDirLoaded call.
 		* Virtual function.
 		*
 		*/
 		virtual bool update();
 
+		/*!
+		* @brief Know if directories may have changed since they were loaded
+		* @return TRUE if directories must be loaded again and FALSE otherwise
+		*
+		* Directories change when they could not be loaded, when the working directory is changed with changeDir, when invalidate is called or, on Linux, when a directory kept open is itself moved or deleted.
+		* Always TRUE on Windows. Result stays TRUE until directories are loaded again.
+		*
+		*/
+		bool hasChanged();
+
+		/*!
+		* @brief Force next update to load directories again
+		*
+		* Needed after a working directory change not made with changeDir.
+		*
+		*/
+		void invalidate();
+
+		/*!
+		* @brief Change the working directory
+		* @param path : path of the new working directory
+		* @return TRUE if working directory was changed and FALSE otherwise
+		*
+		* Replaces chdir so that every dirParser knows it must update its working directory.
+		*
+		*/
+		static bool changeDir(std::string const& path);
+
+#ifdef __linux__
+		/*!
+		* @brief Register a folder kept open
+		* @param parent : identifier of the directory holding the folder (EXE_DIR, WORKING_DIR or a registered folder)
+		* @param subPath : path of the folder relative to parent, for example "images/"
+		* @param create : create the folder if it does not exist, its parent having to exist
+		* @return Identifier of the folder or -1 if it could not be opened
+		*
+		* Registering an already registered folder returns its identifier, so that it can be done again in an inherited update function.
+		* Registered folders are opened again by update.
+		*
+		*/
+		int registerDir(int parent, std::string const& subPath, bool create = false);
+
+		/*!
+		* @brief Get descriptor of a directory
+		* @param dir : identifier of the directory
+		* @return Descriptor of the directory, usable with the *at functions, or -1 if it is not open
+		*
+		* Constant function.
+		*
+		*/
+		int getDirFd(int dir) const;
+
+		/*!
+		* @brief Get path of a directory
+		* @param dir : identifier of the directory
+		* @return Path of the directory terminated by the / character or an empty string if it is unknown
+		*
+		* Reference is valid until next update or registerDir call. Constant function.
+		*
+		*/
+		std::string const& getDirPath(int dir) const;
+
+		/*!
+		* @brief Open a file relative to a directory
+		* @param dir : identifier of the directory
+		* @param name : name of the file relative to the directory
+		* @param flags : flags of open, O_CLOEXEC being always added
+		* @param mode : permissions of a created file
+		* @return Descriptor of the file or -1 on failure, errno being set
+		*
+		* Constant function.
+		*
+		*/
+		int openAt(int dir, const char* name, int flags, mode_t mode = 0644) const
+		{
+			return openat(getDirFd(dir), name, flags | O_CLOEXEC, mode);
+		}
+
+		/*!
+		* @brief Get status of a file relative to a directory
+		* @param dir : identifier of the directory
+		* @param name : name of the file relative to the directory
+		* @param status : receives the status of the file
+		* @param followLink : give the status of the target of a symbolic link rather than of the link
+		* @return TRUE if status could be read and FALSE otherwise
+		*
+		* Constant function.
+		*
+		*/
+		bool statAt(int dir, const char* name, struct stat& status, bool followLink = true) const
+		{
+			return fstatat(getDirFd(dir), name, &status, followLink ? 0 : AT_SYMLINK_NOFOLLOW) == 0;
+		}
+#endif
+
 	protected:
 		/*!
 		* @brief Function used to set the working directory and program location.
@@ -146,10 +283,48 @@ namespace dwf_utils
 		*/
 		void setDir();
 
+#ifdef __linux__
+		/*! \struct cachedDir
+		* \brief Directory kept open
+		*/
+		struct cachedDir
+		{
+			int m_fd; /*!< Descriptor of the directory, -1 if it could not be opened */
+			int m_parent; /*!< Identifier of the parent directory, -1 for base directories */
+			std::string m_subPath; /*!< Path relative to the parent directory */
+			std::string m_path; /*!< Full path terminated by the / character */
+			bool m_create; /*!< Create the directory if it does not exist */
+			int m_watch; /*!< Identifier of the inotify watch of the directory, -1 if it is not watched */
+			unsigned long m_changes; /*!< Number of changes of the watched directory when it was opened */
+		};
+
+		/*!
+		* @brief Open a directory kept open
+		* @param dir : directory to open, previous descriptor being closed
+		* @return TRUE if directory could be opened and FALSE otherwise
+		*
+		* The directory is watched by the inotify watcher shared by all dirParser.
+		*
+		*/
+		bool openDir(cachedDir& dir);
+
+		/*!
+		* @brief Close all directories kept open
+		*
+		*/
+		void closeDirs();
+#endif
+
 		std::string m_exeLoc; /*!< Program Location folder as a string */
 		std::string m_WDir; /*!< Working Directory as a string */
 		bool m_dirLoaded; /*!< Were directories loaded ? */
 		unsigned int m_maxPathLength; /*!< Max size of path names */
+		bool m_changed; /*!< Must directories be loaded again ? */
+		unsigned long m_cwdGeneration; /*!< Number of changeDir calls when working directory was loaded */
+#ifdef __linux__
+		std::vector<cachedDir> m_dirs; /*!< Directories kept open, indexed by identifier */
+		unsigned long m_lostEvents; /*!< Number of inotify queue overflows when directories were opened */
+#endif
 	};
 }
 
@@ -0,0 +1,247 @@
+/*!
+ * @file dirWalker.h
+ * @brief Class used to walk through a directory tree with several threads
+ * @author Sign Coding Dwarf
+ * @version 1.0
+ * @date 19 October 2026
+ *
+ * Definition of the class walking recursively through a directory tree. Directories are read with getdents64 and opened with openat from the descriptor of their parent, so that paths are never resolved again.
+ * Subdirectories are spread over a pool of threads stealing work from each other and every entry is given to a callback. <br>
+ * To test if it is available with your library version use <br>
+ * \a \#if \a DWFUTILS_VERSION_NUMERIC>=111580308
+ *
+ */
+
+/*
+Copyright 2016 SignCodingDwarf
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+
+#ifndef DIRWALKER
+#define DIRWALKER
+
+#include <string>
+#include <functional>
+#include <sys/stat.h>
+
+#include "common_defines.h"
+
+/*!
+* @def WALKER_BUFFER_SIZE
+* @brief Size of the buffer of each thread receiving directory entries from getdents64
+*/
+#ifndef WALKER_BUFFER_SIZE
+#define WALKER_BUFFER_SIZE (1 << 15)
+#endif
+
+/*!
+* @namespace dwf_utils
+* @brief A namespace used to regroup all utilitary functions or classes spanning through multiple applications
+*/
+namespace dwf_utils
+{
+	/*!
+	* @enum entryType
+	* @brief Type of a directory entry
+	*/
+	enum entryType
+	{
+		ENTRY_UNKNOWN, /*!< Type could not be found */
+		ENTRY_FILE, /*!< Regular file */
+		ENTRY_DIRECTORY, /*!< Directory */
+		ENTRY_LINK, /*!< Symbolic link */
+		ENTRY_OTHER /*!< Fifo, socket or device */
+	};
+
+	/*! \struct walkerOptions
+	* \brief Optional behaviours of a dirWalker
+	*/
+	struct walkerOptions
+	{
+		/*!
+		* @brief Constructor of the walkerOptions structure
+		*
+		* Set default behaviours : one thread per core, no stat, symbolic links not followed and no depth limit.
+		*
+		*/
+		walkerOptions() : m_threadNb(0), m_stat(false), m_followLinks(false), m_maxDepth(0)
+		{
+		}
+
+		unsigned int m_threadNb; /*!< Number of threads walking the tree, calling thread included. 0 for one per core */
+		bool m_stat; /*!< Get the status of each entry with fstatat. Otherwise only the type given by getdents64 is known */
+		bool m_followLinks; /*!< Walk through symbolic links to directories. Each directory is then walked only once */
+		unsigned int m_maxDepth; /*!< Depth of the deepest entries given, entries of the root having depth 1. 0 for no limit */
+	};
+
+	/*! \struct dirEntry
+	* \brief Entry of a directory given to the callback of a dirWalker
+	*
+	* Members are only valid during the callback.
+	*
+	*/
+	struct dirEntry
+	{
+		/*!
+		* @brief Constructor of the dirEntry structure
+		* @param dir : path of the directory holding the entry
+		* @param name : name of the entry
+		* @param dirFd : descriptor of the directory holding the entry
+		* @param type : type of the entry
+		* @param depth : depth of the entry
+		* @param status : status of the entry or NULL
+		*
+		*/
+		dirEntry(std::string const& dir, const char* name, int dirFd, entryType type, unsigned int depth, const struct stat* status) : m_dir(dir), m_name(name), m_dirFd(dirFd), m_type(type), m_depth(depth), m_stat(status)
+		{
+		}
+
+		/*!
+		* @brief Get path of the entry
+		* @return Path of the directory followed by the name
+		*
+		* Constant function.
+		*
+		*/
+		std::string path() const
+		{
+			return m_dir + m_name;
+		}
+
+		std::string const& m_dir; /*!< Path of the directory holding the entry, ending with '/' */
+		const char* m_name; /*!< Name of the entry */
+		int m_dirFd; /*!< Descriptor of the directory holding the entry, usable with openat or fstatat */
+		entryType m_type; /*!< Type of the entry, the one of the link itself for symbolic links */
+		unsigned int m_depth; /*!< Depth of the entry, 1 for the entries of the root */
+		const struct stat* m_stat; /*!< Status of the entry if walkerOptions::m_stat is set and fstatat succeeded, NULL otherwise */
+	};
+
+	/*!
+	* @brief Callback receiving the entries
+	*
+	* Called from any thread of the walker, possibly at the same time. Returning FALSE for a directory skips its content.
+	*
+	*/
+	typedef std::function<bool(dirEntry const&)> walkCallback;
+
+	/*! \class dirWalker
+	* \brief Class walking a directory tree with several threads
+	*
+	* Each thread reads whole directories with getdents64 and keeps the subdirectories it finds in its own queue, taking the last one first so that it goes deep and keeps few directories open.
+	* A thread having nothing left takes the oldest directory of the queue of another thread, which is usually the largest remaining subtree.
+	* A subdirectory is opened with openat from the descriptor of its parent, which stays open as long as some of its subdirectories wait in queues.
+	*
+	*/
+	class dirWalker
+	{
+	public:
+		/*!
+		* @brief Constructor of the dirWalker class
+		* @param options : optional behaviours of the walker
+		*
+		*/
+		dirWalker(walkerOptions const& options = walkerOptions());
+
+		/*!
+		* @brief Destructor of the dirWalker class
+		*
+		* Destructor of the dirWalker class. Currently does nothing.
+		* Virtual function.
+		*
+		*/
+		virtual ~dirWalker();
+
+		/*!
+		* @brief Walk a directory tree
+		* @param root : path of the directory to walk, which is not given to the callback itself
+		* @param callback : function receiving each entry
+		* @return EXEC_SUCCESS if every directory could be read and EXEC_FAILURE otherwise
+		*
+		* Returns once the whole tree was walked. Directories which cannot be opened or read are counted as errors and skipped.
+		* Must not be called by several threads at the same time on the same object.
+		*
+		*/
+		int walk(std::string const& root, walkCallback const& callback);
+
+		/*!
+		* @brief Get number of entries given by the last walk
+		* @return Number of entries given to the callback
+		*
+		* Constant function.
+		*
+		*/
+		unsigned long long getEntryNb() const;
+
+		/*!
+		* @brief Get number of directories read by the last walk
+		* @return Number of directories read, root included
+		*
+		* Constant function.
+		*
+		*/
+		unsigned long long getDirectoryNb() const;
+
+		/*!
+		* @brief Get number of errors of the last walk
+		* @return Number of directories which could not be opened or read
+		*
+		* Constant function.
+		*
+		*/
+		unsigned long long getErrorNb() const;
+
+		/*!
+		* @brief Get number of directories stolen during the last walk
+		* @return Number of directories taken from the queue of another thread
+		*
+		* Constant function.
+		*
+		*/
+		unsigned long long getStolenNb() const;
+
+	protected:
+		walkerOptions m_options; /*!< Optional behaviours */
+		unsigned long long m_entryNb; /*!< Number of entries given by the last walk */
+		unsigned long long m_directoryNb; /*!< Number of directories read by the last walk */
+		unsigned long long m_errorNb; /*!< Number of errors of the last walk */
+		unsigned long long m_stolenNb; /*!< Number of directories stolen during the last walk */
+	};
+}
+
+#endif
+
+//  ______________________________
+// |                              |
+// |    ______________________    |       
+// |   |                      |   |
+// |   |         sign         |   |
+// |   |        coding        |   |
+// |   |        dw@rf         |   |
+// |   |         1.0          |   |
+// |   |______________________|   |
+// |                              |
+// |______________________________|
+//               |  |           
+//               |  |             
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |__|
@@ -0,0 +1,253 @@
+/*!
+ * @file dirWatcher.h
+ * @brief Class used to be notified of changes in directories
+ * @author Sign Coding Dwarf
+ * @version 1.0
+ * @date 19 October 2026
+ *
+ * Definition of the class watching directories with inotify. Events can be read when needed or given to a callback by a background thread, so that new files are found without walking directories again. <br>
+ * To test if it is available with your library version use <br>
+ * \a \#if \a DWFUTILS_VERSION_NUMERIC>=111580308
+ *
+ */
+
+/*
+Copyright 2016 SignCodingDwarf
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+
+#ifndef DIRWATCHER
+#define DIRWATCHER
+
+#include <string>
+#include <vector>
+#include <map>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <stdint.h>
+#include <sys/inotify.h>
+
+#include "common_defines.h"
+
+/*!
+* @def WATCH_BUFFER_SIZE
+* @brief Size of the buffer receiving events from inotify
+*/
+#ifndef WATCH_BUFFER_SIZE
+#define WATCH_BUFFER_SIZE (1 << 16)
+#endif
+
+/*!
+* @def WATCH_DEFAULT_MASK
+* @brief Events watched by default : entries created, written, removed or moved and changes of the directory itself
+*/
+#ifndef WATCH_DEFAULT_MASK
+#define WATCH_DEFAULT_MASK (IN_CREATE | IN_CLOSE_WRITE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF)
+#endif
+
+/*!
+* @namespace dwf_utils
+* @brief A namespace used to regroup all utilitary functions or classes spanning through multiple applications
+*/
+namespace dwf_utils
+{
+	/*! \struct watchEvent
+	* \brief Change in a watched directory
+	*/
+	struct watchEvent
+	{
+		/*!
+		* @brief Get path of the entry
+		* @return Path of the watched directory followed by the name of the entry
+		*
+		* Constant function.
+		*
+		*/
+		std::string path() const
+		{
+			return m_dir + m_name;
+		}
+
+		int m_watch; /*!< Identifier of the watch, -1 if events were lost (IN_Q_OVERFLOW) */
+		uint32_t m_mask; /*!< inotify bits of the event, IN_ISDIR being set for directories and IN_IGNORED once the watch is removed */
+		uint32_t m_cookie; /*!< Value shared by the IN_MOVED_FROM and IN_MOVED_TO events of a rename */
+		std::string m_name; /*!< Name of the entry, empty for events on the watched directory itself */
+		std::string m_dir; /*!< Path given when adding the watch, ending with '/' */
+	};
+
+	/*!
+	* @brief Callback receiving the events
+	*
+	* Called from the background thread of the watcher.
+	*
+	*/
+	typedef std::function<void(watchEvent const&)> watchCallback;
+
+	/*! \class dirWatcher
+	* \brief Class watching directories with inotify
+	*
+	* Events of all watches are read from a single inotify descriptor, either with readEvents, from a poll loop using getFd, or by a background thread started with start.
+	* Watches are not recursive : subdirectories must be watched separately.
+	*
+	*/
+	class dirWatcher
+	{
+	public:
+		/*!
+		* @brief Constructor of the dirWatcher class
+		*
+		* Creates the inotify descriptor.
+		*
+		*/
+		dirWatcher();
+
+		/*!
+		* @brief Destructor of the dirWatcher class
+		*
+		* Stops the background thread and removes all watches.
+		* Virtual function.
+		*
+		*/
+		virtual ~dirWatcher();
+
+		/*!
+		* @brief Know if the watcher can be used
+		* @return TRUE if inotify descriptor could be created and FALSE otherwise
+		*
+		* Constant function.
+		*
+		*/
+		bool getStatus() const;
+
+		/*!
+		* @brief Watch a directory
+		* @param path : path of the directory
+		* @param mask : inotify events to watch
+		* @return Identifier of the watch or -1 on failure
+		*
+		* Watching again a directory returns the same identifier and replaces the watched events.
+		*
+		*/
+		int addWatch(std::string const& path, uint32_t mask = WATCH_DEFAULT_MASK);
+
+		/*!
+		* @brief Watch an open directory
+		* @param dirFd : descriptor of the directory
+		* @param path : path reported in the events of the watch
+		* @param mask : inotify events to watch
+		* @return Identifier of the watch or -1 on failure
+		*
+		* The directory is found from its descriptor, so it is watched even if it was moved since it was opened.
+		*
+		*/
+		int addWatch(int dirFd, std::string const& path, uint32_t mask = WATCH_DEFAULT_MASK);
+
+		/*!
+		* @brief Stop watching a directory
+		* @param watch : identifier of the watch
+		* @return EXEC_SUCCESS if watch was removed and EXEC_FAILURE otherwise
+		*
+		* A last IN_IGNORED event is reported for the watch.
+		*
+		*/
+		int removeWatch(int watch);
+
+		/*!
+		* @brief Get inotify descriptor
+		* @return Descriptor becoming readable when events are available, for use in a poll loop
+		*
+		* Constant function.
+		*
+		*/
+		int getFd() const;
+
+		/*!
+		* @brief Read events
+		* @param events : vector to which events are appended
+		* @param timeout : maximal time to wait for a first event in milliseconds, 0 to return immediately and -1 to wait without limit
+		* @return EXEC_SUCCESS if events could be read, even if there was none, and EXEC_FAILURE otherwise
+		*
+		* Must not be called while the background thread runs.
+		*
+		*/
+		int readEvents(std::vector<watchEvent>& events, int timeout = 0);
+
+		/*!
+		* @brief Start giving events to a callback
+		* @param callback : function receiving each event
+		* @return EXEC_SUCCESS if background thread was started and EXEC_FAILURE otherwise
+		*
+		*/
+		int start(watchCallback const& callback);
+
+		/*!
+		* @brief Stop the background thread
+		*
+		* Events already read are given to the callback before returning.
+		*
+		*/
+		void stop();
+
+	protected:
+		/*!
+		* @brief Add a watch
+		* @param target : path given to inotify
+		* @param path : path reported in the events of the watch
+		* @param mask : inotify events to watch
+		* @return Identifier of the watch or -1 on failure
+		*
+		*/
+		int watchTarget(const char* target, std::string const& path, uint32_t mask);
+
+		int m_fd; /*!< inotify descriptor */
+		int m_wake[2]; /*!< Pipe waking up the background thread when it must stop */
+		std::vector<char> m_buffer; /*!< Buffer receiving the events */
+		std::map<int, std::string> m_watches; /*!< Path of each watch, protected by m_mutex */
+		mutable std::mutex m_mutex; /*!< Mutex protecting m_watches */
+		watchCallback m_callback; /*!< Function receiving the events of the background thread */
+		std::thread m_thread; /*!< Background thread */
+
+	private:
+		dirWatcher(dirWatcher const&); // Not copyable
+		dirWatcher& operator=(dirWatcher const&);
+	};
+}
+
+#endif
+
+//  ______________________________
+// |                              |
+// |    ______________________    |       
+// |   |                      |   |
+// |   |         sign         |   |
+// |   |        coding        |   |
+// |   |        dw@rf         |   |
+// |   |         1.0          |   |
+// |   |______________________|   |
+// |                              |
+// |______________________________|
+//               |  |           
+//               |  |             
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |__|
@@ -0,0 +1,194 @@
+/*!
+ * @file directEngine.h
+ * @brief Class used to write split files without going through the page cache
+ * @author Sign Coding Dwarf
+ * @version 1.0
+ * @date 19 October 2026
+ *
+ * Definition of the write engine opening files with O_DIRECT and writing aligned blocks from aligned buffers.
+ * Written data does not stay in the page cache and thus does not evict the data of other processes. <br>
+ * To test if it is available with your library version use <br>
+ * \a \#if \a DWFUTILS_VERSION_NUMERIC>=111580308
+ *
+ */
+
+/*
+Copyright 2016 SignCodingDwarf
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+
+#ifndef DIRECTENGINE
+#define DIRECTENGINE
+
+#include "common_defines.h"
+#include "writeEngine.h"
+
+/*!
+* @def DIRECT_ALIGNMENT
+* @brief Alignment of buffers, offsets and sizes of direct writes in bytes
+*/
+#ifndef DIRECT_ALIGNMENT
+#define DIRECT_ALIGNMENT 4096
+#endif
+
+/*!
+* @def DIRECT_BUFFER_SIZE
+* @brief Default size of the directEngine buffer in bytes
+*/
+#ifndef DIRECT_BUFFER_SIZE
+#define DIRECT_BUFFER_SIZE (1 << 20)
+#endif
+
+/*!
+* @namespace dwf_utils
+* @brief A namespace used to regroup all utilitary functions or classes spanning through multiple applications
+*/
+namespace dwf_utils
+{
+	/*! \class directEngine
+	* \brief Engine writing aligned blocks to files opened with O_DIRECT
+	*
+	* Committed data is written by whole blocks of DIRECT_ALIGNMENT bytes. The incomplete last block is kept at the beginning of the buffer and completed by the next commits, so that flushing only writes complete blocks.
+	* On detach the last block is written padded with null bytes and the file is truncated to the number of bytes given to the engine. <br>
+	* If the file system does not support O_DIRECT, segmentBuf opens files without it and the engine behaves like a pwriteEngine with aligned writes.
+	*
+	*/
+	class directEngine : public writeEngine
+	{
+	public:
+		/*!
+		* @brief Create a directEngine
+		* @param bufferSize : size of the buffer in bytes, rounded up to a multiple of DIRECT_ALIGNMENT. Default is DIRECT_BUFFER_SIZE.
+		* @return The created engine or NULL if the aligned buffer could not be allocated
+		*
+		*/
+		static directEngine* create(size_t bufferSize = DIRECT_BUFFER_SIZE);
+
+		/*!
+		* @brief Constructor of the directEngine class
+		* @param bufferSize : size of the buffer in bytes, rounded up to a multiple of DIRECT_ALIGNMENT. Default is DIRECT_BUFFER_SIZE.
+		*
+		* If the buffer cannot be allocated, getStatus returns FALSE and every write fails.
+		*
+		*/
+		explicit directEngine(size_t bufferSize = DIRECT_BUFFER_SIZE);
+
+		/*!
+		* @brief Destructor of the directEngine class
+		*
+		* Virtual function.
+		*
+		*/
+		virtual ~directEngine();
+
+		/*!
+		* @brief Get access mode and flags required to open files
+		* @return O_WRONLY | O_DIRECT
+		*
+		* Constant and virtual function.
+		*
+		*/
+		virtual int openFlags() const;
+
+		/*!
+		* @brief Stop writing in the current file
+		* @return EXEC_SUCCESS if last block could be written and file truncated and EXEC_FAILURE otherwise
+		*
+		* Virtual function.
+		*
+		*/
+		virtual int detach();
+
+		/*!
+		* @brief Get the buffer to fill
+		* @param size : receives the capacity of the buffer in bytes
+		* @return Pointer following the incomplete block kept in buffer
+		*
+		* Virtual function.
+		*
+		*/
+		virtual char* getBuffer(size_t& size);
+
+		/*!
+		* @brief Write the complete blocks of the buffer
+		* @param size : number of bytes filled from the pointer returned by getBuffer
+		* @return EXEC_SUCCESS if writing could be done and EXEC_FAILURE otherwise
+		*
+		* Virtual function.
+		*
+		*/
+		virtual int commit(size_t size);
+
+		/*!
+		* @brief Write the incomplete block
+		* @return EXEC_SUCCESS if block could be written and file truncated and EXEC_FAILURE otherwise
+		*
+		* The incomplete block is written padded with null bytes and the file truncated to the number of bytes given to the engine. The block stays in buffer and is written again once complete.
+		* Virtual function.
+		*
+		*/
+		virtual int drain();
+
+		/*!
+		* @brief Get number of bytes already in the file
+		* @return Number of bytes written by complete blocks or by the last drain
+		*
+		* Constant and virtual function.
+		*
+		*/
+		virtual unsigned long long getWritten() const;
+
+		/*!
+		* @brief Get engine status
+		* @return TRUE if the aligned buffer was allocated and FALSE otherwise
+		*
+		* Constant function.
+		*
+		*/
+		bool getStatus() const;
+
+	protected:
+		char* m_buffer; /*!< Aligned buffer */
+		size_t m_bufferSize; /*!< Size of buffer */
+		size_t m_pending; /*!< Number of bytes of the incomplete block at the beginning of buffer */
+		bool m_drained; /*!< Incomplete block was written by drain and not modified since */
+	};
+}
+
+#endif
+
+//  ______________________________
+// |                              |
+// |    ______________________    |       
+// |   |                      |   |
+// |   |         sign         |   |
+// |   |        coding        |   |
+// |   |        dw@rf         |   |
+// |   |         1.0          |   |
+// |   |______________________|   |
+// |                              |
+// |______________________________|
+//               |  |           
+//               |  |             
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |__|
@@ -0,0 +1,227 @@
+/*!
+ * @file durabilityManager.h
+ * @brief Class used to make the data of split files durable
+ * @author Sign Coding Dwarf
+ * @version 1.0
+ * @date 19 October 2026
+ *
+ * Definition of the class flushing the files written by fileSplitter to disk according to a durability policy.
+ * Written data is identified by its position in the whole set of files. Positions returned by the writer are used as tickets that other threads may wait for.
+ * Concurrent waiters share the same fdatasync call (group commit). <br>
+ * To test if it is available with your library version use <br>
+ * \a \#if \a DWFUTILS_VERSION_NUMERIC>=111580308
+ *
+ */
+
+/*
+Copyright 2016 SignCodingDwarf
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+
+#ifndef DURABILITYMANAGER
+#define DURABILITYMANAGER
+
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "common_defines.h"
+
+/*!
+* @namespace dwf_utils
+* @brief A namespace used to regroup all utilitary functions or classes spanning through multiple applications
+*/
+namespace dwf_utils
+{
+	/*!
+	* @enum durabilityPolicy
+	* @brief Policy deciding when written data is flushed to disk
+	*/
+	enum durabilityPolicy
+	{
+		DURABLE_NONE, /*!< Data is never explicitly flushed */
+		DURABLE_BYTES, /*!< Data is flushed every time a given number of bytes is written */
+		DURABLE_PERIODIC, /*!< Data is flushed periodically */
+		DURABLE_GROUP /*!< Data is flushed only when a thread waits for it. All threads waiting at the same time share one flush */
+	};
+
+	/*! \struct durabilityStats
+	* \brief Statistics of the flushes performed by a durabilityManager
+	*/
+	struct durabilityStats
+	{
+		/*!
+		* @brief Constructor of the durabilityStats structure
+		*
+		* Set all statistics to 0.
+		*
+		*/
+		durabilityStats() : m_syncNb(0), m_syncTime(0), m_maxSyncTime(0), m_bytes(0), m_released(0), m_maxBatch(0)
+		{
+		}
+
+		unsigned long long m_syncNb; /*!< Number of flushes */
+		unsigned long long m_syncTime; /*!< Total time spent in flushes in microseconds */
+		unsigned long long m_maxSyncTime; /*!< Longest flush in microseconds */
+		unsigned long long m_bytes; /*!< Number of bytes made durable */
+		unsigned long long m_released; /*!< Number of successful waits */
+		unsigned long long m_maxBatch; /*!< Largest number of threads waiting when a flush started */
+	};
+
+	/*! \class durabilityManager
+	* \brief Class flushing written files to disk in a background thread
+	*
+	* The writer declares the file it writes with attach and the position up to which data is in the file with update. A background thread calls fdatasync according to the policy.
+	* Files are kept opened by the manager until they are flushed, so that the writer may close them at any time.
+	* Whatever the policy, previous files are flushed as soon as the writer attaches a new one. Except with DURABLE_PERIODIC, a waiting thread triggers a flush.
+	*
+	*/
+	class durabilityManager
+	{
+	public:
+		/*!
+		* @brief Constructor of the durabilityManager class
+		* @param policy : policy deciding when data is flushed
+		* @param bytes : number of bytes between two flushes with DURABLE_BYTES
+		* @param period : time between two flushes in milliseconds with DURABLE_PERIODIC
+		*
+		* Constructor of the durabilityManager class. Starts the background thread.
+		*
+		*/
+		durabilityManager(durabilityPolicy policy, unsigned long long bytes, unsigned int period);
+
+		/*!
+		* @brief Destructor of the durabilityManager class
+		*
+		* Destructor of the durabilityManager class. Flushes the data not durable yet and stops the background thread.
+		* Virtual function.
+		*
+		*/
+		virtual ~durabilityManager();
+
+		/*!
+		* @brief Start tracking a new file
+		* @param fd : descriptor of the file. The manager uses a duplicate of it.
+		* @return EXEC_SUCCESS if the file could be tracked and EXEC_FAILURE otherwise
+		*
+		* The previous file is flushed in background. Must be called from the writer thread.
+		*
+		*/
+		int attach(int fd);
+
+		/*!
+		* @brief Declare written data
+		* @param position : position in the whole set of files up to which data is in the files
+		*
+		* Must be called from the writer thread.
+		*
+		*/
+		void update(unsigned long long position);
+
+		/*!
+		* @brief Wait until data is durable
+		* @param ticket : position that must be made durable, as given to update
+		* @return EXEC_SUCCESS if data up to the ticket is on disk and EXEC_FAILURE if a flush failed or the ticket was never declared
+		*
+		* May be called from any thread.
+		*
+		*/
+		int waitDurable(unsigned long long ticket);
+
+		/*!
+		* @brief Get durable position
+		* @return Position up to which data is on disk
+		*
+		* Constant function.
+		*
+		*/
+		unsigned long long getDurable() const;
+
+		/*!
+		* @brief Get flush statistics
+		* @return Copy of the statistics
+		*
+		* Constant function.
+		*
+		*/
+		durabilityStats getStats() const;
+
+	protected:
+		/*!
+		* @brief Background thread loop
+		*
+		*/
+		void run();
+
+		/*!
+		* @brief Know if a flush must be performed
+		* @param last : time of the last flush
+		* @return TRUE if a flush is required and FALSE otherwise
+		*
+		* Must be called with the mutex locked.
+		* Constant function.
+		*
+		*/
+		bool syncRequired(std::chrono::steady_clock::time_point last) const;
+
+		durabilityPolicy m_policy; /*!< Policy deciding when data is flushed */
+		unsigned long long m_bytes; /*!< Number of bytes between two flushes with DURABLE_BYTES */
+		std::chrono::milliseconds m_period; /*!< Time between two flushes with DURABLE_PERIODIC */
+		int m_current; /*!< Duplicate of the descriptor of the current file, -1 if none */
+		std::vector<int> m_closed; /*!< Duplicates of the descriptors of previous files to flush and close */
+		unsigned long long m_position; /*!< Position up to which data is in the files */
+		unsigned long long m_durable; /*!< Position up to which data is on disk */
+		unsigned int m_waiters; /*!< Number of threads waiting for durability */
+		bool m_failed; /*!< A flush failed */
+		bool m_stop; /*!< Background thread stop request */
+		durabilityStats m_stats; /*!< Flush statistics */
+		mutable std::mutex m_mutex; /*!< Mutex protecting all members */
+		std::condition_variable m_request; /*!< Wakes background thread up */
+		std::condition_variable m_synced; /*!< Wakes waiters up after a flush */
+		std::thread m_thread; /*!< Background thread */
+
+	private:
+		durabilityManager(durabilityManager const&); // Not copyable
+		durabilityManager& operator=(durabilityManager const&);
+	};
+}
+
+#endif
+
+//  ______________________________
+// |                              |
+// |    ______________________    |       
+// |   |                      |   |
+// |   |         sign         |   |
+// |   |        coding        |   |
+// |   |        dw@rf         |   |
+// |   |         1.0          |   |
+// |   |______________________|   |
+// |                              |
+// |______________________________|
+//               |  |           
+//               |  |             
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |__|
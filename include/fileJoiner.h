@@ -0,0 +1,237 @@
+/*!
+ * @file fileJoiner.h
+ * @brief Class used to process the files written by fileSplitter in parallel
+ * @author Sign Coding Dwarf
+ * @version 1.0
+ * @date 19 October 2026
+ *
+ * Definition of the class discovering the files written by a fileSplitter and giving them to a pool of threads.
+ * Files are cut into units of lines which are processed in parallel through read-only memory mappings. Results are given back in file order. <br>
+ * To test if it is available with your library version use <br>
+ * \a \#if \a DWFUTILS_VERSION_NUMERIC>=111580308
+ *
+ */
+
+/*
+Copyright 2016 SignCodingDwarf
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+
+#ifndef FILEJOINER
+#define FILEJOINER
+
+#include <string>
+#include <vector>
+#include <functional>
+
+#include "common_defines.h"
+
+/*!
+* @def FILEJOINER_UNIT_SIZE
+* @brief Default number of bytes of a unit of work given to a thread
+*/
+#ifndef FILEJOINER_UNIT_SIZE
+#define FILEJOINER_UNIT_SIZE (1 << 26)
+#endif
+
+/*!
+* @namespace dwf_utils
+* @brief A namespace used to regroup all utilitary functions or classes spanning through multiple applications
+*/
+namespace dwf_utils
+{
+	/*! \struct segmentView
+	* \brief Unit of work given to a thread
+	*/
+	struct segmentView
+	{
+		size_t m_segment; /*!< Position of the file among discovered files */
+		size_t m_unit; /*!< Position of the unit among all units, in file order */
+		unsigned long long m_offset; /*!< Offset of the data in the file */
+		const char* m_data; /*!< Data of the unit. Only valid during the processing of the unit */
+		size_t m_size; /*!< Number of bytes of the unit */
+	};
+
+	/*! \class fileJoiner
+	* \brief Class processing split files in parallel
+	*
+	* Files are found in the manifest written by fileSplitter or, if there is none, by listing the directory of the files.
+	* Files of the manifest compressed by fileSplitter are decompressed in memory and processed as a single unit. A file of the manifest found neither raw nor compressed is an error.
+	* Each file is cut into units of about unitSize bytes, starting and ending at line ends, so that a line always belongs to a single unit.
+	* Units are taken by threads in file order and read through read-only memory mappings advised as sequential.
+	*
+	*/
+	class fileJoiner
+	{
+	public:
+		/*!
+		* @brief Constructor of the fileJoiner class
+		* @param baseName : base name given to the fileSplitter
+		* @param extension : extension given to the fileSplitter. Dot is automatically added before extension if not present.
+		* @param threadNb : number of threads. Default 0 uses one thread per core.
+		* @param unitSize : approximate size of units in bytes. 0 gives one unit per file. Default is FILEJOINER_UNIT_SIZE.
+		*
+		* Constructor of the fileJoiner class. Discovers the files.
+		*
+		*/
+		fileJoiner(std::string baseName, std::string extension, unsigned int threadNb = 0, unsigned long long unitSize = FILEJOINER_UNIT_SIZE);
+
+		/*!
+		* @brief Destructor of the fileJoiner class
+		*
+		* Virtual function.
+		*
+		*/
+		virtual ~fileJoiner();
+
+		/*!
+		* @brief Discover files again
+		* @return EXEC_SUCCESS if files could be listed and EXEC_FAILURE otherwise, for example if a file of the manifest is missing
+		*
+		*/
+		int discover();
+
+		/*!
+		* @brief Get number of files
+		* @return Number of discovered files
+		*
+		* Constant function.
+		*
+		*/
+		size_t getSegmentNb() const;
+
+		/*!
+		* @brief Get name of a file
+		* @param i : position of the file
+		* @return Name of the file
+		*
+		* Constant function.
+		*
+		*/
+		std::string const& getSegment(size_t i) const;
+
+		/*!
+		* @brief Get number of units
+		* @return Number of units all files are cut into
+		*
+		* Constant function.
+		*
+		*/
+		size_t getUnitNb() const;
+
+		/*!
+		* @brief Process every unit in parallel
+		* @param task : function called for each unit containing data. It is called from several threads at the same time.
+		* @return EXEC_SUCCESS if every file could be read and EXEC_FAILURE otherwise
+		*
+		* Units are processed in no particular order.
+		*
+		*/
+		int forEach(std::function<void(segmentView const&)> task);
+
+		/*!
+		* @brief Process every unit in parallel and gather results in order
+		* @tparam Result : type of the result of a unit. Must be default constructible and different from bool.
+		* @param task : function called for each unit containing data. It is called from several threads at the same time.
+		* @param results : receives one result per unit in file order. Units without data get a default constructed result.
+		* @return EXEC_SUCCESS if every file could be read and EXEC_FAILURE otherwise
+		*
+		*/
+		template <class Result>
+		int map(std::function<Result(segmentView const&)> task, std::vector<Result>& results)
+		{
+			results.assign(m_units.size(), Result());
+			return forEach([&task, &results](segmentView const& view) { results[view.m_unit] = task(view); }); // Each unit writes its own element
+		}
+
+	protected:
+		/*! \struct unit
+		* \brief Nominal byte range of a unit, before alignment on line ends
+		*/
+		struct unit
+		{
+			size_t m_segment; /*!< Position of the file */
+			unsigned long long m_begin; /*!< First byte of the range */
+			unsigned long long m_end; /*!< Byte following the range */
+		};
+
+		/*!
+		* @brief List files matching the base name in their directory
+		* @param names : receives the names of the files, sorted by id, with or without time stamp
+		* @return EXEC_SUCCESS if directory could be read and EXEC_FAILURE otherwise
+		*
+		* Files in the numbered subdirectories of baseName, written with the m_fanOut option of fileSplitter, are listed too.
+		* Constant function.
+		*
+		*/
+		int listDirectory(std::vector<std::string>& names) const;
+
+		/*!
+		* @brief Process a unit
+		* @param index : position of the unit
+		* @param task : function to call
+		* @return EXEC_SUCCESS if file could be read and EXEC_FAILURE otherwise
+		*
+		* Constant function.
+		*
+		*/
+		int processUnit(size_t index, std::function<void(segmentView const&)> const& task) const;
+
+		/*!
+		* @brief Give the lines of a unit to the task
+		* @param index : position of the unit
+		* @param data : content of the whole file
+		* @param size : number of bytes of the file
+		* @param task : function to call
+		*
+		* The range of the unit is moved to line ends. Constant function.
+		*
+		*/
+		void processRange(size_t index, const char* data, size_t size, std::function<void(segmentView const&)> const& task) const;
+
+		std::string m_baseName; /*!< Base name of the files */
+		std::string m_extension; /*!< Extension of the files */
+		unsigned int m_threadNb; /*!< Number of threads */
+		unsigned long long m_unitSize; /*!< Approximate size of units */
+		std::vector<std::string> m_segments; /*!< Names of the files in order */
+		std::vector<unit> m_units; /*!< Units of all files in order */
+	};
+}
+
+#endif
+
+//  ______________________________
+// |                              |
+// |    ______________________    |       
+// |   |                      |   |
+// |   |         sign         |   |
+// |   |        coding        |   |
+// |   |        dw@rf         |   |
+// |   |         1.0          |   |
+// |   |______________________|   |
+// |                              |
+// |______________________________|
+//               |  |           
+//               |  |             
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |__|
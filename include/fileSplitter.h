@@ -6,7 +6,7 @@
  * @date 15 May 2016
  *
  * Definition of the class used to store a big set of data in multiple subfiles to get smaller files and avoid too much data loss due to file corruption or program bugs.
- * The amount of data to store is determined by the number of call to operator<<. User may also manually trigger a file change. <br>
+ * The amount of data to store is determined by the number of call to operator<< or by the number of bytes written. User may also manually trigger a file change. <br>
  * To test if it is available with your library version use <br>
  * \a \#if \a DWFUTILS_VERSION_NUMERIC>=111552336
  *
@@ -33,11 +33,22 @@ limitations under the License.
 #define FILESPLITTER
 
 #include <iostream>
-#include <fstream>
 #include <string>
+#include <memory>
+#include <future>
+#include <vector>
+#include <deque>
+#include <ctime>
 
 #include "common_defines.h"
 #include "convUtils.h"
+#include "segmentBuf.h"
+#include "workerThread.h"
+#include "durabilityManager.h"
+#include "splitManifest.h"
+#include "segmentCompressor.h"
+#include "recordFraming.h"
+#include "splitterStats.h"
 
 /*! 
 * @namespace dwf_utils
@@ -45,6 +56,54 @@ limitations under the License.
 */
 namespace dwf_utils
 {
+	/*!
+	* @enum splitCriterion
+	* @brief Criterion triggering a file change
+	*/
+	enum splitCriterion
+	{
+		SPLIT_CALLS, /*!< File is changed when the number of operator<< calls reaches the file size */
+		SPLIT_BYTES /*!< File is changed at the first line end once the number of written bytes reaches the file size */
+	};
+
+	/*! \struct splitterOptions
+	* \brief Options of the fileSplitter class
+	*
+	* Structure regrouping the optional behaviours of fileSplitter. Default constructed options give the original fileSplitter behaviour.
+	*
+	*/
+	struct splitterOptions
+	{
+		/*!
+		* @brief Constructor of the splitterOptions structure
+		*
+		* Set all options to their default value.
+		*
+		*/
+		splitterOptions() : m_criterion(SPLIT_CALLS), m_prepareNext(false), m_preallocate(0), m_syncOnClose(false), m_writer(WRITER_BUFFERED), m_bufferSize(0), m_durability(DURABLE_NONE), m_durableBytes(1 << 20), m_durablePeriod(1000), m_manifest(false), m_indexInterval(1024), m_maxSegments(0), m_maxBytes(0), m_rotatePeriod(0), m_timeNames(false), m_compression(COMPRESS_NONE), m_compressQueue(16), m_fanOut(0)
+		{
+		}
+
+		splitCriterion m_criterion; /*!< Criterion triggering file change. Default is SPLIT_CALLS */
+		bool m_prepareNext; /*!< Open the next file and close the previous one in a background thread so that a file change only swaps descriptors. Default is false */
+		unsigned long long m_preallocate; /*!< Number of bytes reserved on disk when a file is created, without changing its size. 0 disables reservation. Default is 0 */
+		bool m_syncOnClose; /*!< Flush file content to disk before closing it. Done in the background thread with m_prepareNext. Default is false */
+		writerMode m_writer; /*!< Engine used to write files. Default is WRITER_BUFFERED */
+		size_t m_bufferSize; /*!< Size of the write buffers in bytes. 0 uses the default of the engine : SEGMENTBUF_DEFAULT_SIZE, URING_BUFFER_SIZE or DIRECT_BUFFER_SIZE. Larger buffers mean fewer write system calls. Not used with WRITER_MMAP. Default is 0 */
+		durabilityPolicy m_durability; /*!< Policy deciding when data is flushed to disk in background. Default is DURABLE_NONE */
+		unsigned long long m_durableBytes; /*!< Number of bytes between two flushes with DURABLE_BYTES. Default is 1 MB */
+		unsigned int m_durablePeriod; /*!< Time between two flushes in milliseconds with DURABLE_PERIODIC. Default is 1000 */
+		bool m_manifest; /*!< Write a manifest describing complete files and their sparse indexes (see splitManifest.h). Default is false */
+		unsigned long m_indexInterval; /*!< Number of records between two index entries with m_manifest. 0 disables indexes. Default is 1024 */
+		unsigned long m_maxSegments; /*!< Maximal number of files kept, including the current one. The oldest file is reused for a new one, or removed in background with m_prepareNext. 0 is unlimited. Default is 0 */
+		unsigned long long m_maxBytes; /*!< Maximal number of bytes of the files kept, the size of new files being estimated. The oldest file is reused for a new one, or removed in background with m_prepareNext. 0 is unlimited. Default is 0 */
+		unsigned int m_rotatePeriod; /*!< Duration of a file in seconds. Periods are aligned on multiples of this duration since epoch, so 60 or 3600 give a file per minute or hour of UTC time. The file is changed at the first record after the end of the period. 0 disables time rotation. Default is 0 */
+		bool m_timeNames; /*!< Name files baseName_<Stamp>_<Id>.extension where Stamp is the UTC start of their period as YYYYMMDDThhmmss, or their creation time without m_rotatePeriod. Default is false */
+		compressionCodec m_compression; /*!< Codec used to compress complete files in a background thread. splitReader and fileJoiner decompress the files of the manifest already compressed. Default is COMPRESS_NONE */
+		size_t m_compressQueue; /*!< Maximal number of files waiting for compression. Files completed when the queue is full are kept raw. Default is 16 */
+		unsigned long m_fanOut; /*!< Number of files per subdirectory. Files are then named baseName/<Id/m_fanOut>/name_<Id>.extension where name is the last component of baseName, subdirectories being created when first needed. 0 keeps all files beside baseName. Default is 0 */
+	};
+
 	/*! \class fileSplitter
 	* \brief Class allowing an automatic separation of a big file writing into smaller files
 	*
@@ -54,21 +113,92 @@ namespace dwf_utils
 	class fileSplitter
 	{
 	public:
+		/*! \class record
+		* \brief Scoped record of a fileSplitter
+		*
+		* Guard opening a record on a fileSplitter at construction and committing it at destruction. All data inserted through the guard is written in the same file.
+		*
+		*/
+		class record
+		{
+		public:
+			/*!
+			* @brief Constructor of the record class
+			* @param splitter : fileSplitter in which the record is written
+			*
+			* Opens a record on the splitter.
+			*
+			*/
+			explicit record(fileSplitter& splitter) : m_splitter(splitter)
+			{
+				m_splitter.beginRecord();
+			}
+
+			/*!
+			* @brief Destructor of the record class
+			*
+			* Commits the record, which may trigger a file change.
+			*
+			*/
+			~record()
+			{
+				m_splitter.commitRecord();
+			}
+
+			/*!
+			* @brief Declaration of operator<<
+			* @tparam T : type of the data to write
+			* @param data : data to write in file
+			* @return A reference to the modified record allowing to channel multiple insertion in flux
+			*
+			* operator<< forwarding data to the splitter. T must contain operator<<.
+			*
+			*/
+			template <class T>
+			record& operator<<(T const& data)
+			{
+				m_splitter << data;
+				return *this;
+			}
+
+			/*!
+			* @brief Overload of operator<<
+			* @param pf : functor on a manipulator of ostream fluxes.
+			* @return A reference to the modified record allowing to channel multiple insertion in flux
+			*
+			* Overload of operator<< allowing to use manipulators such as endl.
+			*
+			*/
+			record& operator<<(std::ostream& (*pf)(std::ostream&))
+			{
+				m_splitter << pf;
+				return *this;
+			}
+
+		protected:
+			fileSplitter& m_splitter; /*!< Splitter in which the record is written */
+
+		private:
+			record(record const&); // Not copyable
+			record& operator=(record const&);
+		};
+
 		/*!
 		* @brief Constructor of the fileSplitter class
 		* @param baseName : base name of the files. All files wil be named baseName_<Id>.extension
 		* @param extension : extension of the files. All files wil be named baseName_<Id>.extension. Dot is automatically added befor extension if not present.
-		* @param fileSize : Maximum number of operator<< calls before triggering writing to a new file
+		* @param fileSize : Maximum number of operator<< calls (or of bytes with SPLIT_BYTES criterion) before triggering writing to a new file
+		* @param options : optional behaviours of the splitter. Default gives the original behaviour.
 		*
 		* Constructor of the fileSplitter class allowing to initialize our class and open the baseName_0.extension file. 
 		*
 		*/
-		fileSplitter(std::string baseName, std::string extension, unsigned long fileSize);  
+		fileSplitter(std::string baseName, std::string extension, unsigned long fileSize, splitterOptions const& options = splitterOptions());
 
 		/*!
 		* @brief Destructor of the fileSplitter class
 		*
-		* Destructor of the fileSplitter class. Closes the last file if it is opened.
+		* Destructor of the fileSplitter class. Closes the last file if it is opened and removes the file prepared in advance if any.
 		* Virtual function.
 		*
 		*/
@@ -78,11 +208,33 @@ namespace dwf_utils
 		* @brief Perform change file to which write
 		*
 		* Perform change file from the file named baseName_<Id>.extension to the file named baseName_<Id+1>.extension. This method is automatically called in operator<< when the number of operator<< calls reaches the desired limit. But the user may also trigger changes by himself.
+		* With the m_prepareNext option, the next file is already opened and the previous one is closed in background.
 		* Virtual function.
 		*
 		*/
 		virtual int changeFile();
 
+		/*!
+		* @brief Open a record
+		*
+		* Open a record. Until the record is committed, no automatic file change is performed so that the record is entirely written in the same file.
+		* With the m_manifest option, records of the manifest and indexes are lines whatever the record guards, so that splitReader finds them by counting lines.
+		* Records may be nested, only the outermost one is taken into account.
+		* Manual calls to changeFile are still performed immediately.
+		*
+		*/
+		void beginRecord();
+
+		/*!
+		* @brief Commit a record
+		* @return EXEC_SUCCESS if record could be committed and EXEC_FAILURE if no record was opened or if the file change failed
+		*
+		* Close the current record. If the split criterion was reached during the record, the file change is performed now. 
+		* With the SPLIT_BYTES criterion, a committed record is a valid split point even if it does not end with a new line.
+		*
+		*/
+		int commitRecord();
+
 		/*!
 		* @brief Know if file is available for writing
 		* @return TRUE if file can be used for writing and FALSE otherwise
@@ -93,6 +245,65 @@ namespace dwf_utils
 		*/
 		bool getStatus() const;
 
+		/*!
+		* @brief Flush written data to the current file
+		* @return EXEC_SUCCESS if data could be flushed and EXEC_FAILURE otherwise
+		*
+		* Flush the data buffered by the flux to the current file.
+		*
+		*/
+		int flush();
+
+		/*!
+		* @brief Get a durability ticket
+		* @return Ticket identifying all the data written so far, 0 with the DURABLE_NONE policy
+		*
+		* Write all buffered data to the file and declare it to the durability manager. The returned ticket can be given to waitDurable from any thread.
+		*
+		*/
+		unsigned long long requestDurability();
+
+		/*!
+		* @brief Wait until data is on disk
+		* @param ticket : ticket returned by requestDurability
+		* @return EXEC_SUCCESS if data of the ticket is on disk and EXEC_FAILURE otherwise or with the DURABLE_NONE policy
+		*
+		* With the DURABLE_GROUP policy, the flush is triggered by the wait and shared by all the threads waiting at the same time.
+		* May be called from any thread.
+		*
+		*/
+		int waitDurable(unsigned long long ticket);
+
+		/*!
+		* @brief Get statistics of the flushes to disk
+		* @return Flush statistics, empty with the DURABLE_NONE policy
+		*
+		* May be called from any thread.
+		* Constant function.
+		*
+		*/
+		durabilityStats getDurabilityStats() const;
+
+		/*!
+		* @brief Get statistics of the compression of complete files
+		* @return Compression statistics, empty with COMPRESS_NONE
+		*
+		* May be called from any thread.
+		* Constant function.
+		*
+		*/
+		compressionStats getCompressionStats() const;
+
+		/*!
+		* @brief Get statistics of the splitter
+		* @return Snapshot of written bytes and records, file changes, failures, flushes and compressions
+		*
+		* May be called from any thread. Counters cost a plain store per insertion to the writing thread.
+		* Constant function.
+		*
+		*/
+		splitterStats getStats() const;
+
 		/*!
 		* @brief Declaration of operator<<
 		* @tparam T : type of the data to wrtie
@@ -100,6 +311,8 @@ namespace dwf_utils
 		* @return A reference to the modified fileSplitter object allowing to channel multiple insertion in flux
 		*
 		* operator<< allowing to write into our splitted files and checks if file change must be performed. T must contain operator<<.
+		* With the SPLIT_BYTES criterion, files are only changed after a line end so that a line is never split between two files.
+		* Inside a record, file change is delayed until the record is committed.
 		*
 		*/
 		template <class T>
@@ -107,9 +320,19 @@ namespace dwf_utils
 		{
 			if(m_status)
 			{
+				if(m_options.m_rotatePeriod > 0 && m_recordDepth == 0)
+				{
+					rotateOnPeriod();
+				}
+				if(m_options.m_manifest) // Each line is a record, as for splitReader
+				{
+					countLine();
+				}
 		    		m_file << data;
 				++m_written;
-				if(m_written >= m_fileSize)
+				trackDurability();
+				updateStats();
+				if(splitRequired())
 				{
 					changeFile() == EXEC_FAILURE && (m_status = false); 
 				}
@@ -129,9 +352,52 @@ namespace dwf_utils
 		{
 			if(m_status)
 			{
+				if(m_options.m_rotatePeriod > 0 && m_recordDepth == 0)
+				{
+					rotateOnPeriod();
+				}
+				if(m_options.m_manifest)
+				{
+					countLine();
+				}
 		    		pf(m_file);
 				++m_written;
-				if(m_written >= m_fileSize)
+				trackDurability();
+				updateStats();
+				if(splitRequired())
+				{
+					changeFile() == EXEC_FAILURE && (m_status = false); 
+				}
+			}
+			return *this;
+		}
+
+		/*!
+		* @brief Write a block of characters
+		* @param data : characters to write
+		* @param size : number of characters
+		* @return A reference to the modified fileSplitter object
+		*
+		* Write characters without formatting. Counts as a single operator<< call.
+		*
+		*/
+		fileSplitter& write(const char* data, std::streamsize size)
+		{
+			if(m_status)
+			{
+				if(m_options.m_rotatePeriod > 0 && m_recordDepth == 0)
+				{
+					rotateOnPeriod();
+				}
+				if(m_options.m_manifest)
+				{
+					countLine();
+				}
+				m_file.write(data, size);
+				++m_written;
+				trackDurability();
+				updateStats();
+				if(splitRequired())
 				{
 					changeFile() == EXEC_FAILURE && (m_status = false); 
 				}
@@ -139,15 +405,65 @@ namespace dwf_utils
 			return *this;
 		}
 
+		/*!
+		* @brief Write a framed binary record
+		* @param data : payload of the record
+		* @param size : number of bytes of the payload, at most FRAME_MAX_SIZE
+		* @return EXEC_SUCCESS if record could be written and EXEC_FAILURE otherwise
+		*
+		* Write the record preceded by its length and CRC (see recordFraming.h), so that a torn record at the end of a file can be found and removed with recoverFramedFile.
+		* The frame is an outermost record of its own : it counts as a single operator<< call, is never split between two files and is a valid split point with the SPLIT_BYTES criterion.
+		*
+		*/
+		int writeFrame(const char* data, size_t size);
+
+		/*!
+		* @brief Move data from a descriptor into the files
+		* @param fd : descriptor of a pipe, socket or file, read from its current position
+		* @param size : maximal number of bytes to move
+		* @param moved : receives the number of bytes moved
+		* @return EXEC_SUCCESS if data could be moved until size bytes, the end of source data or a non blocking source without data, and EXEC_FAILURE otherwise
+		*
+		* Data goes from the descriptor to the file with splice, copy_file_range or sendfile, without copy through user space with the WRITER_BUFFERED engine. Other engines read the descriptor into their buffers.
+		* With the SPLIT_BYTES criterion, files are changed exactly at the size limit, so lines of the source may be split between two files. Otherwise the data moved into a file counts as a single operator<< call.
+		* Outside a record, the data moved into a file by a call is a record for statistics. For the manifest it is a record if it starts a line, so splitReader::seekRecord is only exact for sources giving lines one call at a time.
+		* A failure of the source or of the file sets the status to false, as for other writes.
+		*
+		*/
+		int ingest(int fd, unsigned long long size, unsigned long long& moved);
+
 
 	protected:
-		std::ofstream m_file; /*!< Flux to file */
+		segmentBuf m_buf; /*!< Buffer of the flux, counting written bytes */
+		std::ostream m_file; /*!< Flux to file */
+		splitterOptions m_options; /*!< Optional behaviours */
 		std::string m_baseName; /*!< Base name of files */
 		std::string m_extension; /*!< Extension of files */
-		unsigned long m_fileSize; /*!< Maximal number of operator<< calls */
+		unsigned long m_fileSize; /*!< Maximal number of operator<< calls or of bytes */
 		unsigned long m_written; /*!< Current number of operator<< calls */
 		unsigned long m_fileNb; /*!< Number of files already complete */
 		bool m_status; /*!< Indicates status of class */
+		unsigned int m_recordDepth; /*!< Number of opened records */
+		std::unique_ptr<workerThread> m_worker; /*!< Background thread opening and closing files, NULL without m_prepareNext option */
+		std::future<int> m_next; /*!< Descriptor of the file prepared in advance */
+		unsigned long m_nextId; /*!< Id of the file prepared in advance */
+		std::string m_nextName; /*!< Name of the file prepared in advance */
+		time_t m_stamp; /*!< Start of the period of the current file, or its creation time without m_rotatePeriod */
+		unsigned long long m_periodEnd; /*!< Monotonic time of the end of the current period in nanoseconds, 0 before the first file */
+		std::unique_ptr<durabilityManager> m_durability; /*!< Background flushes to disk, NULL with DURABLE_NONE policy */
+		std::unique_ptr<segmentCompressor> m_compressor; /*!< Background compression of complete files, NULL with COMPRESS_NONE */
+		unsigned long long m_durableBase; /*!< Position of the beginning of the current file in the whole set of files */
+		unsigned long long m_reported; /*!< Number of bytes of the current file given to the engine at the last declaration */
+		int m_manifestFd; /*!< Descriptor of the manifest, -1 without m_manifest option */
+		segmentInfo m_segment; /*!< Description of the current file */
+		unsigned long long m_recordNb; /*!< Number of records written in all files */
+		std::vector<indexEntry> m_index; /*!< Index entries of the current file not written yet */
+		unsigned long long m_indexCountdown; /*!< Number of records before the next indexed record */
+		std::deque<segmentInfo> m_live; /*!< Complete files kept with m_maxSegments or m_maxBytes, oldest first */
+		unsigned long long m_liveBytes; /*!< Number of bytes of complete files kept */
+		int m_indexFd; /*!< Descriptor of the index of the current file, -1 if not created yet */
+		mutable splitterCounters m_counters; /*!< Statistics counters, close failures being counted by the thread releasing files */
+		unsigned long long m_bytesBase; /*!< Number of bytes of complete files */
 
 		/*!
 		* @brief Add dot to extension
@@ -156,6 +472,212 @@ namespace dwf_utils
 		*
 		*/
 		void addDot();
+
+		/*!
+		* @brief Know if file change must be performed
+		* @return TRUE if the split criterion is reached and FALSE otherwise
+		*
+		* Constant function.
+		*
+		*/
+		bool splitRequired() const
+		{
+			if(m_recordDepth > 0) // Never split a record
+			{
+				return false;
+			}
+			if(m_options.m_criterion == SPLIT_BYTES)
+			{
+				return m_buf.getBytes() >= m_fileSize && m_buf.endsLine(); // Counting is incremental, no tellp call
+			}
+			return m_written >= m_fileSize;
+		}
+
+		/*!
+		* @brief Declare written data to the durability manager if required
+		*
+		* Only done with policies flushing data without waiters, when the buffer was given to the engine since the last declaration.
+		*
+		*/
+		void trackDurability()
+		{
+			if(m_durability && m_options.m_durability != DURABLE_GROUP && m_buf.getCommitted() != m_reported)
+			{
+				m_reported = m_buf.getCommitted();
+				m_durability->update(m_durableBase + m_buf.getWritten());
+			}
+		}
+
+		/*!
+		* @brief Update the statistics counters after an insertion
+		*
+		* Publish the number of written bytes and count the insertion as a record when it is outside a record.
+		*
+		*/
+		void updateStats()
+		{
+			m_counters.m_bytes.store(m_bytesBase + m_buf.getBytes(), std::memory_order_relaxed);
+			if(m_recordDepth == 0)
+			{
+				splitterCounters::add(m_counters.m_records, 1);
+			}
+		}
+
+		/*!
+		* @brief Take a new record into account in manifest and index
+		*
+		* Called before the record is written, so that the current size is the offset of the record. Only a counter is updated except for indexed records.
+		*
+		*/
+		void countRecord()
+		{
+			if(m_indexCountdown == 0)
+			{
+				indexRecord();
+			}
+			--m_indexCountdown;
+			++m_recordNb;
+		}
+
+		/*!
+		* @brief Take a new record into account if an insertion starts a line
+		*
+		* Records of the manifest and indexes are lines, the ones splitReader counts to seek a record. An insertion continuing a line is not a new record.
+		*
+		*/
+		void countLine()
+		{
+			if(m_buf.getBytes() == 0 || m_buf.endsLine())
+			{
+				countRecord();
+			}
+		}
+
+		/*!
+		* @brief Add an index entry for the new record
+		*
+		*/
+		void indexRecord();
+
+		/*!
+		* @brief Write index entries kept in memory
+		*
+		*/
+		void flushIndex();
+
+		/*!
+		* @brief Change file if the period of the current one is over
+		*
+		* Called before each record with m_rotatePeriod. Only reads a coarse clock, without system call, until the period is over.
+		* With the SPLIT_BYTES criterion, file is not changed in the middle of a line. A file in which nothing was written is renamed instead of being changed.
+		*
+		*/
+		void rotateOnPeriod();
+
+		/*!
+		* @brief Start the period of a new file
+		*
+		* Compute m_stamp and the end of the period from the real time clock.
+		*
+		*/
+		void startPeriod();
+
+		/*!
+		* @brief Get name of a file
+		* @param id : Id of the file
+		* @param stamp : start of the period of the file, only used with m_timeNames
+		* @return File name as baseName_<Id>.extension or baseName_<Stamp>_<Id>.extension
+		*
+		* May be called from the background thread.
+		* Constant and virtual function.
+		*
+		*/
+		virtual std::string segmentName(unsigned long id, time_t stamp) const;
+
+		/*!
+		* @brief Create a file
+		* @param name : name of the file
+		* @param victims : names of the files to remove, oldest first. The first one is renamed and reused instead of being removed, unless files are compressed. Empty for a file prepared in advance.
+		* @return Descriptor of the file opened for writing, -1 on failure
+		*
+		* Create or truncate a file and reserve disk space if requested. A reused file keeps its blocks allocated but its previous content is zeroed, or the file is truncated where this is not supported, so that it cannot be recovered as new records after a crash.
+		* May be called from the background thread.
+		* Constant function.
+		*
+		*/
+		int createFile(std::string const& name, std::vector<std::string> const& victims) const;
+
+		/*!
+		* @brief Know if the number or size of files is limited
+		* @return TRUE if m_maxSegments or m_maxBytes is used and FALSE otherwise
+		*
+		* Constant function.
+		*
+		*/
+		bool retention() const
+		{
+			return m_options.m_maxSegments > 0 || m_options.m_maxBytes > 0;
+		}
+
+		/*!
+		* @brief Select the files to remove before creating a new one
+		* @param pending : number of files not complete yet, including the one to create
+		* @return Names of the files to remove, oldest first
+		*
+		* Selected files are removed from the manifest immediately, before they are renamed or removed.
+		*
+		*/
+		std::vector<std::string> selectVictims(unsigned int pending);
+
+		/*!
+		* @brief Open a file
+		* @param id : Id of the file to open
+		* @return EXEC_SUCCESS if file could be opened and EXEC_FAILURE otherwise
+		*
+		* Open a file, using the file prepared in advance if available, and reset the flux state.
+		* With the m_prepareNext option, preparation of the next file is requested.
+		*
+		*/
+		int openFile(unsigned long id);
+
+		/*!
+		* @brief Close the current file
+		*
+		* Write remaining data and close the current file, in background with the m_prepareNext option.
+		*
+		*/
+		void closeFile();
+
+		/*!
+		* @brief Release a complete file
+		* @param fd : descriptor of the file
+		* @param size : number of bytes written in the file
+		* @param name : name of the file
+		*
+		* Release unused reserved disk space, flush file to disk if requested, close the descriptor and submit the file for compression. May be called from the background thread.
+		* Constant function.
+		*
+		*/
+		void releaseFile(int fd, unsigned long long size, std::string const& name) const;
+
+		/*!
+		* @brief Remove a file no longer kept
+		* @param name : name of the file
+		* @param created : name of the file created instead, whose subdirectory is kept
+		*
+		* Remove the file, its index, its compressed version and its subdirectory if it becomes empty. With compression, the file is removed by the compression thread after its pending compression. May be called from the background thread.
+		* Constant function.
+		*
+		*/
+		void removeFile(std::string const& name, std::string const& created) const;
+
+		/*!
+		* @brief Remove the file prepared in advance
+		*
+		* Close and remove the file prepared in advance if it was not used.
+		*
+		*/
+		void discardNext();
 	};
 }
 
@@ -0,0 +1,103 @@
+/*!
+ * @file lzCodec.h
+ * @brief Functions used to compress data without external library
+ * @author Sign Coding Dwarf
+ * @version 1.0
+ * @date 19 October 2026
+ *
+ * Definition of a fast LZ77 block codec in the spirit of LZ4. Blocks are made of sequences of literals followed by a match copied from at most 64 KB before.
+ * It favours speed over ratio so that compressing log files costs less than writing them. <br>
+ * To test if it is available with your library version use <br>
+ * \a \#if \a DWFUTILS_VERSION_NUMERIC>=111580308
+ *
+ */
+
+/*
+Copyright 2016 SignCodingDwarf
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+
+#ifndef LZCODEC
+#define LZCODEC
+
+#include <cstddef>
+#include <vector>
+
+#include "common_defines.h"
+
+/*!
+* @def LZ_HASH_BITS
+* @brief Number of bits of the hash table used to find matches
+*/
+#ifndef LZ_HASH_BITS
+#define LZ_HASH_BITS 12
+#endif
+
+/*!
+* @namespace dwf_utils
+* @brief A namespace used to regroup all utilitary functions or classes spanning through multiple applications
+*/
+namespace dwf_utils
+{
+	/*!
+	* @brief Compress a block
+	* @param data : data to compress
+	* @param size : number of bytes to compress
+	* @param out : vector to which the compressed block is appended
+	*
+	* Incompressible data grows by less than 1 %.
+	*
+	*/
+	void lzCompress(const char* data, size_t size, std::vector<char>& out);
+
+	/*!
+	* @brief Decompress a block
+	* @param data : compressed block
+	* @param size : number of bytes of the compressed block
+	* @param out : buffer receiving the data
+	* @param rawSize : number of bytes of the data, as given to lzCompress
+	* @return EXEC_SUCCESS if the block is valid and EXEC_FAILURE otherwise
+	*
+	* Never writes outside out, even for a corrupted block.
+	*
+	*/
+	int lzDecompress(const char* data, size_t size, char* out, size_t rawSize);
+}
+
+#endif
+
+//  ______________________________
+// |                              |
+// |    ______________________    |       
+// |   |                      |   |
+// |   |         sign         |   |
+// |   |        coding        |   |
+// |   |        dw@rf         |   |
+// |   |         1.0          |   |
+// |   |______________________|   |
+// |                              |
+// |______________________________|
+//               |  |           
+//               |  |             
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |__|
@@ -0,0 +1,192 @@
+/*!
+ * @file mmapEngine.h
+ * @brief Class used to write split files through a memory mapping
+ * @author Sign Coding Dwarf
+ * @version 1.0
+ * @date 19 October 2026
+ *
+ * Definition of the write engine reserving each file on disk and mapping it in memory so that writing a record is a plain copy without any system call.
+ * Files are grown by steps of the mapping size when needed and truncated to their used length when released. <br>
+ * To test if it is available with your library version use <br>
+ * \a \#if \a DWFUTILS_VERSION_NUMERIC>=111580308
+ *
+ */
+
+/*
+Copyright 2016 SignCodingDwarf
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+
+#ifndef MMAPENGINE
+#define MMAPENGINE
+
+#include <vector>
+
+#include "common_defines.h"
+#include "writeEngine.h"
+
+/*!
+* @def MMAP_SEGMENT_SIZE
+* @brief Default number of bytes reserved and mapped at once by the mmapEngine
+*/
+#ifndef MMAP_SEGMENT_SIZE
+#define MMAP_SEGMENT_SIZE (1 << 26)
+#endif
+
+/*!
+* @def MMAP_WINDOW_SIZE
+* @brief Number of bytes copied in the mapping between two write back requests
+*/
+#ifndef MMAP_WINDOW_SIZE
+#define MMAP_WINDOW_SIZE (1 << 20)
+#endif
+
+/*!
+* @namespace dwf_utils
+* @brief A namespace used to regroup all utilitary functions or classes spanning through multiple applications
+*/
+namespace dwf_utils
+{
+	/*! \class mmapEngine
+	* \brief Engine writing into a shared memory mapping of the file
+	*
+	* The file is extended to the mapping size with reserved blocks, so that a full disk is reported when the file is attached instead of crashing the process on a page fault.
+	* Buffers given to segmentBuf are windows of MMAP_WINDOW_SIZE bytes of the mapping. Committing a window asks the kernel to start writing it back and marks the pages as sequentially accessed so that they are reclaimed first.
+	* On detach the mapping is released and the file truncated to the number of bytes written. <br>
+	* Crash consistency : if the process crashes, all data copied in the mapping is kept by the system but the file is not truncated, so it ends with up to MMAP_SEGMENT_SIZE null bytes.
+	* If the system crashes, data not yet written back is lost. It is at most the current window plus the windows whose write back was still in progress, usually a few MMAP_WINDOW_SIZE. Use the m_syncOnClose option of fileSplitter to make closed files durable.
+	*
+	*/
+	class mmapEngine : public writeEngine
+	{
+	public:
+		/*!
+		* @brief Constructor of the mmapEngine class
+		* @param mapSize : number of bytes reserved when a file is attached and added each time it is full. Default is MMAP_SEGMENT_SIZE.
+		*
+		*/
+		explicit mmapEngine(size_t mapSize = MMAP_SEGMENT_SIZE);
+
+		/*!
+		* @brief Destructor of the mmapEngine class
+		*
+		* Virtual function.
+		*
+		*/
+		virtual ~mmapEngine();
+
+		/*!
+		* @brief Get flags required to open files
+		* @return O_RDWR, required by shared mappings
+		*
+		* Constant and virtual function.
+		*
+		*/
+		virtual int openFlags() const;
+
+		/*!
+		* @brief Start writing in a file
+		* @param fd : descriptor of the file opened for reading and writing
+		* @return EXEC_SUCCESS if file could be reserved and mapped and EXEC_FAILURE otherwise
+		*
+		* Virtual function.
+		*
+		*/
+		virtual int attach(int fd);
+
+		/*!
+		* @brief Stop writing in the current file
+		* @return EXEC_SUCCESS if mapping could be released and file truncated and EXEC_FAILURE otherwise
+		*
+		* Virtual function.
+		*
+		*/
+		virtual int detach();
+
+		/*!
+		* @brief Get the buffer to fill
+		* @param size : receives the capacity of the buffer in bytes
+		* @return Pointer to the next window of the mapping
+		*
+		* The file is extended when the mapping is full. If no file is mapped or it could not be extended, a scratch buffer is returned and the next commit fails.
+		* Virtual function.
+		*
+		*/
+		virtual char* getBuffer(size_t& size);
+
+		/*!
+		* @brief Validate the filled buffer
+		* @param size : number of bytes filled at the beginning of the buffer
+		* @return EXEC_SUCCESS if data is in the mapping and EXEC_FAILURE otherwise
+		*
+		* Virtual function.
+		*
+		*/
+		virtual int commit(size_t size);
+
+	protected:
+		/*!
+		* @brief Reserve and map more of the file
+		* @return EXEC_SUCCESS if mapping could be extended and EXEC_FAILURE otherwise
+		*
+		*/
+		int grow();
+
+		/*!
+		* @brief Start writing back the data committed since last request
+		*
+		*/
+		void writeBack();
+
+		/*!
+		* @brief Release the mapping
+		*
+		*/
+		void unmap();
+
+		size_t m_mapSize; /*!< Number of bytes added to the mapping at once */
+		char* m_map; /*!< Mapping of the current file, NULL if none */
+		size_t m_mapped; /*!< Length of the mapping */
+		unsigned long long m_writtenBack; /*!< Offset up to which write back was requested */
+		bool m_failed; /*!< Mapping could not be extended since the file was attached */
+		std::vector<char> m_scratch; /*!< Buffer given when no mapping is usable */
+	};
+}
+
+#endif
+
+//  ______________________________
+// |                              |
+// |    ______________________    |       
+// |   |                      |   |
+// |   |         sign         |   |
+// |   |        coding        |   |
+// |   |        dw@rf         |   |
+// |   |         1.0          |   |
+// |   |______________________|   |
+// |                              |
+// |______________________________|
+//               |  |           
+//               |  |             
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |__|
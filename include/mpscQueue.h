@@ -0,0 +1,200 @@
+/*!
+ * @file mpscQueue.h
+ * @brief Lock-free multiple producers single consumer queue
+ * @author Sign Coding Dwarf
+ * @version 1.0
+ * @date 19 October 2026
+ *
+ * Definition of an unbounded lock-free queue allowing several threads to push data while a single thread pops it.
+ * Push is wait-free (a single atomic exchange) and pop never blocks producers. <br>
+ * Based on the intrusive MPSC node-based queue by Dmitry Vyukov. <br>
+ * To test if it is available with your library version use <br>
+ * \a \#if \a DWFUTILS_VERSION_NUMERIC>=111580308
+ *
+ */
+
+/*
+Copyright 2016 SignCodingDwarf
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+
+#ifndef MPSCQUEUE
+#define MPSCQUEUE
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+/*!
+* @namespace dwf_utils
+* @brief A namespace used to regroup all utilitary functions or classes spanning through multiple applications
+*/
+namespace dwf_utils
+{
+	/*! \class mpscQueue
+	* \brief Unbounded lock-free queue with multiple producers and a single consumer
+	* \tparam T : type of the stored data. T must be default constructible and movable.
+	*
+	* Queue in which any number of threads may call push concurrently while only one thread calls pop. Elements pushed by a given thread are popped in the order they were pushed.
+	*
+	*/
+	template <class T>
+	class mpscQueue
+	{
+	public:
+		/*!
+		* @brief Constructor of the mpscQueue class
+		*
+		* Constructor of the mpscQueue class. Creates the stub node the queue is built on.
+		*
+		*/
+		mpscQueue() : m_head(new node()), m_pad(), m_tail(m_head.load(std::memory_order_relaxed)), m_size(0)
+		{
+		}
+
+		/*!
+		* @brief Destructor of the mpscQueue class
+		*
+		* Destructor of the mpscQueue class. Releases all the remaining elements. No thread must use the queue anymore.
+		*
+		*/
+		~mpscQueue()
+		{
+			T data;
+			while(pop(data))
+			{
+			}
+			delete m_tail;
+		}
+
+		/*!
+		* @brief Add an element to the queue
+		* @param data : element to add. It is moved into the queue.
+		*
+		* Add an element at the end of the queue. May be called from any thread.
+		*
+		*/
+		void push(T data)
+		{
+			node* n = new node(std::move(data));
+			m_size.fetch_add(1, std::memory_order_relaxed); // Counted before the consumer can see it, so that its pop never makes the size negative
+			node* prev = m_head.exchange(n, std::memory_order_acq_rel); // Serialization point of producers
+			prev->m_next.store(n, std::memory_order_release); // Link previous node. Consumer sees the element from now on
+		}
+
+		/*!
+		* @brief Remove the first element of the queue
+		* @param data : reference receiving the element
+		* @return TRUE if an element was popped and FALSE if queue is empty
+		*
+		* Remove the first element of the queue. Must only be called from the consumer thread.
+		* An element whose push is still in progress is considered as not yet in the queue.
+		*
+		*/
+		bool pop(T& data)
+		{
+			node* tail = m_tail;
+			node* next = tail->m_next.load(std::memory_order_acquire);
+			if(next == NULL)
+			{
+				return false;
+			}
+			data = std::move(next->m_data);
+			m_tail = next; // next becomes the new stub
+			delete tail;
+			m_size.fetch_sub(1, std::memory_order_relaxed);
+			return true;
+		}
+
+		/*!
+		* @brief Know if queue seems empty
+		* @return TRUE if no element can be popped and FALSE otherwise
+		*
+		* Know if queue is empty. Only accurate when called from the consumer thread.
+		* Constant function.
+		*
+		*/
+		bool empty() const
+		{
+			return m_tail->m_next.load(std::memory_order_acquire) == NULL;
+		}
+
+		/*!
+		* @brief Get approximate number of elements
+		* @return Number of elements currently stored
+		*
+		* Get the number of elements in queue. Value is approximate while producers or consumer are running.
+		* Constant function.
+		*
+		*/
+		size_t size() const
+		{
+			return m_size.load(std::memory_order_relaxed);
+		}
+
+	protected:
+		/*! \struct node
+		* \brief Element of the linked list
+		*/
+		struct node
+		{
+			node() : m_data(), m_next(NULL)
+			{
+			}
+
+			explicit node(T&& data) : m_data(std::move(data)), m_next(NULL)
+			{
+			}
+
+			T m_data; /*!< Stored element */
+			std::atomic<node*> m_next; /*!< Next node in list */
+		};
+
+		std::atomic<node*> m_head; /*!< Last pushed node, shared by producers */
+		char m_pad[64]; /*!< Keeps producers and consumer data on different cache lines */
+		node* m_tail; /*!< Stub node preceding first element, owned by consumer */
+		std::atomic<size_t> m_size; /*!< Approximate number of elements */
+
+	private:
+		mpscQueue(mpscQueue const&); // Not copyable
+		mpscQueue& operator=(mpscQueue const&);
+	};
+}
+
+#endif
+
+//  ______________________________
+// |                              |
+// |    ______________________    |       
+// |   |                      |   |
+// |   |         sign         |   |
+// |   |        coding        |   |
+// |   |        dw@rf         |   |
+// |   |         1.0          |   |
+// |   |______________________|   |
+// |                              |
+// |______________________________|
+//               |  |           
+//               |  |             
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |__|
@@ -0,0 +1,407 @@
+/*!
+ * @file pathBuffer.h
+ * @brief Class used to build paths without heap allocation
+ * @author Sign Coding Dwarf
+ * @version 1.0
+ * @date 19 October 2026
+ *
+ * Definition of a path type holding usual paths in an inline buffer, with join, normalization and relative path operations working in place.
+ * Memory is only allocated for paths longer than the inline buffer, so that building paths in loops over many files costs no allocation. <br>
+ * To test if it is available with your library version use <br>
+ * \a \#if \a DWFUTILS_VERSION_NUMERIC>=111580308
+ *
+ */
+
+/*
+Copyright 2016 SignCodingDwarf
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+
+#ifndef PATHBUFFER
+#define PATHBUFFER
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+
+#include "common_defines.h"
+
+/*!
+* @def PATH_BUFFER_SIZE
+* @brief Size of the inline buffer of a pathBuffer, terminating null character included
+*/
+#ifndef PATH_BUFFER_SIZE
+#define PATH_BUFFER_SIZE 256
+#endif
+
+/*!
+* @namespace dwf_utils
+* @brief A namespace used to regroup all utilitary functions or classes spanning through multiple applications
+*/
+namespace dwf_utils
+{
+	/*! \class pathBuffer
+	* \brief Path held in an inline buffer
+	*
+	* Paths shorter than PATH_BUFFER_SIZE are held without allocation. Longer paths are held in an allocated buffer kept until the pathBuffer is destroyed.
+	* The path is always null terminated, so c_str can be given directly to system calls.
+	* Typical loop : join a file name to a directory, use the path, then truncate back to the size of the directory.
+	*
+	*/
+	class pathBuffer
+	{
+	public:
+		/*!
+		* @brief Constructor of the pathBuffer class
+		*
+		* Builds an empty path.
+		*
+		*/
+		pathBuffer();
+
+		/*!
+		* @brief Constructor of the pathBuffer class
+		* @param path : null terminated path
+		*
+		*/
+		pathBuffer(const char* path);
+
+		/*!
+		* @brief Constructor of the pathBuffer class
+		* @param path : path
+		* @param size : number of characters of the path
+		*
+		*/
+		pathBuffer(const char* path, size_t size);
+
+		/*!
+		* @brief Constructor of the pathBuffer class
+		* @param path : path
+		*
+		*/
+		pathBuffer(std::string const& path);
+
+		/*!
+		* @brief Copy constructor of the pathBuffer class
+		* @param other : path to copy
+		*
+		*/
+		pathBuffer(pathBuffer const& other);
+
+		/*!
+		* @brief Move constructor of the pathBuffer class
+		* @param other : path to move, left empty
+		*
+		*/
+		pathBuffer(pathBuffer&& other);
+
+		/*!
+		* @brief Assignment operator of the pathBuffer class
+		* @param other : path to copy
+		* @return Reference to this path
+		*
+		*/
+		pathBuffer& operator=(pathBuffer const& other);
+
+		/*!
+		* @brief Move assignment operator of the pathBuffer class
+		* @param other : path to move, left empty
+		* @return Reference to this path
+		*
+		*/
+		pathBuffer& operator=(pathBuffer&& other);
+
+		/*!
+		* @brief Destructor of the pathBuffer class
+		*
+		* Frees the allocated buffer if any.
+		*
+		*/
+		~pathBuffer();
+
+		/*!
+		* @brief Get path
+		* @return Null terminated path, valid until the path is modified
+		*
+		* Constant function.
+		*
+		*/
+		const char* c_str() const
+		{
+			return m_data;
+		}
+
+		/*!
+		* @brief Get size of the path
+		* @return Number of characters of the path
+		*
+		* Constant function.
+		*
+		*/
+		size_t size() const
+		{
+			return m_size;
+		}
+
+		/*!
+		* @brief Know if path is empty
+		* @return TRUE if path has no character and FALSE otherwise
+		*
+		* Constant function.
+		*
+		*/
+		bool empty() const
+		{
+			return m_size == 0;
+		}
+
+		/*!
+		* @brief Know if path is held in the inline buffer
+		* @return TRUE if no buffer was allocated and FALSE otherwise
+		*
+		* Constant function.
+		*
+		*/
+		bool isInline() const
+		{
+			return m_data == m_inline;
+		}
+
+		/*!
+		* @brief Know if path is absolute
+		* @return TRUE if path starts with '/' and FALSE otherwise
+		*
+		* Constant function.
+		*
+		*/
+		bool isAbsolute() const
+		{
+			return m_size > 0 && m_data[0] == '/';
+		}
+
+		/*!
+		* @brief Get path as a string
+		* @return Copy of the path
+		*
+		* Constant function.
+		*
+		*/
+		std::string str() const
+		{
+			return std::string(m_data, m_size);
+		}
+
+		/*!
+		* @brief Get name of the last component
+		* @return Null terminated last component, empty if path ends with '/'
+		*
+		* Constant function.
+		*
+		*/
+		const char* name() const;
+
+		/*!
+		* @brief Empty the path
+		*
+		* Allocated buffer is kept for next uses.
+		*
+		*/
+		void clear()
+		{
+			truncate(0);
+		}
+
+		/*!
+		* @brief Shorten the path
+		* @param size : new number of characters, ignored if larger than the current one
+		*
+		*/
+		void truncate(size_t size)
+		{
+			if(size < m_size)
+			{
+				m_size = size;
+				m_data[m_size] = '\0';
+			}
+		}
+
+		/*!
+		* @brief Reserve memory
+		* @param size : number of characters the path must be able to hold without allocation
+		*
+		*/
+		void reserve(size_t size);
+
+		/*!
+		* @brief Replace the path
+		* @param path : new path
+		* @param size : number of characters of the new path
+		* @return Reference to this path
+		*
+		*/
+		pathBuffer& assign(const char* path, size_t size);
+
+		/*!
+		* @brief Append characters
+		* @param data : characters to append
+		* @param size : number of characters
+		* @return Reference to this path
+		*
+		* No separator is added.
+		*
+		*/
+		pathBuffer& append(const char* data, size_t size);
+
+		/*!
+		* @brief Append a component
+		* @param name : component to add
+		* @param size : number of characters of the component
+		* @return Reference to this path
+		*
+		* A single '/' is put between the path and the component. An absolute component replaces the path.
+		*
+		*/
+		pathBuffer& join(const char* name, size_t size);
+
+		/*!
+		* @brief Append a component
+		* @param name : null terminated component to add
+		* @return Reference to this path
+		*
+		* A single '/' is put between the path and the component. An absolute component replaces the path.
+		*
+		*/
+		pathBuffer& join(const char* name)
+		{
+			return join(name, strlen(name));
+		}
+
+		/*!
+		* @brief Append a component
+		* @param name : component to add
+		* @return Reference to this path
+		*
+		* A single '/' is put between the path and the component. An absolute component replaces the path.
+		*
+		*/
+		pathBuffer& join(std::string const& name)
+		{
+			return join(name.c_str(), name.size());
+		}
+
+		/*!
+		* @brief Append a component
+		* @param name : component to add
+		* @return Reference to this path
+		*
+		* A single '/' is put between the path and the component. An absolute component replaces the path.
+		*
+		*/
+		pathBuffer& join(pathBuffer const& name)
+		{
+			return join(name.c_str(), name.size());
+		}
+
+		/*!
+		* @brief Remove the last component
+		* @return Reference to this path
+		*
+		* The path keeps its last '/', so a/b/c gives a/b/ and /a gives /. A path without '/' becomes empty.
+		*
+		*/
+		pathBuffer& parent();
+
+		/*!
+		* @brief Normalize the path
+		* @return Reference to this path
+		*
+		* Lexical normalization done in place : repeated '/' and "." components are removed and ".." components remove the previous component.
+		* ".." components at the start of a relative path are kept and dropped at the root of an absolute path. A trailing '/' is kept.
+		* An empty relative result becomes ".". Symbolic links are not resolved.
+		*
+		*/
+		pathBuffer& normalize();
+
+		/*!
+		* @brief Get path relative to a base directory
+		* @param base : directory from which the path is given
+		* @param result : receives the relative path, for example ../c for a/c from a/b
+		* @return EXEC_SUCCESS if relative path could be found and EXEC_FAILURE otherwise
+		*
+		* Both paths are normalized first. Fails if only one of the paths is absolute or if base goes up with ".." further than the path.
+		* Constant function.
+		*
+		*/
+		int relativeTo(pathBuffer const& base, pathBuffer& result) const;
+
+		/*!
+		* @brief Compare paths
+		* @param other : path to compare with
+		* @return TRUE if paths have the same characters and FALSE otherwise
+		*
+		* Paths are not normalized. Constant function.
+		*
+		*/
+		bool operator==(pathBuffer const& other) const
+		{
+			return m_size == other.m_size && memcmp(m_data, other.m_data, m_size) == 0;
+		}
+
+		/*!
+		* @brief Compare paths
+		* @param other : path to compare with
+		* @return TRUE if paths have different characters and FALSE otherwise
+		*
+		* Paths are not normalized. Constant function.
+		*
+		*/
+		bool operator!=(pathBuffer const& other) const
+		{
+			return !(*this == other);
+		}
+
+	protected:
+		char* m_data; /*!< Path, pointing to m_inline or to an allocated buffer */
+		size_t m_size; /*!< Number of characters of the path */
+		size_t m_capacity; /*!< Number of characters m_data can hold, terminating null character excluded */
+		char m_inline[PATH_BUFFER_SIZE]; /*!< Inline buffer */
+	};
+}
+
+#endif
+
+//  ______________________________
+// |                              |
+// |    ______________________    |       
+// |   |                      |   |
+// |   |         sign         |   |
+// |   |        coding        |   |
+// |   |        dw@rf         |   |
+// |   |         1.0          |   |
+// |   |______________________|   |
+// |                              |
+// |______________________________|
+//               |  |           
+//               |  |             
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |__|
@@ -0,0 +1,173 @@
+/*!
+ * @file recordFraming.h
+ * @brief Functions used to write binary records that can be checked after a crash
+ * @author Sign Coding Dwarf
+ * @version 1.0
+ * @date 19 October 2026
+ *
+ * Definition of the framing of binary records. A frame is made of a magic number, the payload length and a CRC32C of length and payload, followed by the payload.
+ * After a crash, the recovery scan only reads the end of a file to find the last complete frame and removes the torn one. <br>
+ * To test if it is available with your library version use <br>
+ * \a \#if \a DWFUTILS_VERSION_NUMERIC>=111580308
+ *
+ */
+
+/*
+Copyright 2016 SignCodingDwarf
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+
+#ifndef RECORDFRAMING
+#define RECORDFRAMING
+
+#include <cstddef>
+#include <string>
+#include <stdint.h>
+
+#include "common_defines.h"
+
+/*!
+* @def FRAME_MAGIC
+* @brief First bytes of a frame, "DWFR" in file
+*/
+#define FRAME_MAGIC 0x52465744U
+
+/*!
+* @def FRAME_HEADER_SIZE
+* @brief Number of bytes before the payload : magic, length and CRC on 4 bytes each, little endian
+*/
+#define FRAME_HEADER_SIZE 12
+
+/*!
+* @def FRAME_MAX_SIZE
+* @brief Largest payload of a frame. Longer lengths are considered corrupted
+*/
+#ifndef FRAME_MAX_SIZE
+#define FRAME_MAX_SIZE (1U << 30)
+#endif
+
+/*!
+* @def FRAME_RECOVERY_WINDOW
+* @brief Number of bytes read at the end of a file by the first step of the recovery scan
+*/
+#ifndef FRAME_RECOVERY_WINDOW
+#define FRAME_RECOVERY_WINDOW (64 * 1024)
+#endif
+
+/*!
+* @namespace dwf_utils
+* @brief A namespace used to regroup all utilitary functions or classes spanning through multiple applications
+*/
+namespace dwf_utils
+{
+	/*! \struct frameRecovery
+	* \brief Result of the recovery scan of a framed file
+	*/
+	struct frameRecovery
+	{
+		/*!
+		* @brief Constructor of the frameRecovery structure
+		*
+		* Set all values to 0.
+		*
+		*/
+		frameRecovery() : m_fileSize(0), m_validSize(0), m_scannedBytes(0), m_frameNb(0)
+		{
+		}
+
+		unsigned long long m_fileSize; /*!< Size of the file before recovery */
+		unsigned long long m_validSize; /*!< Size of the file ending with the last complete frame */
+		unsigned long long m_scannedBytes; /*!< Number of bytes read by the scan */
+		unsigned long long m_frameNb; /*!< Number of complete frames found in scanned bytes */
+	};
+
+	/*!
+	* @brief Compute a CRC32C (Castagnoli polynomial)
+	* @param data : bytes to check
+	* @param size : number of bytes
+	* @param crc : CRC of the previous bytes, to compute a CRC in several steps. Default is 0.
+	* @return CRC of the bytes
+	*
+	*/
+	uint32_t crc32c(const char* data, size_t size, uint32_t crc = 0);
+
+	/*!
+	* @brief Build the header of a frame
+	* @param data : payload of the frame
+	* @param size : number of bytes of the payload, at most FRAME_MAX_SIZE
+	* @param header : receives the FRAME_HEADER_SIZE bytes of the header
+	*
+	*/
+	void frameHeader(const char* data, size_t size, char* header);
+
+	/*!
+	* @brief Append a frame to a string
+	* @param out : string receiving the frame, for example a record given to concurrentFileSplitter
+	* @param data : payload of the frame
+	* @param size : number of bytes of the payload, at most FRAME_MAX_SIZE
+	*
+	*/
+	void appendFrame(std::string& out, const char* data, size_t size);
+
+	/*!
+	* @brief Check a frame
+	* @param data : position of the frame
+	* @param size : number of bytes available from data
+	* @return Number of bytes of the frame, header included, if a complete and valid frame starts at data and 0 otherwise
+	*
+	* The payload starts FRAME_HEADER_SIZE bytes after data.
+	*
+	*/
+	size_t checkFrame(const char* data, size_t size);
+
+	/*!
+	* @brief Find the end of the last complete frame of a file and remove what follows
+	* @param name : name of a file written with framed records
+	* @param truncate : truncate the file after the last complete frame
+	* @param result : receives sizes and scanned bytes
+	* @return EXEC_SUCCESS if file could be scanned (and truncated) and EXEC_FAILURE otherwise
+	*
+	* The scan reads the last FRAME_RECOVERY_WINDOW bytes, looks for the first valid frame in them and checks the frames following it. If no valid frame is found, the window is doubled, only the new bytes being read, until the beginning of the file.
+	* Read bytes are thus proportional to the size of the torn end and of the last frames, not to the file size. Everything following the first invalid frame after the window start is removed, including null bytes left by the mmap engine.
+	*
+	*/
+	int recoverFramedFile(std::string const& name, bool truncate, frameRecovery& result);
+}
+
+#endif
+
+//  ______________________________
+// |                              |
+// |    ______________________    |       
+// |   |                      |   |
+// |   |         sign         |   |
+// |   |        coding        |   |
+// |   |        dw@rf         |   |
+// |   |         1.0          |   |
+// |   |______________________|   |
+// |                              |
+// |______________________________|
+//               |  |           
+//               |  |             
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |__|
@@ -0,0 +1,308 @@
+/*!
+ * @file segmentBuf.h
+ * @brief Stream buffer used to write the segments of split files
+ * @author Sign Coding Dwarf
+ * @version 1.0
+ * @date 19 October 2026
+ *
+ * Definition of the stream buffer used by fileSplitter to write into its files.
+ * It keeps track of the number of bytes written in the current file without any system call so that files can be split according to their size. <br>
+ * To test if it is available with your library version use <br>
+ * \a \#if \a DWFUTILS_VERSION_NUMERIC>=111580308
+ *
+ */
+
+/*
+Copyright 2016 SignCodingDwarf
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+
+#ifndef SEGMENTBUF
+#define SEGMENTBUF
+
+#include <streambuf>
+#include <string>
+#include <memory>
+#include <cstdio>
+
+#include "common_defines.h"
+#include "writeEngine.h"
+
+/*!
+* @def SEGMENTBUF_DEFAULT_SIZE
+* @brief Default size of the segmentBuf write buffer in bytes
+*/
+#ifndef SEGMENTBUF_DEFAULT_SIZE
+#define SEGMENTBUF_DEFAULT_SIZE BUFSIZ
+#endif
+
+/*!
+* @namespace dwf_utils
+* @brief A namespace used to regroup all utilitary functions or classes spanning through multiple applications
+*/
+namespace dwf_utils
+{
+	/*! \class segmentBuf
+	* \brief Stream buffer writing into a file and counting written bytes
+	*
+	* Output stream buffer writing into a file descriptor. Data is accumulated in a buffer provided by a writeEngine and given back to the engine when the buffer is full or on synchronization.
+	* The size of the current file is tracked incrementally.
+	*
+	*/
+	class segmentBuf : public std::streambuf
+	{
+	public:
+		/*!
+		* @brief Constructor of the segmentBuf class
+		* @param bufferSize : size of the write buffer in bytes. Default is SEGMENTBUF_DEFAULT_SIZE.
+		*
+		* Constructor of the segmentBuf class using a pwriteEngine. No file is opened.
+		*
+		*/
+		explicit segmentBuf(size_t bufferSize = SEGMENTBUF_DEFAULT_SIZE);
+
+		/*!
+		* @brief Constructor of the segmentBuf class
+		* @param engine : engine used to write buffers. The segmentBuf becomes its owner.
+		*
+		* Constructor of the segmentBuf class. No file is opened.
+		*
+		*/
+		explicit segmentBuf(std::unique_ptr<writeEngine> engine);
+
+		/*!
+		* @brief Destructor of the segmentBuf class
+		*
+		* Destructor of the segmentBuf class. Writes remaining data and closes the file if it is opened.
+		* Virtual function.
+		*
+		*/
+		virtual ~segmentBuf();
+
+		/*!
+		* @brief Open a file
+		* @param fileName : name of the file to open. The file is created or truncated.
+		* @return EXEC_SUCCESS if file could be opened and EXEC_FAILURE otherwise
+		*
+		* Open a file for writing. The currently opened file is closed first.
+		*
+		*/
+		int open(const std::string& fileName);
+
+		/*!
+		* @brief Create a file usable by the engine
+		* @param fileName : name of the file to create
+		* @param truncate : truncate the file if it exists. Default is TRUE.
+		* @return Descriptor of the file or -1 on failure
+		*
+		* Files are opened with the flags of the engine. If the file system refuses O_DIRECT, the file is opened without it.
+		* The descriptor is not attached. May be called from any thread.
+		* Constant function.
+		*
+		*/
+		int create(const std::string& fileName, bool truncate = true) const;
+
+		/*!
+		* @brief Close the current file
+		* @return EXEC_SUCCESS if remaining data could be written and file closed and EXEC_FAILURE otherwise
+		*
+		*/
+		int close();
+
+		/*!
+		* @brief Use an already opened file
+		* @param fd : descriptor of a file opened for writing
+		* @return EXEC_SUCCESS if file could be attached and EXEC_FAILURE otherwise
+		*
+		* Start writing in an already opened file. The currently opened file is closed first. The segmentBuf becomes the owner of the descriptor.
+		*
+		*/
+		int attach(int fd);
+
+		/*!
+		* @brief Stop using the current file without closing it
+		* @return Descriptor of the file, -1 if no file was opened or if remaining data could not be written
+		*
+		* Write remaining data and release the descriptor of the current file. The caller becomes the owner of the descriptor.
+		*
+		*/
+		int detach();
+
+		/*!
+		* @brief Know if a file is opened
+		* @return TRUE if a file is opened and FALSE otherwise
+		*
+		* Constant function.
+		*
+		*/
+		bool isOpen() const;
+
+		/*!
+		* @brief Get access mode and flags required by the engine to open files
+		* @return Flags to add to the open call
+		*
+		* Constant function.
+		*
+		*/
+		int openFlags() const;
+
+		/*!
+		* @brief Get size of current file
+		* @return Number of bytes written in the current file, including buffered bytes
+		*
+		* Get the number of bytes written since the file was opened. No system call is performed.
+		* Constant function.
+		*
+		*/
+		unsigned long long getBytes() const
+		{
+			return m_flushed + (pptr() - pbase());
+		}
+
+		/*!
+		* @brief Get number of bytes given to the engine
+		* @return Number of bytes of the current file that left the buffer
+		*
+		* Constant function.
+		*
+		*/
+		unsigned long long getCommitted() const
+		{
+			return m_flushed;
+		}
+
+		/*!
+		* @brief Get number of bytes already in the file
+		* @return Number of bytes of the current file whose writing is complete
+		*
+		* Constant function.
+		*
+		*/
+		unsigned long long getWritten() const;
+
+		/*!
+		* @brief Write all data to the file
+		* @return EXEC_SUCCESS if all data could be written and EXEC_FAILURE otherwise
+		*
+		* Give buffer content to the engine and wait until the engine has written everything in the file.
+		*
+		*/
+		int drain();
+
+		/*!
+		* @brief Move data from a descriptor to the file
+		* @param source : descriptor of a pipe, socket or file to read from its current position
+		* @param size : maximal number of bytes to move
+		* @return Number of bytes moved, 0 at the end of source data and -1 on failure with errno set
+		*
+		* Buffer content is given to the engine first, then data is moved by the engine, without copy through user space with the default engine.
+		* Moved data is considered as ending a line.
+		*
+		*/
+		long long transfer(int source, size_t size);
+
+		/*!
+		* @brief Know if last written character ends a line
+		* @return TRUE if the last character written in the current file is a new line and FALSE otherwise
+		*
+		* Constant function.
+		*
+		*/
+		bool endsLine() const
+		{
+			return pptr() != pbase() ? pptr()[-1] == '\n' : m_lastChar == '\n';
+		}
+
+	protected:
+		/*!
+		* @brief Write buffer content when buffer is full
+		* @param c : character that could not be stored in buffer
+		* @return c or traits_type::eof() on failure
+		*
+		* Virtual function.
+		*
+		*/
+		virtual int_type overflow(int_type c);
+
+		/*!
+		* @brief Write multiple characters
+		* @param s : characters to write
+		* @param n : number of characters
+		* @return Number of written characters
+		*
+		* Small blocks complete the buffer before it is written. Large blocks are given to the engine with the buffer content without being copied, in a single system call with the default engine.
+		* Virtual function.
+		*
+		*/
+		virtual std::streamsize xsputn(const char* s, std::streamsize n);
+
+		/*!
+		* @brief Write buffer content to the file
+		* @return 0 on success and -1 on failure
+		*
+		* Virtual function.
+		*
+		*/
+		virtual int sync();
+
+		/*!
+		* @brief Give buffer content to the engine
+		* @return EXEC_SUCCESS if buffer could be written and EXEC_FAILURE otherwise
+		*
+		*/
+		int writeBuffer();
+
+		/*!
+		* @brief Get a new buffer from the engine
+		*
+		*/
+		void resetBuffer();
+
+		std::unique_ptr<writeEngine> m_engine; /*!< Engine writing buffers */
+		int m_fd; /*!< Descriptor of the current file, -1 if none */
+		unsigned long long m_flushed; /*!< Number of bytes of the current file already given to the engine */
+		char m_lastChar; /*!< Last character given to the engine */
+
+	private:
+		segmentBuf(segmentBuf const&); // Not copyable
+		segmentBuf& operator=(segmentBuf const&);
+	};
+}
+
+#endif
+
+//  ______________________________
+// |                              |
+// |    ______________________    |       
+// |   |                      |   |
+// |   |         sign         |   |
+// |   |        coding        |   |
+// |   |        dw@rf         |   |
+// |   |         1.0          |   |
+// |   |______________________|   |
+// |                              |
+// |______________________________|
+//               |  |           
+//               |  |             
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |__|
@@ -0,0 +1,271 @@
+/*!
+ * @file segmentCompressor.h
+ * @brief Class used to compress the files written by fileSplitter in background
+ * @author Sign Coding Dwarf
+ * @version 1.0
+ * @date 19 October 2026
+ *
+ * Definition of the compression stage run on complete split files. A background thread compresses each file into a temporary file, renames it and then removes the raw file.
+ * The built-in codec has no dependency. zlib is used for gzip files when it was found at configure time. <br>
+ * To test if it is available with your library version use <br>
+ * \a \#if \a DWFUTILS_VERSION_NUMERIC>=111580308
+ *
+ */
+
+/*
+Copyright 2016 SignCodingDwarf
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+
+#ifndef SEGMENTCOMPRESSOR
+#define SEGMENTCOMPRESSOR
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <mutex>
+
+#include "common_defines.h"
+#include "workerThread.h"
+
+/*!
+* @def COMPRESSION_BLOCK_SIZE
+* @brief Number of raw bytes compressed at once
+*/
+#ifndef COMPRESSION_BLOCK_SIZE
+#define COMPRESSION_BLOCK_SIZE (1 << 20)
+#endif
+
+/*!
+* @namespace dwf_utils
+* @brief A namespace used to regroup all utilitary functions or classes spanning through multiple applications
+*/
+namespace dwf_utils
+{
+	/*!
+	* @enum compressionCodec
+	* @brief Codec used to compress complete files
+	*/
+	enum compressionCodec
+	{
+		COMPRESS_NONE, /*!< Files are kept raw */
+		COMPRESS_LZ, /*!< Built-in LZ codec (see lzCodec.h). Files are named name.dlz */
+		COMPRESS_ZLIB /*!< gzip files named name.gz. Falls back to COMPRESS_LZ if the library was built without zlib */
+	};
+
+	/*! \struct compressionStats
+	* \brief Statistics of a segmentCompressor
+	*/
+	struct compressionStats
+	{
+		/*!
+		* @brief Constructor of the compressionStats structure
+		*
+		* Set all statistics to 0.
+		*
+		*/
+		compressionStats() : m_queued(0), m_compressed(0), m_skipped(0), m_failed(0), m_rawBytes(0), m_compressedBytes(0), m_time(0), m_maxDepth(0)
+		{
+		}
+
+		unsigned long long m_queued; /*!< Number of files accepted in queue */
+		unsigned long long m_compressed; /*!< Number of files compressed */
+		unsigned long long m_skipped; /*!< Number of files kept raw because the queue was full */
+		unsigned long long m_failed; /*!< Number of files kept raw because compression failed */
+		unsigned long long m_rawBytes; /*!< Number of bytes of compressed files before compression */
+		unsigned long long m_compressedBytes; /*!< Number of bytes of compressed files after compression */
+		unsigned long long m_time; /*!< Total time spent compressing in microseconds */
+		unsigned long long m_maxDepth; /*!< Largest number of files waiting in queue */
+	};
+
+	/*!
+	* @brief Get the codec actually used
+	* @param codec : requested codec
+	* @return codec, or COMPRESS_LZ if codec is COMPRESS_ZLIB and the library was built without zlib
+	*
+	*/
+	compressionCodec availableCodec(compressionCodec codec);
+
+	/*!
+	* @brief Get name of a compressed file
+	* @param name : name of the raw file
+	* @param codec : codec used
+	* @return name with the extension of the codec
+	*
+	*/
+	std::string compressedName(std::string const& name, compressionCodec codec);
+
+	/*!
+	* @brief Compress a file
+	* @param source : name of the raw file
+	* @param destination : name of the compressed file
+	* @param codec : codec to use
+	* @param sync : flush the compressed file to disk before returning
+	* @param compressedBytes : receives the size of the compressed file
+	* @return EXEC_SUCCESS if file could be compressed and EXEC_FAILURE otherwise
+	*
+	*/
+	int compressFile(std::string const& source, std::string const& destination, compressionCodec codec, bool sync, unsigned long long& compressedBytes);
+
+	/*!
+	* @brief Decompress a file
+	* @param source : name of the compressed file, format being found from its content
+	* @param data : receives the raw content
+	* @return EXEC_SUCCESS if file could be decompressed and EXEC_FAILURE otherwise
+	*
+	*/
+	int decompressFile(std::string const& source, std::vector<char>& data);
+
+	/*!
+	* @brief Find the compressed version of a file
+	* @param name : name of the raw file
+	* @param compressed : receives the name of the compressed file
+	* @return EXEC_SUCCESS if the file was compressed with any codec and EXEC_FAILURE otherwise
+	*
+	*/
+	int findCompressed(std::string const& name, std::string& compressed);
+
+	/*! \class segmentCompressor
+	* \brief Class compressing complete files in a background thread
+	*
+	* Files are compressed one after the other in the order they are submitted. Submission never waits: when the queue is full, the file is kept raw.
+	* Each file is compressed into name.ext.tmp, renamed name.ext and then the raw file is removed, so that one complete version of the file always exists.
+	*
+	*/
+	class segmentCompressor
+	{
+	public:
+		/*!
+		* @brief Constructor of the segmentCompressor class
+		* @param codec : codec to use
+		* @param capacity : maximal number of files waiting for compression
+		* @param sync : flush compressed files to disk before renaming them
+		*
+		*/
+		segmentCompressor(compressionCodec codec, size_t capacity, bool sync);
+
+		/*!
+		* @brief Destructor of the segmentCompressor class
+		*
+		* Compresses the files waiting in queue then stops the thread.
+		* Virtual function.
+		*
+		*/
+		virtual ~segmentCompressor();
+
+		/*!
+		* @brief Submit a file for compression
+		* @param name : name of the complete file
+		* @return TRUE if file was queued and FALSE if queue is full
+		*
+		* Never waits. May be called from any thread.
+		*
+		*/
+		bool submit(std::string const& name);
+
+		/*!
+		* @brief Remove a file and its compressed version
+		* @param name : name of the raw file
+		* @param directory : folder of the file, removed if it becomes empty. Empty string to keep it.
+		*
+		* Done in the background thread after the compression of the files already submitted, so that a compressed file cannot appear once removed.
+		* Never waits. May be called from any thread.
+		*
+		*/
+		void remove(std::string const& name, std::string const& directory);
+
+		/*!
+		* @brief Wait for the compression of submitted files
+		*
+		*/
+		void wait();
+
+		/*!
+		* @brief Get the codec used
+		* @return Codec used for compression
+		*
+		* Constant function.
+		*
+		*/
+		compressionCodec getCodec() const;
+
+		/*!
+		* @brief Get number of files waiting for compression
+		* @return Number of files in queue, including the one being compressed
+		*
+		* Constant function.
+		*
+		*/
+		size_t getDepth() const;
+
+		/*!
+		* @brief Get statistics
+		* @return Compression statistics
+		*
+		* Constant function.
+		*
+		*/
+		compressionStats getStats() const;
+
+	protected:
+		/*!
+		* @brief Compress a file and replace it
+		* @param name : name of the raw file
+		*
+		* Called from the background thread.
+		*
+		*/
+		void compress(std::string const& name);
+
+		compressionCodec m_codec; /*!< Codec used */
+		size_t m_capacity; /*!< Maximal number of files in queue */
+		bool m_sync; /*!< Flush compressed files before renaming them */
+		std::atomic<size_t> m_depth; /*!< Number of files in queue */
+		compressionStats m_stats; /*!< Statistics, protected by m_mutex */
+		mutable std::mutex m_mutex; /*!< Mutex protecting statistics */
+		std::unique_ptr<workerThread> m_worker; /*!< Background thread, destroyed first */
+
+	private:
+		segmentCompressor(segmentCompressor const&); // Not copyable
+		segmentCompressor& operator=(segmentCompressor const&);
+	};
+}
+
+#endif
+
+//  ______________________________
+// |                              |
+// |    ______________________    |       
+// |   |                      |   |
+// |   |         sign         |   |
+// |   |        coding        |   |
+// |   |        dw@rf         |   |
+// |   |         1.0          |   |
+// |   |______________________|   |
+// |                              |
+// |______________________________|
+//               |  |           
+//               |  |             
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |__|
@@ -0,0 +1,245 @@
+/*!
+ * @file shardedFileSplitter.h
+ * @brief Class used to spread records over several independent file splittings
+ * @author Sign Coding Dwarf
+ * @version 1.0
+ * @date 19 October 2026
+ *
+ * Definition of the class routing records to several concurrentFileSplitter shards, each one having its own files and its own writer thread.
+ * Records are routed by key so that the records of a key keep their order, or in turn when order does not matter. <br>
+ * To test if it is available with your library version use <br>
+ * \a \#if \a DWFUTILS_VERSION_NUMERIC>=111580308
+ *
+ */
+
+/*
+Copyright 2016 SignCodingDwarf
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+
+#ifndef SHARDEDFILESPLITTER
+#define SHARDEDFILESPLITTER
+
+#include <string>
+#include <vector>
+#include <memory>
+
+#include "common_defines.h"
+#include "concurrentFileSplitter.h"
+
+/*!
+* @namespace dwf_utils
+* @brief A namespace used to regroup all utilitary functions or classes spanning through multiple applications
+*/
+namespace dwf_utils
+{
+	/*! \class shardedFileSplitter
+	* \brief Class spreading records over several split files written in parallel
+	*
+	* Class owning shardNb concurrentFileSplitter, each one writing its own files from its own writer thread, so that write throughput grows with the number of cores.
+	* Shard k writes files named baseName_s<k>_<Id>.extension. Records submitted with the same key go to the same shard and keep their submission order.
+	*
+	*/
+	class shardedFileSplitter
+	{
+	public:
+		/*!
+		* @brief Constructor of the shardedFileSplitter class
+		* @param baseName : base name of the files. Files of shard k wil be named baseName_s<k>_<Id>.extension
+		* @param extension : extension of the files
+		* @param fileSize : Maximum number of records (or of bytes with SPLIT_BYTES criterion) written in a file of a shard before triggering writing to a new file
+		* @param shardNb : number of shards, at least 1
+		* @param options : optional behaviours of the fileSplitter of each shard
+		*
+		* Constructor of the shardedFileSplitter class. Opens the first file of each shard and starts their writer threads.
+		*
+		*/
+		shardedFileSplitter(std::string baseName, std::string extension, unsigned long fileSize, unsigned int shardNb, splitterOptions const& options = splitterOptions());
+
+		/*!
+		* @brief Destructor of the shardedFileSplitter class
+		*
+		* Destructor of the shardedFileSplitter class. Writes all submitted records then stops the writer threads.
+		* Virtual function.
+		*
+		*/
+		virtual ~shardedFileSplitter();
+
+		/*!
+		* @brief Get base name of the files of a shard
+		* @param baseName : base name of the shardedFileSplitter
+		* @param shard : index of the shard
+		* @return baseName_s<shard>, usable with splitReader or fileJoiner
+		*
+		*/
+		static std::string shardName(std::string const& baseName, unsigned int shard);
+
+		/*!
+		* @brief Submit a record routed by key
+		* @param key : key of the record
+		* @param data : record content
+		*
+		* May be called from any thread. Never waits for the file writing.
+		*
+		*/
+		void submit(std::string const& key, std::string data)
+		{
+			m_shards[shardOf(key)]->submit(std::move(data));
+		}
+
+		/*!
+		* @brief Submit a record routed by numerical key
+		* @param key : key of the record
+		* @param data : record content
+		*
+		* May be called from any thread. Never waits for the file writing.
+		*
+		*/
+		void submit(unsigned long long key, std::string data)
+		{
+			m_shards[shardOf(key)]->submit(std::move(data));
+		}
+
+		/*!
+		* @brief Submit a record without key
+		* @param data : record content
+		*
+		* Records of a thread are given in turn to each shard, so they may be written in any order.
+		* May be called from any thread. Never waits for the file writing.
+		*
+		*/
+		void submit(std::string data);
+
+		/*!
+		* @brief Get shard of a key
+		* @param key : key of a record
+		* @return Index of the shard receiving the records of this key
+		*
+		* Constant function.
+		*
+		*/
+		unsigned int shardOf(std::string const& key) const;
+
+		/*!
+		* @brief Get shard of a numerical key
+		* @param key : key of a record
+		* @return Index of the shard receiving the records of this key
+		*
+		* Keys are mixed first so that consecutive keys are spread over all shards.
+		* Constant function.
+		*
+		*/
+		unsigned int shardOf(unsigned long long key) const
+		{
+			key ^= key >> 33; // Final mixing of MurmurHash3
+			key *= 0xff51afd7ed558ccdULL;
+			key ^= key >> 33;
+			return static_cast<unsigned int>(key % m_shards.size());
+		}
+
+		/*!
+		* @brief Get a shard
+		* @param shard : index of the shard
+		* @return The concurrentFileSplitter of the shard, for example to build a concurrentFileSplitter::record
+		*
+		*/
+		concurrentFileSplitter& getShard(unsigned int shard);
+
+		/*!
+		* @brief Get number of shards
+		* @return Number of shards
+		*
+		* Constant function.
+		*
+		*/
+		unsigned int getShardNb() const;
+
+		/*!
+		* @brief Wait for submitted records
+		*
+		* Wait until all records submitted by the calling thread before this call are written and flushed to the files of every shard.
+		*
+		*/
+		void flush();
+
+		/*!
+		* @brief Wait until submitted records are on disk
+		* @return EXEC_SUCCESS if records of every shard are on disk and EXEC_FAILURE otherwise or with the DURABLE_NONE policy
+		*
+		*/
+		int waitDurable();
+
+		/*!
+		* @brief Know if files are available for writing
+		* @return TRUE if every shard can be used for writing and FALSE otherwise
+		*
+		* Constant function.
+		*
+		*/
+		bool getStatus() const;
+
+		/*!
+		* @brief Get number of records waiting for writing
+		* @return Approximate number of records in the queues of all shards
+		*
+		* Constant function.
+		*
+		*/
+		size_t getQueueDepth() const;
+
+		/*!
+		* @brief Get statistics of all shards
+		* @return Sum of the statistics of the shards, maxima being the largest of the shards
+		*
+		* Use getShard(k).getStats() for the statistics of a single shard.
+		* Constant function.
+		*
+		*/
+		splitterStats getStats() const;
+
+	protected:
+		std::vector<std::unique_ptr<concurrentFileSplitter> > m_shards; /*!< Shards, each one with its writer thread */
+
+	private:
+		shardedFileSplitter(shardedFileSplitter const&); // Not copyable
+		shardedFileSplitter& operator=(shardedFileSplitter const&);
+	};
+}
+
+#endif
+
+//  ______________________________
+// |                              |
+// |    ______________________    |       
+// |   |                      |   |
+// |   |         sign         |   |
+// |   |        coding        |   |
+// |   |        dw@rf         |   |
+// |   |         1.0          |   |
+// |   |______________________|   |
+// |                              |
+// |______________________________|
+//               |  |           
+//               |  |             
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |__|
@@ -0,0 +1,203 @@
+/*!
+ * @file splitManifest.h
+ * @brief Description of the files written by fileSplitter
+ * @author Sign Coding Dwarf
+ * @version 1.0
+ * @date 19 October 2026
+ *
+ * Definition of the manifest and of the sparse indexes written by fileSplitter so that records can be found without scanning every file.
+ * The manifest is a text file named baseName.manifest with one line per complete file : <br>
+ * \a id \a firstRecord \a recordNb \a bytes \a firstTime \a lastTime \a fileName <br>
+ * Records are lines : a record starts with each insertion made at the beginning of a line, binary frames being records of their own. File names are relative to the directory of the manifest, so that readers may run from any working directory. <br>
+ * Times are in microseconds since epoch, taken with a coarse clock for indexed records only so that the write path stays cheap. <br>
+ * The index of a file is a binary file named after the file with an additional .idx extension. It contains an indexEntry every given number of records. <br>
+ * To test if it is available with your library version use <br>
+ * \a \#if \a DWFUTILS_VERSION_NUMERIC>=111580308
+ *
+ */
+
+/*
+Copyright 2016 SignCodingDwarf
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+
+#ifndef SPLITMANIFEST
+#define SPLITMANIFEST
+
+#include <string>
+#include <vector>
+#include <deque>
+
+#include "common_defines.h"
+
+/*!
+* @def INDEX_FLUSH_ENTRIES
+* @brief Number of index entries kept in memory before being written
+*/
+#ifndef INDEX_FLUSH_ENTRIES
+#define INDEX_FLUSH_ENTRIES 256
+#endif
+
+/*!
+* @namespace dwf_utils
+* @brief A namespace used to regroup all utilitary functions or classes spanning through multiple applications
+*/
+namespace dwf_utils
+{
+	/*! \struct segmentInfo
+	* \brief Manifest entry describing a file
+	*/
+	struct segmentInfo
+	{
+		/*!
+		* @brief Constructor of the segmentInfo structure
+		*
+		* Set all fields to 0.
+		*
+		*/
+		segmentInfo() : m_id(0), m_firstRecord(0), m_recordNb(0), m_bytes(0), m_firstTime(0), m_lastTime(0), m_name()
+		{
+		}
+
+		unsigned long m_id; /*!< Id of the file */
+		unsigned long long m_firstRecord; /*!< Number of the first record of the file */
+		unsigned long long m_recordNb; /*!< Number of records in the file */
+		unsigned long long m_bytes; /*!< Size of the file */
+		unsigned long long m_firstTime; /*!< Time of the first record in microseconds since epoch */
+		unsigned long long m_lastTime; /*!< Time at which the file was completed in microseconds since epoch, 0 if it contains no record */
+		std::string m_name; /*!< Name of the file */
+	};
+
+	/*! \struct indexEntry
+	* \brief Entry of the sparse index of a file
+	*/
+	struct indexEntry
+	{
+		unsigned long long m_record; /*!< Number of the record */
+		unsigned long long m_offset; /*!< Offset of the record in the file */
+		unsigned long long m_time; /*!< Time of the record in microseconds since epoch */
+	};
+
+	/*!
+	* @brief Get the name of the manifest
+	* @param baseName : base name of the files
+	* @return Name of the manifest of the files
+	*
+	*/
+	std::string manifestName(const std::string& baseName);
+
+	/*!
+	* @brief Get the directory of a manifest
+	* @param fileName : name of the manifest
+	* @return Directory of the manifest ending with '/', empty for the working directory
+	*
+	*/
+	std::string manifestDirectory(const std::string& fileName);
+
+	/*!
+	* @brief Get the name of the index of a file
+	* @param fileName : name of the file
+	* @return Name of the index of the file
+	*
+	*/
+	std::string indexName(const std::string& fileName);
+
+	/*!
+	* @brief Get the time used for records
+	* @return Coarse current time in microseconds since epoch
+	*
+	* Uses a clock that does not require a system call.
+	*
+	*/
+	unsigned long long manifestTime();
+
+	/*!
+	* @brief Append a file description to a manifest
+	* @param fd : descriptor of the manifest
+	* @param info : description of the file
+	* @param directory : directory of the manifest given by manifestDirectory, removed from the start of the file name
+	* @return EXEC_SUCCESS if description could be written and EXEC_FAILURE otherwise
+	*
+	* The line is written with a single call so that readers never see a partial line.
+	*
+	*/
+	int appendManifest(int fd, segmentInfo const& info, const std::string& directory = std::string());
+
+	/*!
+	* @brief Replace a manifest
+	* @param fileName : name of the manifest
+	* @param segments : descriptions of the files, in order
+	* @return EXEC_SUCCESS if manifest could be written and EXEC_FAILURE otherwise
+	*
+	* The new manifest is written in a temporary file renamed over the previous one, so that readers see either the old or the new manifest.
+	*
+	*/
+	int writeManifest(const std::string& fileName, std::deque<segmentInfo> const& segments);
+
+	/*!
+	* @brief Read a manifest
+	* @param fileName : name of the manifest
+	* @param segments : receives the descriptions of the files, in order
+	* @return EXEC_SUCCESS if manifest could be read and EXEC_FAILURE otherwise
+	*
+	* Relative file names are given with the directory of the manifest, so that they can be opened from the working directory.
+	*
+	*/
+	int loadManifest(const std::string& fileName, std::vector<segmentInfo>& segments);
+
+	/*!
+	* @brief Append index entries to an index
+	* @param fd : descriptor of the index
+	* @param entries : entries to write
+	* @return EXEC_SUCCESS if entries could be written and EXEC_FAILURE otherwise
+	*
+	*/
+	int appendIndex(int fd, std::vector<indexEntry> const& entries);
+
+	/*!
+	* @brief Read an index
+	* @param fileName : name of the index
+	* @param entries : receives the entries, in order
+	* @return EXEC_SUCCESS if index could be read and EXEC_FAILURE otherwise
+	*
+	*/
+	int loadIndex(const std::string& fileName, std::vector<indexEntry>& entries);
+}
+
+#endif
+
+//  ______________________________
+// |                              |
+// |    ______________________    |       
+// |   |                      |   |
+// |   |         sign         |   |
+// |   |        coding        |   |
+// |   |        dw@rf         |   |
+// |   |         1.0          |   |
+// |   |______________________|   |
+// |                              |
+// |______________________________|
+//               |  |           
+//               |  |             
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |__|
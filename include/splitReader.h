@@ -0,0 +1,203 @@
+/*!
+ * @file splitReader.h
+ * @brief Class used to read the files written by fileSplitter
+ * @author Sign Coding Dwarf
+ * @version 1.0
+ * @date 19 October 2026
+ *
+ * Definition of the class reading the set of files written by fileSplitter with the m_manifest option.
+ * The manifest and the sparse indexes allow to start reading at a given record or time without scanning previous files. Files compressed by fileSplitter are decompressed in memory when opened. <br>
+ * To test if it is available with your library version use <br>
+ * \a \#if \a DWFUTILS_VERSION_NUMERIC>=111580308
+ *
+ */
+
+/*
+Copyright 2016 SignCodingDwarf
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+
+#ifndef SPLITREADER
+#define SPLITREADER
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+
+#include "common_defines.h"
+#include "splitManifest.h"
+
+/*!
+* @namespace dwf_utils
+* @brief A namespace used to regroup all utilitary functions or classes spanning through multiple applications
+*/
+namespace dwf_utils
+{
+	/*! \class splitReader
+	* \brief Class reading split files as a single flux of lines
+	*
+	* Class reading the complete files listed in the manifest of a fileSplitter. Lines are read in order, going through files transparently.
+	* Seeking uses the index entry preceding the requested record then skips the remaining records as lines. Records are thus expected to be lines unless every record is indexed.
+	*
+	*/
+	class splitReader
+	{
+	public:
+		/*!
+		* @brief Constructor of the splitReader class
+		* @param baseName : base name given to the fileSplitter
+		*
+		* Constructor of the splitReader class. Loads the manifest. No file is opened.
+		*
+		*/
+		explicit splitReader(std::string baseName);
+
+		/*!
+		* @brief Destructor of the splitReader class
+		*
+		* Virtual function.
+		*
+		*/
+		virtual ~splitReader();
+
+		/*!
+		* @brief Reload the manifest
+		* @return EXEC_SUCCESS if manifest could be read and EXEC_FAILURE otherwise
+		*
+		* Take into account files completed since the manifest was loaded. The reading position is kept.
+		*
+		*/
+		int reload();
+
+		/*!
+		* @brief Know if manifest could be read
+		* @return TRUE if manifest was read and FALSE otherwise
+		*
+		* Constant function.
+		*
+		*/
+		bool getStatus() const;
+
+		/*!
+		* @brief Get number of complete files
+		* @return Number of files listed in manifest
+		*
+		* Constant function.
+		*
+		*/
+		size_t getSegmentNb() const;
+
+		/*!
+		* @brief Get description of a file
+		* @param i : position of the file in manifest
+		* @return Description of the file
+		*
+		* Constant function.
+		*
+		*/
+		segmentInfo const& getSegment(size_t i) const;
+
+		/*!
+		* @brief Get number of records in complete files
+		* @return Number of records
+		*
+		* Constant function.
+		*
+		*/
+		unsigned long long getRecordNb() const;
+
+		/*!
+		* @brief Go to a record
+		* @param record : number of the record, starting at 0
+		* @return EXEC_SUCCESS if record exists and EXEC_FAILURE otherwise
+		*
+		* Next line read is the requested record.
+		*
+		*/
+		int seekRecord(unsigned long long record);
+
+		/*!
+		* @brief Go to a time
+		* @param time : time in microseconds since epoch
+		* @return EXEC_SUCCESS if a record was written at or after time and EXEC_FAILURE otherwise
+		*
+		* Next line read is a record written before time, no more than one index interval before the first record written at or after time.
+		*
+		*/
+		int seekTime(unsigned long long time);
+
+		/*!
+		* @brief Read a line
+		* @param line : receives the line without its end
+		* @return TRUE if a line was read and FALSE at the end of the last complete file or if a file of the manifest can be found neither raw nor compressed
+		*
+		*/
+		bool getLine(std::string& line);
+
+	protected:
+		/*!
+		* @brief Open a file of the manifest
+		* @param i : position of the file in manifest
+		* @param offset : offset at which reading starts, in the raw content
+		* @return EXEC_SUCCESS if file could be opened and EXEC_FAILURE otherwise
+		*
+		* If the raw file is missing, its compressed version is decompressed.
+		*
+		*/
+		int openSegment(size_t i, unsigned long long offset);
+
+		/*!
+		* @brief Close the opened file
+		*
+		*/
+		void closeSegment();
+
+		std::string m_baseName; /*!< Base name of the files */
+		std::vector<segmentInfo> m_segments; /*!< Descriptions of complete files */
+		bool m_status; /*!< Indicates manifest could be read */
+		size_t m_current; /*!< Position of the opened file in manifest */
+		std::filebuf m_fileBuf; /*!< Buffer of the opened raw file */
+		std::stringbuf m_memoryBuf; /*!< Content of the opened compressed file */
+		std::istream m_file; /*!< Opened file, reading m_fileBuf or m_memoryBuf */
+		bool m_open; /*!< Indicates a file is opened */
+	};
+}
+
+#endif
+
+//  ______________________________
+// |                              |
+// |    ______________________    |       
+// |   |                      |   |
+// |   |         sign         |   |
+// |   |        coding        |   |
+// |   |        dw@rf         |   |
+// |   |         1.0          |   |
+// |   |______________________|   |
+// |                              |
+// |______________________________|
+//               |  |           
+//               |  |             
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |__|
@@ -0,0 +1,194 @@
+/*!
+ * @file splitterStats.h
+ * @brief Statistics of file splitters and their text export
+ * @author Sign Coding Dwarf
+ * @version 1.0
+ * @date 19 October 2026
+ *
+ * Definition of the statistics snapshot of fileSplitter, concurrentFileSplitter and shardedFileSplitter, of the counters they update while writing and of their export in the Prometheus text format.
+ * Counters are relaxed atomics updated by a single thread without locked instructions, so that reading them from another thread costs nothing to the writer. <br>
+ * To test if it is available with your library version use <br>
+ * \a \#if \a DWFUTILS_VERSION_NUMERIC>=111580308
+ *
+ */
+
+/*
+Copyright 2016 SignCodingDwarf
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+
+#ifndef SPLITTERSTATS
+#define SPLITTERSTATS
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <atomic>
+
+#include "common_defines.h"
+#include "durabilityManager.h"
+#include "segmentCompressor.h"
+
+/*!
+* @def SPLITTER_LATENCY_BUCKETS
+* @brief Number of buckets of the file change latency histogram. Bucket k counts changes shorter than 2^k microseconds, the last one counts longer changes
+*/
+#ifndef SPLITTER_LATENCY_BUCKETS
+#define SPLITTER_LATENCY_BUCKETS 21
+#endif
+
+/*!
+* @namespace dwf_utils
+* @brief A namespace used to regroup all utilitary functions or classes spanning through multiple applications
+*/
+namespace dwf_utils
+{
+	/*! \struct splitterStats
+	* \brief Snapshot of the statistics of a file splitter
+	*/
+	struct splitterStats
+	{
+		/*!
+		* @brief Constructor of the splitterStats structure
+		*
+		* Set all statistics to 0.
+		*
+		*/
+		splitterStats();
+
+		unsigned long long m_bytes; /*!< Number of bytes written in all files, including buffered bytes */
+		unsigned long long m_records; /*!< Number of records written. An insertion outside a record is a record */
+		unsigned long long m_rotations; /*!< Number of file changes */
+		unsigned long long m_rotationTime; /*!< Total time spent in file changes in microseconds */
+		unsigned long long m_maxRotationTime; /*!< Longest file change in microseconds */
+		unsigned long long m_rotationHistogram[SPLITTER_LATENCY_BUCKETS]; /*!< Number of file changes per latency bucket (see SPLITTER_LATENCY_BUCKETS) */
+		unsigned long long m_openFailures; /*!< Number of files that could not be created or opened */
+		unsigned long long m_closeFailures; /*!< Number of files that could not be flushed or closed */
+		unsigned long long m_queueDepth; /*!< Number of records waiting for the writer thread, 0 without one */
+		unsigned long long m_maxQueueDepth; /*!< Largest number of records found waiting by the writer thread */
+		unsigned long long m_dropped; /*!< Number of submitted records lost because files could not be written */
+		durabilityStats m_durability; /*!< Statistics of the flushes to disk */
+		compressionStats m_compression; /*!< Statistics of the compression of complete files, its skipped files being dropped compressions */
+	};
+
+	/*! \struct splitterCounters
+	* \brief Counters updated while writing, from which splitterStats snapshots are taken
+	*
+	* Each counter has a single writing thread, the others only read it.
+	*
+	*/
+	struct splitterCounters
+	{
+		/*!
+		* @brief Constructor of the splitterCounters structure
+		*
+		* Set all counters to 0.
+		*
+		*/
+		splitterCounters();
+
+		/*!
+		* @brief Increase a counter from its writing thread
+		* @param counter : counter to increase
+		* @param value : value to add
+		*
+		* Plain load and store, without the cost of an atomic addition.
+		*
+		*/
+		static void add(std::atomic<unsigned long long>& counter, unsigned long long value)
+		{
+			counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+		}
+
+		/*!
+		* @brief Take a file change into account
+		* @param time : duration of the file change in microseconds
+		*
+		*/
+		void addRotation(unsigned long long time);
+
+		/*!
+		* @brief Copy counters into a snapshot
+		* @param stats : snapshot receiving the counters
+		*
+		* May be called from any thread. Counters are read one by one, so the snapshot may mix values of consecutive records.
+		* Constant function.
+		*
+		*/
+		void load(splitterStats& stats) const;
+
+		std::atomic<unsigned long long> m_bytes; /*!< Number of bytes written */
+		std::atomic<unsigned long long> m_records; /*!< Number of records written */
+		std::atomic<unsigned long long> m_rotations; /*!< Number of file changes */
+		std::atomic<unsigned long long> m_rotationTime; /*!< Total time of file changes in microseconds */
+		std::atomic<unsigned long long> m_maxRotationTime; /*!< Longest file change in microseconds */
+		std::atomic<unsigned long long> m_rotationHistogram[SPLITTER_LATENCY_BUCKETS]; /*!< File changes per latency bucket */
+		std::atomic<unsigned long long> m_openFailures; /*!< Number of open failures */
+		std::atomic<unsigned long long> m_closeFailures; /*!< Number of close failures, updated by the thread closing files */
+	};
+
+	/*!
+	* @brief Add statistics of a splitter to a total
+	* @param total : statistics receiving the sum, maxima being kept
+	* @param stats : statistics to add
+	*
+	*/
+	void mergeStats(splitterStats& total, splitterStats const& stats);
+
+	/*!
+	* @brief Format statistics in the Prometheus text exposition format
+	* @param splitters : statistics of each splitter with the value of its "splitter" label
+	* @return Text with one line per metric and splitter, metrics being named dwf_splitter_*
+	*
+	*/
+	std::string formatStats(std::vector<std::pair<std::string, splitterStats> > const& splitters);
+
+	/*!
+	* @brief Write text in a file read by a scraper
+	* @param fileName : name of the file, for example a .prom file of a node exporter text file collector
+	* @param text : content of the file, for example given by formatStats
+	* @return EXEC_SUCCESS if file could be written and EXEC_FAILURE otherwise
+	*
+	* Text is written in fileName.tmp then renamed, so that a reader never finds a partial file.
+	*
+	*/
+	int exportStats(std::string const& fileName, std::string const& text);
+}
+
+#endif
+
+//  ______________________________
+// |                              |
+// |    ______________________    |       
+// |   |                      |   |
+// |   |         sign         |   |
+// |   |        coding        |   |
+// |   |        dw@rf         |   |
+// |   |         1.0          |   |
+// |   |______________________|   |
+// |                              |
+// |______________________________|
+//               |  |           
+//               |  |             
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |__|
@@ -0,0 +1,202 @@
+/*!
+ * @file treeFingerprint.h
+ * @brief Class used to know if the content of a directory tree changed
+ * @author Sign Coding Dwarf
+ * @version 1.0
+ * @date 19 October 2026
+ *
+ * Definition of the class computing a digest of a directory tree from the names of its entries and the xxHash64 of its files.
+ * The tree is walked and files are hashed with several threads. Hashes are kept in a cache file so that files whose size and modification time did not change are not read again. <br>
+ * To test if it is available with your library version use <br>
+ * \a \#if \a DWFUTILS_VERSION_NUMERIC>=111580308
+ *
+ */
+
+/*
+Copyright 2016 SignCodingDwarf
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+
+#ifndef TREEFINGERPRINT
+#define TREEFINGERPRINT
+
+#include <string>
+#include <stdint.h>
+
+#include "common_defines.h"
+
+/*!
+* @def FINGERPRINT_READ_SIZE
+* @brief Size of the buffer of each thread reading files
+*/
+#ifndef FINGERPRINT_READ_SIZE
+#define FINGERPRINT_READ_SIZE (1 << 18)
+#endif
+
+/*!
+* @def FINGERPRINT_RACY_DELAY
+* @brief Files modified less than this number of seconds before the fingerprint started are not cached
+*
+* Such a file could be modified again without changing its modification time, which has a limited precision on some file systems.
+*
+*/
+#ifndef FINGERPRINT_RACY_DELAY
+#define FINGERPRINT_RACY_DELAY 2
+#endif
+
+/*!
+* @namespace dwf_utils
+* @brief A namespace used to regroup all utilitary functions or classes spanning through multiple applications
+*/
+namespace dwf_utils
+{
+	/*! \struct fingerprintOptions
+	* \brief Optional behaviours of a treeFingerprint
+	*/
+	struct fingerprintOptions
+	{
+		/*!
+		* @brief Constructor of the fingerprintOptions structure
+		*
+		* Set default behaviours : one thread per core and no cache.
+		*
+		*/
+		fingerprintOptions() : m_threadNb(0), m_cacheFile()
+		{
+		}
+
+		unsigned int m_threadNb; /*!< Number of threads walking the tree and hashing files. 0 for one per core */
+		std::string m_cacheFile; /*!< File keeping the hash of each file between runs, empty for no cache */
+	};
+
+	/*! \class treeFingerprint
+	* \brief Class computing a digest of a directory tree
+	*
+	* The digest depends on the relative path and type of every entry, the size and content of regular files and the target of symbolic links, which are not followed.
+	* It does not depend on modification times, permissions or on the location of the tree, so a copy of a tree has the same digest.
+	* The cache holds, for each file, its relative path, size, modification time and hash. A file whose size and modification time match its cache entry is not read.
+	*
+	*/
+	class treeFingerprint
+	{
+	public:
+		/*!
+		* @brief Constructor of the treeFingerprint class
+		* @param options : optional behaviours
+		*
+		*/
+		treeFingerprint(fingerprintOptions const& options = fingerprintOptions());
+
+		/*!
+		* @brief Destructor of the treeFingerprint class
+		*
+		* Destructor of the treeFingerprint class. Currently does nothing.
+		* Virtual function.
+		*
+		*/
+		virtual ~treeFingerprint();
+
+		/*!
+		* @brief Compute the digest of a tree
+		* @param root : path of the directory
+		* @param digest : receives the digest
+		* @return EXEC_SUCCESS if every entry could be read and EXEC_FAILURE otherwise
+		*
+		* The cache is read before and written after, a cache made for another root being ignored.
+		* A digest is given even on failure, entries which could not be read counting with a null hash.
+		*
+		*/
+		int compute(std::string const& root, uint64_t& digest);
+
+		/*!
+		* @brief Get number of entries of the last tree
+		* @return Number of entries, directories included
+		*
+		* Constant function.
+		*
+		*/
+		unsigned long long getEntryNb() const;
+
+		/*!
+		* @brief Get number of files read by the last computation
+		* @return Number of files hashed
+		*
+		* Constant function.
+		*
+		*/
+		unsigned long long getHashedNb() const;
+
+		/*!
+		* @brief Get number of files found in cache by the last computation
+		* @return Number of files not read
+		*
+		* Constant function.
+		*
+		*/
+		unsigned long long getCachedNb() const;
+
+		/*!
+		* @brief Get number of bytes read by the last computation
+		* @return Number of bytes hashed
+		*
+		* Constant function.
+		*
+		*/
+		unsigned long long getHashedBytes() const;
+
+		/*!
+		* @brief Get number of errors of the last computation
+		* @return Number of directories, files or links which could not be read
+		*
+		* Constant function.
+		*
+		*/
+		unsigned long long getErrorNb() const;
+
+	protected:
+		fingerprintOptions m_options; /*!< Optional behaviours */
+		unsigned long long m_entryNb; /*!< Number of entries of the last tree */
+		unsigned long long m_hashedNb; /*!< Number of files read by the last computation */
+		unsigned long long m_cachedNb; /*!< Number of files found in cache by the last computation */
+		unsigned long long m_hashedBytes; /*!< Number of bytes read by the last computation */
+		unsigned long long m_errorNb; /*!< Number of errors of the last computation */
+	};
+}
+
+#endif
+
+//  ______________________________
+// |                              |
+// |    ______________________    |       
+// |   |                      |   |
+// |   |         sign         |   |
+// |   |        coding        |   |
+// |   |        dw@rf         |   |
+// |   |         1.0          |   |
+// |   |______________________|   |
+// |                              |
+// |______________________________|
+//               |  |           
+//               |  |             
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |__|
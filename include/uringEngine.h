@@ -0,0 +1,249 @@
+/*!
+ * @file uringEngine.h
+ * @brief Class used to write the buffers of split files with io_uring
+ * @author Sign Coding Dwarf
+ * @version 1.0
+ * @date 19 October 2026
+ *
+ * Definition of the write engine keeping several buffers in flight with the Linux io_uring interface.
+ * Buffers are registered in the kernel and writes are submitted by batches so that a single thread can keep a fast disk busy. <br>
+ * To test if it is available with your library version use <br>
+ * \a \#if \a DWFUTILS_VERSION_NUMERIC>=111580308
+ *
+ */
+
+/*
+Copyright 2016 SignCodingDwarf
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+
+#ifndef URINGENGINE
+#define URINGENGINE
+
+#include <vector>
+
+#include "common_defines.h"
+#include "writeEngine.h"
+
+/*!
+* @def URING_QUEUE_DEPTH
+* @brief Number of buffers the uringEngine may keep in flight
+*/
+#ifndef URING_QUEUE_DEPTH
+#define URING_QUEUE_DEPTH 8
+#endif
+
+/*!
+* @def URING_BUFFER_SIZE
+* @brief Default size of each uringEngine buffer in bytes
+*/
+#ifndef URING_BUFFER_SIZE
+#define URING_BUFFER_SIZE (1 << 18)
+#endif
+
+/*!
+* @def URING_SUBMIT_BATCH
+* @brief Number of committed buffers grouped in a single submission system call
+*/
+#ifndef URING_SUBMIT_BATCH
+#define URING_SUBMIT_BATCH 4
+#endif
+
+/*!
+* @namespace dwf_utils
+* @brief A namespace used to regroup all utilitary functions or classes spanning through multiple applications
+*/
+namespace dwf_utils
+{
+	/*! \class uringEngine
+	* \brief Engine writing several buffers asynchronously with io_uring
+	*
+	* Committed buffers are queued as fixed buffer writes and submitted by batches of URING_SUBMIT_BATCH. When no buffer is free, the engine submits pending writes and waits for the first completion.
+	* After a failed write, pending writes are still waited for before the file is detached. If the ring itself fails, it is set up again.
+	* Instances must be created with the create function, which fails on kernels without io_uring.
+	*
+	*/
+	class uringEngine : public writeEngine
+	{
+	public:
+		/*!
+		* @brief Create a uringEngine
+		* @param bufferSize : size of each buffer in bytes
+		* @param depth : number of buffers. Default is URING_QUEUE_DEPTH.
+		* @return The created engine or NULL if io_uring cannot be used
+		*
+		*/
+		static uringEngine* create(size_t bufferSize, unsigned int depth = URING_QUEUE_DEPTH);
+
+		/*!
+		* @brief Destructor of the uringEngine class
+		*
+		* Destructor of the uringEngine class. Waits for pending writes and releases the ring.
+		* Virtual function.
+		*
+		*/
+		virtual ~uringEngine();
+
+		/*!
+		* @brief Stop writing in the current file
+		* @return EXEC_SUCCESS if all data could be written and EXEC_FAILURE otherwise
+		*
+		* Virtual function.
+		*
+		*/
+		virtual int detach();
+
+		/*!
+		* @brief Get the buffer to fill
+		* @param size : receives the capacity of the buffer in bytes
+		* @return Pointer to a free buffer
+		*
+		* Waits for a write completion if every buffer is in flight.
+		* Virtual function.
+		*
+		*/
+		virtual char* getBuffer(size_t& size);
+
+		/*!
+		* @brief Queue the filled buffer for writing
+		* @param size : number of bytes filled at the beginning of the buffer
+		* @return EXEC_SUCCESS if write could be queued and EXEC_FAILURE if a previous write failed
+		*
+		* Virtual function.
+		*
+		*/
+		virtual int commit(size_t size);
+
+		/*!
+		* @brief Wait for pending writes
+		* @return EXEC_SUCCESS if all data could be written and EXEC_FAILURE otherwise
+		*
+		* Virtual function.
+		*
+		*/
+		virtual int drain();
+
+		/*!
+		* @brief Get number of bytes already in the file
+		* @return Offset of the first buffer not completely written
+		*
+		* Constant and virtual function.
+		*
+		*/
+		virtual unsigned long long getWritten() const;
+
+	protected:
+		/*!
+		* @brief Constructor of the uringEngine class
+		* @param bufferSize : size of each buffer in bytes
+		* @param depth : number of buffers
+		*
+		* Protected function. Use create.
+		*
+		*/
+		uringEngine(size_t bufferSize, unsigned int depth);
+
+		/*!
+		* @brief Allocate buffers if needed, set up ring and register buffers
+		* @return EXEC_SUCCESS if io_uring could be set up and EXEC_FAILURE otherwise
+		*
+		*/
+		int setUp();
+
+		/*!
+		* @brief Release the ring
+		*
+		* Buffers are kept.
+		*
+		*/
+		void tearDown();
+
+		/*!
+		* @brief Release the ring and set it up again
+		*
+		* Used when the ring itself fails : submitted and queued writes are dropped and every buffer is free again.
+		*
+		*/
+		void reset();
+
+		/*!
+		* @brief Submit queued writes and optionally wait for completions
+		* @param waitNb : number of completions to wait for
+		* @return EXEC_SUCCESS on success and EXEC_FAILURE otherwise
+		*
+		*/
+		int submit(unsigned int waitNb);
+
+		/*!
+		* @brief Process available completions
+		*
+		* Frees the buffers of completed writes. Short writes are completed synchronously.
+		*
+		*/
+		void reap();
+
+		int m_ring; /*!< Descriptor of the ring */
+		unsigned int m_depth; /*!< Number of buffers */
+		size_t m_bufferSize; /*!< Size of each buffer */
+		char* m_memory; /*!< Memory of all buffers */
+		std::vector<unsigned int> m_free; /*!< Indexes of free buffers */
+		std::vector<unsigned long long> m_bufferOffset; /*!< File offset of each in flight buffer */
+		std::vector<size_t> m_bufferLength; /*!< Length of each in flight buffer */
+		int m_current; /*!< Index of buffer being filled, -1 if none */
+		unsigned int m_queued; /*!< Number of writes queued but not submitted */
+		unsigned int m_inFlight; /*!< Number of submitted writes not completed */
+		bool m_failed; /*!< A write failed since the file was attached */
+
+		void* m_sqRing; /*!< Mapping of submission ring */
+		size_t m_sqRingSize; /*!< Size of submission ring mapping */
+		void* m_cqRing; /*!< Mapping of completion ring */
+		size_t m_cqRingSize; /*!< Size of completion ring mapping */
+		void* m_sqes; /*!< Mapping of submission entries */
+		size_t m_sqesSize; /*!< Size of submission entries mapping */
+		unsigned int* m_sqTail; /*!< Tail of submission ring */
+		unsigned int* m_sqMask; /*!< Mask of submission ring */
+		unsigned int* m_sqArray; /*!< Index array of submission ring */
+		unsigned int* m_cqHead; /*!< Head of completion ring */
+		unsigned int* m_cqTail; /*!< Tail of completion ring */
+		unsigned int* m_cqMask; /*!< Mask of completion ring */
+		void* m_cqes; /*!< Completion entries */
+	};
+}
+
+#endif
+
+//  ______________________________
+// |                              |
+// |    ______________________    |       
+// |   |                      |   |
+// |   |         sign         |   |
+// |   |        coding        |   |
+// |   |        dw@rf         |   |
+// |   |         1.0          |   |
+// |   |______________________|   |
+// |                              |
+// |______________________________|
+//               |  |           
+//               |  |             
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |__|
@@ -0,0 +1,148 @@
+/*!
+ * @file workerThread.h
+ * @brief Class used to run tasks in a background thread
+ * @author Sign Coding Dwarf
+ * @version 1.0
+ * @date 19 October 2026
+ *
+ * Definition of the class used to run tasks in a background thread in the order they were posted.
+ * Used to move slow operations such as file opening or closing out of the writing thread. <br>
+ * To test if it is available with your library version use <br>
+ * \a \#if \a DWFUTILS_VERSION_NUMERIC>=111580308
+ *
+ */
+
+/*
+Copyright 2016 SignCodingDwarf
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+
+#ifndef WORKERTHREAD
+#define WORKERTHREAD
+
+#include <deque>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "common_defines.h"
+
+/*!
+* @namespace dwf_utils
+* @brief A namespace used to regroup all utilitary functions or classes spanning through multiple applications
+*/
+namespace dwf_utils
+{
+	/*! \class workerThread
+	* \brief Class running tasks in a background thread
+	*
+	* Class owning a thread that runs posted tasks one after the other, in the order they were posted.
+	*
+	*/
+	class workerThread
+	{
+	public:
+		/*!
+		* @brief Constructor of the workerThread class
+		*
+		* Constructor of the workerThread class. Starts the thread.
+		*
+		*/
+		workerThread();
+
+		/*!
+		* @brief Destructor of the workerThread class
+		*
+		* Destructor of the workerThread class. Runs all remaining tasks then stops the thread.
+		* Virtual function.
+		*
+		*/
+		virtual ~workerThread();
+
+		/*!
+		* @brief Post a task
+		* @param task : function to run in the background thread
+		*
+		* Add a task at the end of the task list. Never waits for the task to be run.
+		*
+		*/
+		void post(std::function<void()> task);
+
+		/*!
+		* @brief Wait for posted tasks
+		*
+		* Wait until all the tasks posted before this call are done.
+		*
+		*/
+		void wait();
+
+		/*!
+		* @brief Get number of tasks waiting to be run
+		* @return Number of posted tasks not done yet
+		*
+		* Constant function.
+		*
+		*/
+		size_t getPending() const;
+
+	protected:
+		/*!
+		* @brief Thread loop
+		*
+		* Runs tasks until the class is destroyed.
+		*
+		*/
+		void run();
+
+		std::deque<std::function<void()> > m_tasks; /*!< Tasks waiting to be run */
+		size_t m_running; /*!< Number of tasks being run (0 or 1) */
+		bool m_stop; /*!< Thread stop request */
+		mutable std::mutex m_mutex; /*!< Mutex protecting task list */
+		std::condition_variable m_posted; /*!< Wakes thread up when a task is posted */
+		std::condition_variable m_done; /*!< Wakes waiters up when tasks are done */
+		std::thread m_thread; /*!< Background thread */
+
+	private:
+		workerThread(workerThread const&); // Not copyable
+		workerThread& operator=(workerThread const&);
+	};
+}
+
+#endif
+
+//  ______________________________
+// |                              |
+// |    ______________________    |       
+// |   |                      |   |
+// |   |         sign         |   |
+// |   |        coding        |   |
+// |   |        dw@rf         |   |
+// |   |         1.0          |   |
+// |   |______________________|   |
+// |                              |
+// |______________________________|
+//               |  |           
+//               |  |             
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |__|
@@ -0,0 +1,343 @@
+/*!
+ * @file writeEngine.h
+ * @brief Classes used to write the buffers of split files to the system
+ * @author Sign Coding Dwarf
+ * @version 1.0
+ * @date 19 October 2026
+ *
+ * Definition of the interface of the engines used by segmentBuf to write its buffers into a file and of the default engine based on pwrite.
+ * Engines provide the buffers filled by segmentBuf so that they can keep several of them in flight. <br>
+ * To test if it is available with your library version use <br>
+ * \a \#if \a DWFUTILS_VERSION_NUMERIC>=111580308
+ *
+ */
+
+/*
+Copyright 2016 SignCodingDwarf
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+
+#ifndef WRITEENGINE
+#define WRITEENGINE
+
+#include <cstddef>
+#include <vector>
+#include <memory>
+
+#include "common_defines.h"
+
+/*!
+* @namespace dwf_utils
+* @brief A namespace used to regroup all utilitary functions or classes spanning through multiple applications
+*/
+namespace dwf_utils
+{
+	/*!
+	* @enum writerMode
+	* @brief Engine used to write files
+	*/
+	enum writerMode
+	{
+		WRITER_BUFFERED, /*!< One buffer written with pwrite when full */
+		WRITER_URING, /*!< Several buffers written asynchronously with io_uring. Falls back to WRITER_BUFFERED if the kernel does not support it */
+		WRITER_MMAP, /*!< Data copied in a shared mapping of the file reserved in advance, without system call per buffer */
+		WRITER_DIRECT /*!< Aligned blocks written with O_DIRECT, bypassing the page cache */
+	};
+
+	/*! \class writeEngine
+	* \brief Interface of the engines writing buffers into a file
+	*
+	* A writeEngine provides a buffer through getBuffer. Once filled, the buffer is given back with commit and written at the current offset of the file. The engine may then provide another buffer while the previous one is still being written.
+	*
+	*/
+	class writeEngine
+	{
+	public:
+		/*!
+		* @brief Constructor of the writeEngine class
+		*
+		*/
+		writeEngine();
+
+		/*!
+		* @brief Destructor of the writeEngine class
+		*
+		* Virtual function.
+		*
+		*/
+		virtual ~writeEngine();
+
+		/*!
+		* @brief Get access mode and flags required to open files
+		* @return Flags to add to the open call. Default is O_WRONLY
+		*
+		* Constant and virtual function.
+		*
+		*/
+		virtual int openFlags() const;
+
+		/*!
+		* @brief Start writing in a file
+		* @param fd : descriptor of the file opened for writing. Writing starts at offset 0.
+		* @return EXEC_SUCCESS if file could be used and EXEC_FAILURE otherwise
+		*
+		* The engine does not own the descriptor.
+		* Virtual function.
+		*
+		*/
+		virtual int attach(int fd);
+
+		/*!
+		* @brief Stop writing in the current file
+		* @return EXEC_SUCCESS if all data could be written and EXEC_FAILURE otherwise
+		*
+		* Wait for pending writes and release the file. The descriptor is not closed.
+		* Virtual function.
+		*
+		*/
+		virtual int detach();
+
+		/*!
+		* @brief Get the buffer to fill
+		* @param size : receives the capacity of the buffer in bytes
+		* @return Pointer to the buffer
+		*
+		* The same buffer is returned until commit is called.
+		* Pure virtual function.
+		*
+		*/
+		virtual char* getBuffer(size_t& size) = 0;
+
+		/*!
+		* @brief Write the filled buffer
+		* @param size : number of bytes filled at the beginning of the buffer
+		* @return EXEC_SUCCESS if writing could be done or started and EXEC_FAILURE otherwise
+		*
+		* The buffer must not be used anymore after this call.
+		* Pure virtual function.
+		*
+		*/
+		virtual int commit(size_t size) = 0;
+
+		/*!
+		* @brief Write data not located in the engine buffers
+		* @param data : data to write
+		* @param size : number of bytes to write
+		* @return EXEC_SUCCESS if writing could be done and EXEC_FAILURE otherwise
+		*
+		* Default implementation copies data through the engine buffers. Buffer obtained with getBuffer must have been committed first.
+		* Virtual function.
+		*
+		*/
+		virtual int write(const char* data, size_t size);
+
+		/*!
+		* @brief Write the filled buffer followed by data not located in the engine buffers
+		* @param size : number of bytes filled at the beginning of the buffer, may be 0
+		* @param data : data to write after the buffer
+		* @param dataSize : number of bytes of data
+		* @return EXEC_SUCCESS if writing could be done and EXEC_FAILURE otherwise
+		*
+		* Default implementation calls commit then write. The buffer must not be used anymore after this call.
+		* Virtual function.
+		*
+		*/
+		virtual int commitWith(size_t size, const char* data, size_t dataSize);
+
+		/*!
+		* @brief Move data from a descriptor to the file
+		* @param source : descriptor of a pipe, socket or file to read from its current position
+		* @param size : maximal number of bytes to move
+		* @return Number of bytes moved, 0 at the end of source data and -1 on failure with errno set
+		*
+		* Default implementation reads source directly into the engine buffer then commits it. Buffer obtained with getBuffer must have been committed first.
+		* Virtual function.
+		*
+		*/
+		virtual long long transferFrom(int source, size_t size);
+
+		/*!
+		* @brief Wait for pending writes
+		* @return EXEC_SUCCESS if all data could be written and EXEC_FAILURE otherwise
+		*
+		* Virtual function.
+		*
+		*/
+		virtual int drain();
+
+		/*!
+		* @brief Get number of bytes given to the engine for the current file
+		* @return Offset at which next data will be written
+		*
+		* Constant function.
+		*
+		*/
+		unsigned long long getOffset() const;
+
+		/*!
+		* @brief Get number of bytes already in the file
+		* @return Length of the beginning of the file for which writing is complete
+		*
+		* Default implementation returns getOffset().
+		* Constant and virtual function.
+		*
+		*/
+		virtual unsigned long long getWritten() const;
+
+	protected:
+		/*!
+		* @brief Write a block of data at a given offset
+		* @param fd : descriptor of the file
+		* @param data : data to write
+		* @param size : number of bytes to write
+		* @param offset : offset in file
+		* @return EXEC_SUCCESS if every byte could be written and EXEC_FAILURE otherwise
+		*
+		* Write data with pwrite, handling interruptions and partial writes.
+		*
+		*/
+		static int writeAt(int fd, const char* data, size_t size, unsigned long long offset);
+
+		int m_fd; /*!< Descriptor of the current file, -1 if none */
+		unsigned long long m_offset; /*!< Offset of the next write in current file */
+
+	private:
+		writeEngine(writeEngine const&); // Not copyable
+		writeEngine& operator=(writeEngine const&);
+	};
+
+	/*! \class pwriteEngine
+	* \brief Engine writing a single buffer with pwrite
+	*
+	* Default engine. The buffer is written synchronously when committed. Data given to write is written directly without copy.
+	*
+	*/
+	class pwriteEngine : public writeEngine
+	{
+	public:
+		/*!
+		* @brief Constructor of the pwriteEngine class
+		* @param bufferSize : size of the buffer in bytes
+		*
+		*/
+		explicit pwriteEngine(size_t bufferSize);
+
+		/*!
+		* @brief Destructor of the pwriteEngine class
+		*
+		* Virtual function.
+		*
+		*/
+		virtual ~pwriteEngine();
+
+		/*!
+		* @brief Get the buffer to fill
+		* @param size : receives the capacity of the buffer in bytes
+		* @return Pointer to the buffer
+		*
+		* Virtual function.
+		*
+		*/
+		virtual char* getBuffer(size_t& size);
+
+		/*!
+		* @brief Write the filled buffer
+		* @param size : number of bytes filled at the beginning of the buffer
+		* @return EXEC_SUCCESS if writing could be done and EXEC_FAILURE otherwise
+		*
+		* Virtual function.
+		*
+		*/
+		virtual int commit(size_t size);
+
+		/*!
+		* @brief Write data not located in the engine buffer
+		* @param data : data to write
+		* @param size : number of bytes to write
+		* @return EXEC_SUCCESS if writing could be done and EXEC_FAILURE otherwise
+		*
+		* Data is written directly, without copy.
+		* Virtual function.
+		*
+		*/
+		virtual int write(const char* data, size_t size);
+
+		/*!
+		* @brief Write the filled buffer followed by data not located in the engine buffer
+		* @param size : number of bytes filled at the beginning of the buffer, may be 0
+		* @param data : data to write after the buffer
+		* @param dataSize : number of bytes of data
+		* @return EXEC_SUCCESS if writing could be done and EXEC_FAILURE otherwise
+		*
+		* Both are written with a single pwritev call, without copy.
+		* Virtual function.
+		*
+		*/
+		virtual int commitWith(size_t size, const char* data, size_t dataSize);
+
+		/*!
+		* @brief Move data from a descriptor to the file without copy through user space
+		* @param source : descriptor of a pipe, socket or file to read from its current position
+		* @param size : maximal number of bytes to move
+		* @return Number of bytes moved, 0 at the end of source data and -1 on failure with errno set
+		*
+		* Pipes are spliced to the file, files are copied with copy_file_range (sendfile if not supported) and other descriptors such as sockets are spliced through an internal pipe.
+		* If the internal pipe cannot be emptied into the file, the pipe is dropped with the remaining bytes, the number of bytes written is returned and the error is reported by the next call.
+		* Virtual function.
+		*
+		*/
+		virtual long long transferFrom(int source, size_t size);
+
+	protected:
+		std::vector<char> m_buffer; /*!< Buffer to fill */
+		int m_pipe[2]; /*!< Pipe relaying sockets to the file, created when first needed */
+		int m_pipeError; /*!< Error of a transfer which returned a short count, 0 if none */
+	};
+
+	/*!
+	* @brief Create a write engine
+	* @param mode : kind of engine to create
+	* @param bufferSize : size of the engine buffers in bytes, or of the mapping steps with WRITER_MMAP
+	* @return The created engine. Engines unsupported by the system are replaced by a pwriteEngine.
+	*
+	*/
+	std::unique_ptr<writeEngine> createWriteEngine(writerMode mode, size_t bufferSize);
+}
+
+#endif
+
+//  ______________________________
+// |                              |
+// |    ______________________    |       
+// |   |                      |   |
+// |   |         sign         |   |
+// |   |        coding        |   |
+// |   |        dw@rf         |   |
+// |   |         1.0          |   |
+// |   |______________________|   |
+// |                              |
+// |______________________________|
+//               |  |           
+//               |  |             
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |__|
@@ -0,0 +1,130 @@
+/*!
+ * @file xxHash.h
+ * @brief Functions used to hash data with the xxHash64 algorithm
+ * @author Sign Coding Dwarf
+ * @version 1.0
+ * @date 19 October 2026
+ *
+ * Definition of the 64 bits xxHash non cryptographic hash, giving the same values as the reference implementation.
+ * Data can be hashed at once or in several parts, for example while reading a file. <br>
+ * To test if it is available with your library version use <br>
+ * \a \#if \a DWFUTILS_VERSION_NUMERIC>=111580308
+ *
+ */
+
+/*
+Copyright 2016 SignCodingDwarf
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+
+#ifndef XXHASH
+#define XXHASH
+
+#include <cstddef>
+#include <stdint.h>
+
+#include "common_defines.h"
+
+/*!
+* @namespace dwf_utils
+* @brief A namespace used to regroup all utilitary functions or classes spanning through multiple applications
+*/
+namespace dwf_utils
+{
+	/*!
+	* @brief Hash data
+	* @param data : data to hash
+	* @param size : number of bytes
+	* @param seed : seed of the hash
+	* @return xxHash64 of the data
+	*
+	*/
+	uint64_t xxHash64(const void* data, size_t size, uint64_t seed = 0);
+
+	/*! \class xxHash64State
+	* \brief State of a xxHash64 computed in several parts
+	*
+	* Giving the data in any number of parts gives the same hash as xxHash64 on the whole data.
+	*
+	*/
+	class xxHash64State
+	{
+	public:
+		/*!
+		* @brief Constructor of the xxHash64State class
+		* @param seed : seed of the hash
+		*
+		*/
+		xxHash64State(uint64_t seed = 0);
+
+		/*!
+		* @brief Start a new hash
+		* @param seed : seed of the hash
+		*
+		*/
+		void reset(uint64_t seed = 0);
+
+		/*!
+		* @brief Add data
+		* @param data : data to hash
+		* @param size : number of bytes
+		*
+		*/
+		void update(const void* data, size_t size);
+
+		/*!
+		* @brief Get hash of the data given until now
+		* @return xxHash64 of the data
+		*
+		* More data may be added afterwards.
+		* Constant function.
+		*
+		*/
+		uint64_t digest() const;
+
+	protected:
+		uint64_t m_seed; /*!< Seed of the hash */
+		uint64_t m_accumulators[4]; /*!< Accumulators of the 32 bytes stripes */
+		unsigned char m_stripe[32]; /*!< Bytes of the incomplete stripe */
+		size_t m_stripeSize; /*!< Number of bytes in m_stripe */
+		unsigned long long m_totalSize; /*!< Number of bytes given */
+	};
+}
+
+#endif
+
+//  ______________________________
+// |                              |
+// |    ______________________    |       
+// |   |                      |   |
+// |   |         sign         |   |
+// |   |        coding        |   |
+// |   |        dw@rf         |   |
+// |   |         1.0          |   |
+// |   |______________________|   |
+// |                              |
+// |______________________________|
+//               |  |           
+//               |  |             
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |__|
@@ -0,0 +1,456 @@
+/*!
+ * @file binaryLogger.cpp
+ * @brief Class used to log records in split files with deferred formatting
+ * @author Sign Coding Dwarf
+ * @version 1.0
+ * @date 19 October 2026
+ *
+ * Implementation of the logger copying raw arguments and a format id into a buffer owned by the calling thread.
+ * The background thread polls the thread buffers and formats or copies their records into a fileSplitter.
+ *
+ */
+
+/*
+Copyright 2016 SignCodingDwarf
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "binaryLogger.h"
+#include <deque>
+#include <fstream>
+#include <chrono>
+#include <limits>
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace dwf_utils
+{
+	/*!
+	* @brief Get the registered formats
+	* @return Formats indexed by id
+	*
+	* Function local so that formats may be registered during static initialization. Elements are never moved.
+	*
+	*/
+	static std::deque<std::string>& formatRegistry()
+	{
+		static std::deque<std::string> formats;
+		return formats;
+	}
+
+	/*!
+	* @brief Get the mutex protecting the registered formats
+	* @return Mutex of the registry
+	*
+	*/
+	static std::mutex& formatMutex()
+	{
+		static std::mutex mutex;
+		return mutex;
+	}
+
+	/*!
+	* @brief Get the size of thread buffers
+	* @param size : requested size in bytes
+	* @return Smallest power of two at least equal to size and to BINARYLOGGER_MIN_BUFFER_SIZE
+	*
+	* Positions in the ring are masked, so its size must be a power of two.
+	*
+	*/
+	static size_t ringSize(size_t size)
+	{
+		size_t ring = BINARYLOGGER_MIN_BUFFER_SIZE;
+		while(ring < size && ring <= std::numeric_limits<size_t>::max() / 2)
+		{
+			ring *= 2;
+		}
+		return ring;
+	}
+
+	static std::atomic<unsigned long long> s_loggerNb(0); /*!< Number of binaryLogger created, gives their unique id */
+
+	unsigned int registerFormat(std::string const& format)
+	{
+		std::lock_guard<std::mutex> lock(formatMutex());
+		formatRegistry().push_back(format);
+		return static_cast<unsigned int>(formatRegistry().size() - 1);
+	}
+
+	int getFormat(unsigned int id, std::string& format)
+	{
+		std::lock_guard<std::mutex> lock(formatMutex());
+		if(id >= formatRegistry().size())
+		{
+			return EXEC_FAILURE;
+		}
+		format = formatRegistry()[id];
+		return EXEC_SUCCESS;
+	}
+
+	std::string formatsName(std::string const& baseName)
+	{
+		return baseName + ".formats";
+	}
+
+	/*!
+	* @brief Format an argument
+	* @param args : position of the tag of the argument
+	* @param end : end of the arguments
+	* @param text : string to which the argument is appended
+	* @return Position of the next argument or NULL if argument is invalid
+	*
+	*/
+	static const char* formatArg(const char* args, const char* end, std::string& text)
+	{
+		char buffer[32];
+		char tag = *args++;
+		switch(tag)
+		{
+		case BINARG_INT:
+		case BINARG_UINT:
+		case BINARG_DOUBLE:
+			if(end - args < 8)
+			{
+				return NULL;
+			}
+			if(tag == BINARG_INT)
+			{
+				long long value;
+				memcpy(&value, args, sizeof(value));
+				snprintf(buffer, sizeof(buffer), "%lld", value);
+			}
+			else if(tag == BINARG_UINT)
+			{
+				unsigned long long value;
+				memcpy(&value, args, sizeof(value));
+				snprintf(buffer, sizeof(buffer), "%llu", value);
+			}
+			else
+			{
+				double value;
+				memcpy(&value, args, sizeof(value));
+				snprintf(buffer, sizeof(buffer), "%g", value); // Default ostream formatting
+			}
+			text += buffer;
+			return args + 8;
+		case BINARG_CHAR:
+		case BINARG_BOOL:
+			if(end - args < 1)
+			{
+				return NULL;
+			}
+			tag == BINARG_CHAR ? text.push_back(*args) : text.push_back(*args ? '1' : '0'); // ostream writes booleans as numbers by default
+			return args + 1;
+		case BINARG_STRING:
+		{
+			uint32_t length;
+			if(end - args < static_cast<long>(sizeof(length)))
+			{
+				return NULL;
+			}
+			memcpy(&length, args, sizeof(length));
+			args += sizeof(length);
+			if(static_cast<size_t>(end - args) < length)
+			{
+				return NULL;
+			}
+			text.append(args, length);
+			return args + length;
+		}
+		default:
+			return NULL;
+		}
+	}
+
+	int formatBinaryRecord(std::string const& format, const char* args, size_t size, std::string& text)
+	{
+		const char* end = args + size;
+		for(size_t i = 0; i < format.size(); ++i)
+		{
+			if(format[i] == '{' && i + 1 < format.size() && format[i + 1] == '}')
+			{
+				++i;
+				if(args == end || *args == BINARG_END) // Missing argument
+				{
+					text += "{}";
+					continue;
+				}
+				args = formatArg(args, end, text);
+				if(args == NULL)
+				{
+					return EXEC_FAILURE;
+				}
+				continue;
+			}
+			text.push_back(format[i]);
+		}
+		return EXEC_SUCCESS;
+	}
+
+	int decodeBinaryLog(std::string const& formatsFile, std::vector<std::string> const& files, std::ostream& out)
+	{
+		std::map<unsigned int, std::string> formats;
+		std::ifstream formatsIn(formatsFile.c_str(), std::ios::binary);
+		if(!formatsIn)
+		{
+			return EXEC_FAILURE;
+		}
+		uint32_t definition[2]; // Id and length
+		while(formatsIn.read(reinterpret_cast<char*>(definition), sizeof(definition)))
+		{
+			std::string format(definition[1], '\0');
+			if(!formatsIn.read(&format[0], definition[1]))
+			{
+				return EXEC_FAILURE;
+			}
+			formats[definition[0]] = format;
+		}
+
+		std::string text;
+		for(size_t f = 0; f < files.size(); ++f)
+		{
+			std::ifstream in(files[f].c_str(), std::ios::binary);
+			if(!in)
+			{
+				return EXEC_FAILURE;
+			}
+			std::vector<char> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+			size_t position = 0;
+			while(position < data.size())
+			{
+				uint32_t header[2]; // Size and format id
+				if(data.size() - position < sizeof(header))
+				{
+					return EXEC_FAILURE;
+				}
+				memcpy(header, &data[position], sizeof(header));
+				std::map<unsigned int, std::string>::const_iterator format = formats.find(header[1]);
+				if(header[0] < sizeof(header) || header[0] > data.size() - position || format == formats.end())
+				{
+					return EXEC_FAILURE;
+				}
+				text.clear();
+				if(formatBinaryRecord(format->second, &data[position + sizeof(header)], header[0] - sizeof(header), text) == EXEC_FAILURE)
+				{
+					return EXEC_FAILURE;
+				}
+				out << text;
+				position += header[0];
+			}
+		}
+		return out ? EXEC_SUCCESS : EXEC_FAILURE;
+	}
+
+	binaryLogger::binaryLogger(std::string baseName, std::string extension, unsigned long fileSize, binaryLogMode mode, splitterOptions const& options, size_t bufferSize) : m_instance(++s_loggerNb), m_mode(mode), m_bufferSize(ringSize(bufferSize)), m_splitter(baseName, extension, fileSize, options), m_formatsFd(-1), m_formats(), m_formatWritten(), m_text(), m_buffers(), m_threads(), m_dropped(0), m_status(false), m_stop(false), m_flushRequest(0), m_flushDone(0)
+	{
+		if(m_mode == BINLOG_RAW)
+		{
+			m_formatsFd = ::open(formatsName(baseName).c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_APPEND | O_CLOEXEC, 0644);
+		}
+		m_status.store(m_splitter.getStatus() && (m_mode != BINLOG_RAW || m_formatsFd >= 0));
+		m_writer = std::thread(&binaryLogger::writerLoop, this); // Started last, once every member is ready
+	}
+
+	binaryLogger::~binaryLogger()
+	{
+		m_stop.store(true);
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_wakeUp.notify_one();
+		}
+		if(m_writer.joinable())
+		{
+			m_writer.join();
+		}
+		if(m_formatsFd >= 0)
+		{
+			::close(m_formatsFd);
+		}
+	}
+
+	void binaryLogger::flush()
+	{
+		unsigned long long request = m_flushRequest.fetch_add(1, std::memory_order_acq_rel) + 1; // Records logged before are published before the request
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_wakeUp.notify_one();
+		while(m_flushDone < request)
+		{
+			m_flushed.wait(lock);
+		}
+	}
+
+	bool binaryLogger::getStatus() const
+	{
+		return m_status.load();
+	}
+
+	unsigned long long binaryLogger::getDropped() const
+	{
+		return m_dropped.load(std::memory_order_relaxed);
+	}
+
+	unsigned long long binaryLogger::getWaits() const
+	{
+		std::lock_guard<std::mutex> lock(m_threadsMutex);
+		unsigned long long waits = 0;
+		for(size_t i = 0; i < m_buffers.size(); ++i)
+		{
+			waits += m_buffers[i]->m_waits.load(std::memory_order_relaxed);
+		}
+		return waits;
+	}
+
+	binaryLogger::threadBuffer* binaryLogger::attachThread()
+	{
+		std::lock_guard<std::mutex> lock(m_threadsMutex);
+		std::map<std::thread::id, threadBuffer*>::iterator found = m_threads.find(std::this_thread::get_id());
+		if(found != m_threads.end())
+		{
+			return found->second;
+		}
+		m_buffers.push_back(std::unique_ptr<threadBuffer>(new threadBuffer(m_bufferSize)));
+		m_threads[std::this_thread::get_id()] = m_buffers.back().get();
+		return m_buffers.back().get();
+	}
+
+	void binaryLogger::writerLoop()
+	{
+		while(true)
+		{
+			bool stop = m_stop.load();
+			unsigned long long request = m_flushRequest.load(std::memory_order_acquire); // Read before draining so that drained records include those of the request
+			bool written = drain();
+			if(request != m_flushDone)
+			{
+				m_splitter.flush();
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_flushDone = request;
+				m_flushed.notify_all();
+			}
+			m_status.store(m_splitter.getStatus());
+			if(stop)
+			{
+				break;
+			}
+			if(!written)
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				if(m_flushRequest.load() == m_flushDone && !m_stop.load())
+				{
+					m_wakeUp.wait_for(lock, std::chrono::microseconds(BINARYLOGGER_POLL_TIME)); // Logging threads never wake the thread up
+				}
+			}
+		}
+	}
+
+	bool binaryLogger::drain()
+	{
+		std::vector<threadBuffer*> buffers;
+		{
+			std::lock_guard<std::mutex> lock(m_threadsMutex);
+			for(size_t i = 0; i < m_buffers.size(); ++i)
+			{
+				buffers.push_back(m_buffers[i].get());
+			}
+		}
+
+		bool written = false;
+		for(size_t b = 0; b < buffers.size(); ++b)
+		{
+			threadBuffer& buffer = *buffers[b];
+			unsigned long long tail = buffer.m_tail.load(std::memory_order_relaxed);
+			unsigned long long head = buffer.m_head.load(std::memory_order_acquire);
+			while(tail != head)
+			{
+				size_t offset = tail & buffer.m_mask;
+				uint32_t size;
+				memcpy(&size, &buffer.m_data[offset], sizeof(size));
+				if(size == 0) // Wrap marker
+				{
+					tail += buffer.m_data.size() - offset;
+					continue;
+				}
+				writeRecord(&buffer.m_data[offset], size);
+				tail += size;
+				buffer.m_tail.store(tail, std::memory_order_release); // Room given back record by record
+				written = true;
+			}
+			buffer.m_tail.store(tail, std::memory_order_release);
+		}
+		return written;
+	}
+
+	void binaryLogger::writeRecord(const char* record, size_t size)
+	{
+		uint32_t id;
+		memcpy(&id, record + sizeof(uint32_t), sizeof(id));
+		if(id >= m_formats.size() || m_formats[id].empty())
+		{
+			m_formats.resize(id >= m_formats.size() ? id + 1 : m_formats.size());
+			m_formatWritten.resize(m_formats.size(), false);
+			getFormat(id, m_formats[id]); // Registry only locked for new formats
+		}
+
+		if(m_mode == BINLOG_TEXT)
+		{
+			m_text.clear();
+			formatBinaryRecord(m_formats[id], record + 2 * sizeof(uint32_t), size - 2 * sizeof(uint32_t), m_text);
+			m_splitter.write(m_text.data(), m_text.size());
+			return;
+		}
+
+		if(!m_formatWritten[id]) // Formats file only lists the formats used by this logger
+		{
+			std::string definition(2 * sizeof(uint32_t), '\0');
+			uint32_t header[2] = {id, static_cast<uint32_t>(m_formats[id].size())};
+			memcpy(&definition[0], header, sizeof(header));
+			definition += m_formats[id];
+			if(::write(m_formatsFd, definition.data(), definition.size()) != static_cast<ssize_t>(definition.size()))
+			{
+#if DEBUG
+				std::cerr << "Could not write format " << id << std::endl;
+#endif
+			}
+			m_formatWritten[id] = true;
+		}
+		m_splitter.beginRecord(); // Binary record is a valid split point
+		m_splitter.write(record, size);
+		m_splitter.commitRecord();
+	}
+}
+
+//  ______________________________
+// |                              |
+// |    ______________________    |       
+// |   |                      |   |
+// |   |         sign         |   |
+// |   |        coding        |   |
+// |   |        dw@rf         |   |
+// |   |         1.0          |   |
+// |   |______________________|   |
+// |                              |
+// |______________________________|
+//               |  |           
+//               |  |             
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |__|
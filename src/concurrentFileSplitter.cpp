@@ -0,0 +1,253 @@
+/*!
+ * @file concurrentFileSplitter.cpp
+ * @brief Class used to share a file splitting between several producer threads
+ * @author Sign Coding Dwarf
+ * @version 1.0
+ * @date 19 October 2026
+ *
+ * Implementation of the class allowing several threads to write complete records into the same set of split files.
+ * Each producer builds its record locally and submits it through a lock-free queue. A single writer thread owns the underlying fileSplitter so records never interleave.
+ *
+ */
+
+/* 
+Copyright 2016 SignCodingDwarf
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "concurrentFileSplitter.h"
+
+#include <chrono>
+
+/*! 
+* @def WRITER_SPIN_ROUNDS
+* @brief Number of empty queue checks done by the writer thread before going to sleep
+*/
+#define WRITER_SPIN_ROUNDS 64
+
+namespace dwf_utils
+{
+	concurrentFileSplitter::record::record(concurrentFileSplitter& splitter) : m_splitter(splitter), m_buffer()
+	{
+	}
+
+	concurrentFileSplitter::record::~record()
+	{
+		submit();
+	}
+
+	void concurrentFileSplitter::record::submit()
+	{
+		std::string data = m_buffer.str();
+		if(!data.empty())
+		{
+			m_splitter.submit(std::move(data));
+		}
+		m_buffer.str(""); // Start a new record
+		m_buffer.clear();
+	}
+
+	concurrentFileSplitter::concurrentFileSplitter(std::string baseName, std::string extension, unsigned long fileSize, splitterOptions const& options) : m_splitter(baseName, extension, fileSize, options), m_queue(), m_status(false), m_stop(false), m_sleeping(false), m_maxDepth(0), m_dropped(0)
+	{
+		m_status.store(m_splitter.getStatus());
+		m_writer = std::thread(&concurrentFileSplitter::writerLoop, this); // Started last, once every member is ready
+	}
+
+	concurrentFileSplitter::~concurrentFileSplitter()
+	{
+		m_stop.store(true);
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_wakeUp.notify_one();
+		}
+		if(m_writer.joinable())
+		{
+			m_writer.join();
+		}
+	}
+
+	void concurrentFileSplitter::submit(std::string data)
+	{
+		pendingRecord rec;
+		rec.m_data = std::move(data);
+		m_queue.push(std::move(rec));
+		wakeWriter();
+	}
+
+	void concurrentFileSplitter::flush()
+	{
+		waitWriter(NULL);
+	}
+
+	int concurrentFileSplitter::waitDurable()
+	{
+		unsigned long long ticket = 0;
+		waitWriter(&ticket);
+		return m_splitter.waitDurable(ticket); // Only uses the thread safe durability manager
+	}
+
+	durabilityStats concurrentFileSplitter::getDurabilityStats() const
+	{
+		return m_splitter.getDurabilityStats();
+	}
+
+	void concurrentFileSplitter::waitWriter(unsigned long long* ticket)
+	{
+		bool flushed = false;
+		pendingRecord rec;
+		rec.m_flushed = &flushed;
+		rec.m_ticket = ticket;
+		m_queue.push(std::move(rec));
+		wakeWriter();
+
+		std::unique_lock<std::mutex> lock(m_mutex);
+		while(!flushed)
+		{
+			m_flushDone.wait(lock);
+		}
+	}
+
+	bool concurrentFileSplitter::getStatus() const
+	{
+		return m_status.load(std::memory_order_relaxed);
+	}
+
+	size_t concurrentFileSplitter::getQueueDepth() const
+	{
+		return m_queue.size();
+	}
+
+	splitterStats concurrentFileSplitter::getStats() const
+	{
+		splitterStats stats = m_splitter.getStats(); // Only reads atomic counters and thread safe managers
+		stats.m_queueDepth = getQueueDepth();
+		stats.m_maxQueueDepth = m_maxDepth.load(std::memory_order_relaxed);
+		stats.m_dropped = m_dropped.load(std::memory_order_relaxed);
+		return stats;
+	}
+
+	void concurrentFileSplitter::wakeWriter()
+	{
+		std::atomic_thread_fence(std::memory_order_seq_cst); // Pairs with the writer fence so that either the writer sees the record or we see it sleeping
+		if(m_sleeping.load(std::memory_order_relaxed))
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_wakeUp.notify_one();
+		}
+	}
+
+	void concurrentFileSplitter::writerLoop()
+	{
+		unsigned int idle = 0;
+		while(true)
+		{
+			if(drain())
+			{
+				idle = 0;
+				continue;
+			}
+
+			if(m_stop.load())
+			{
+				drain(); // Records submitted before destruction must be written
+				break;
+			}
+
+			if(++idle < WRITER_SPIN_ROUNDS) // Avoid sleeping between two close bursts of records
+			{
+				std::this_thread::yield();
+				continue;
+			}
+
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_sleeping.store(true, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if(m_queue.empty() && !m_stop.load())
+			{
+				m_wakeUp.wait_for(lock, std::chrono::milliseconds(100));
+			}
+			m_sleeping.store(false, std::memory_order_relaxed);
+			idle = 0;
+		}
+		m_splitter.flush();
+	}
+
+	bool concurrentFileSplitter::drain()
+	{
+		bool written = false;
+		pendingRecord rec;
+		unsigned long long depth = m_queue.size();
+		if(depth > m_maxDepth.load(std::memory_order_relaxed))
+		{
+			m_maxDepth.store(depth, std::memory_order_relaxed);
+		}
+		while(m_queue.pop(rec))
+		{
+			written = true;
+			if(rec.m_flushed != NULL)
+			{
+				if(rec.m_ticket != NULL)
+				{
+					*rec.m_ticket = m_splitter.requestDurability();
+				}
+				else
+				{
+					m_splitter.flush();
+				}
+				std::lock_guard<std::mutex> lock(m_mutex);
+				*rec.m_flushed = true;
+				m_flushDone.notify_all();
+			}
+			else
+			{
+				if(!m_splitter.getStatus())
+				{
+					splitterCounters::add(m_dropped, 1);
+				}
+				m_splitter.beginRecord(); // Records are the only split points
+				m_splitter << rec.m_data;
+				m_splitter.commitRecord();
+			}
+		}
+		if(written)
+		{
+			m_status.store(m_splitter.getStatus(), std::memory_order_relaxed);
+		}
+		return written;
+	}
+}
+
+//  ______________________________
+// |                              |
+// |    ______________________    |       
+// |   |                      |   |
+// |   |         sign         |   |
+// |   |        coding        |   |
+// |   |        dw@rf         |   |
+// |   |         1.0          |   |
+// |   |______________________|   |
+// |                              |
+// |______________________________|
+//               |  |           
+//               |  |             
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |__|
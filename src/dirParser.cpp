@@ -28,12 +28,92 @@ limitations under the License.
 */
 
 #include "dirParser.h"
+#include <atomic>
+#include <cstring>
+#ifdef __linux__
+#include <cerrno>
+#include <map>
+#include <mutex>
+#include "dirWatcher.h"
+#endif
+
+/*!
+* @def DIRPARSER_WATCH_MASK
+* @brief inotify events making a directory kept open change
+*/
+#define DIRPARSER_WATCH_MASK (IN_MOVE_SELF | IN_DELETE_SELF | IN_UNMOUNT)
 
 using namespace std;
 
 namespace dwf_utils
 {
-	dirParser::dirParser(unsigned int maxPathLength) : m_dirLoaded(true), m_WDir(), m_exeLoc(), m_maxPathLength(maxPathLength)
+	static std::atomic<unsigned long> cwdGeneration(0); /*!< Number of working directory changes made with changeDir */
+
+#ifdef __linux__
+	/*! \struct parserWatch
+	* \brief inotify watcher shared by all dirParser, counting the changes of each watched directory
+	*
+	* A single descriptor is used since closing an inotify descriptor having watches waits for the kernel for milliseconds.
+	* Watches are kept until the end of the program, inotify watching each directory only once whatever the number of dirParser using it.
+	*
+	*/
+	struct parserWatch
+	{
+		/*!
+		* @brief Constructor of the parserWatch structure
+		*
+		* Creates the inotify descriptor.
+		*
+		*/
+		parserWatch() : m_lostEvents(0)
+		{
+		}
+
+		/*!
+		* @brief Count the pending events
+		*
+		* m_mutex must be locked.
+		*
+		*/
+		void readChanges()
+		{
+			std::vector<watchEvent> events;
+			if(m_watcher.readEvents(events) == EXEC_FAILURE)
+			{
+				++m_lostEvents;
+			}
+			for(size_t i = 0; i < events.size(); ++i)
+			{
+				if(events[i].m_watch < 0)
+				{
+					++m_lostEvents;
+				}
+				else if(events[i].m_mask & DIRPARSER_WATCH_MASK)
+				{
+					++m_changes[events[i].m_watch];
+				}
+			}
+		}
+
+		std::mutex m_mutex; /*!< Mutex protecting the structure */
+		dirWatcher m_watcher; /*!< Watcher of all directories kept open */
+		std::map<int, unsigned long> m_changes; /*!< Number of changes of each watch */
+		unsigned long m_lostEvents; /*!< Number of queue overflows or read failures, after which any directory may have changed */
+	};
+
+	/*!
+	* @brief Get the watcher shared by all dirParser
+	* @return The watcher, created at first use
+	*
+	*/
+	static parserWatch& sharedWatch()
+	{
+		static parserWatch watch;
+		return watch;
+	}
+#endif
+
+	dirParser::dirParser(unsigned int maxPathLength) : m_exeLoc(), m_WDir(), m_dirLoaded(true), m_maxPathLength(maxPathLength), m_changed(false), m_cwdGeneration(0)
 	{
 		setDir();
 #if DEBUG
@@ -43,19 +123,53 @@ namespace dwf_utils
 
 	dirParser::~dirParser(void)
 	{
+#ifdef __linux__
+		closeDirs();
+#endif
+	}
+
+#ifdef __linux__
+	dirParser::dirParser(dirParser const& other) : m_exeLoc(other.m_exeLoc), m_WDir(other.m_WDir), m_dirLoaded(other.m_dirLoaded), m_maxPathLength(other.m_maxPathLength), m_changed(other.m_changed), m_cwdGeneration(other.m_cwdGeneration), m_dirs(other.m_dirs), m_lostEvents(other.m_lostEvents)
+	{
+		for(size_t i = 0; i < m_dirs.size(); ++i)
+		{
+			m_dirs[i].m_fd = m_dirs[i].m_fd >= 0 ? fcntl(m_dirs[i].m_fd, F_DUPFD_CLOEXEC, 0) : -1; // Same directory, so same watch
+		}
+	}
+
+	dirParser& dirParser::operator=(dirParser const& other)
+	{
+		if(this != &other)
+		{
+			closeDirs();
+			m_dirLoaded = other.m_dirLoaded;
+			m_WDir = other.m_WDir;
+			m_exeLoc = other.m_exeLoc;
+			m_maxPathLength = other.m_maxPathLength;
+			m_changed = other.m_changed;
+			m_cwdGeneration = other.m_cwdGeneration;
+			m_dirs = other.m_dirs;
+			m_lostEvents = other.m_lostEvents;
+			for(size_t i = 0; i < m_dirs.size(); ++i)
+			{
+				m_dirs[i].m_fd = m_dirs[i].m_fd >= 0 ? fcntl(m_dirs[i].m_fd, F_DUPFD_CLOEXEC, 0) : -1;
+			}
+		}
+		return *this;
 	}
+#endif
 
 	bool dirParser::getDirLoaded() const
 	{
 		return m_dirLoaded;
 	}
 
-	string dirParser::getExeLoc() const
+	string const& dirParser::getExeLoc() const
 	{
 		return m_exeLoc;
 	}
 
-	string dirParser::getWDir() const
+	string const& dirParser::getWDir() const
 	{
 		return m_WDir;
 	}
@@ -68,29 +182,81 @@ namespace dwf_utils
 	void dirParser::setMaxPathLength(unsigned int maxPathLength)
 	{
 		m_maxPathLength = maxPathLength;
+		m_changed = true; // Paths must be checked against the new length
 	}
 
 	bool dirParser::update()
 	{
+		if(!hasChanged())
+		{
+			return m_dirLoaded;
+		}
 		m_dirLoaded = true; // Reset found variable since setDir can only set to false
 		setDir(); // Call set function to update
 		return m_dirLoaded;
 	}
 
+	bool dirParser::hasChanged()
+	{
+#ifdef __linux__
+		if(m_changed || !m_dirLoaded || m_cwdGeneration != cwdGeneration.load())
+		{
+			m_changed = true;
+			return true;
+		}
+		parserWatch& watch = sharedWatch();
+		std::lock_guard<std::mutex> lock(watch.m_mutex);
+		watch.readChanges();
+		m_changed = !watch.m_watcher.getStatus() || watch.m_lostEvents != m_lostEvents;
+		for(size_t i = 0; i < m_dirs.size() && !m_changed; ++i)
+		{
+			m_changed = m_dirs[i].m_watch < 0 || watch.m_changes[m_dirs[i].m_watch] != m_dirs[i].m_changes;
+		}
+		return m_changed;
+#else
+		return true;
+#endif
+	}
+
+	void dirParser::invalidate()
+	{
+		m_changed = true;
+	}
+
+	bool dirParser::changeDir(string const& path)
+	{
+#ifdef _WIN32
+		bool changed = _chdir(path.c_str()) == 0;
+#elif __linux__
+		bool changed = chdir(path.c_str()) == 0;
+#endif
+		if(changed)
+		{
+			cwdGeneration.fetch_add(1);
+		}
+		return changed;
+	}
+
 	void dirParser::setDir()
 	{	
-		// Get current Woring Directory
- 		char WD[m_maxPathLength]; // PATH_MAX is maximal size of a path length
+		m_changed = false;
+		m_cwdGeneration = cwdGeneration.load(); // Read before getcwd so that a change made meanwhile is seen by the next update
+		// Get current Woring Directory, written in the string itself so that its memory is reused by next calls
+		m_WDir.resize(m_maxPathLength);
+		char *dir = NULL;
+		if(m_maxPathLength > 0)
+		{
 #ifdef _WIN32
-		char *dir = _getcwd(WD, sizeof(WD)); // Get the output of this function to check success
+			dir = _getcwd(&m_WDir[0], m_maxPathLength); // Get the output of this function to check success
 #elif __linux__
-		char *dir = getcwd(WD, sizeof(WD)); // Get the output of this function to check success
+			dir = getcwd(&m_WDir[0], m_maxPathLength); // Get the output of this function to check success
 #endif
+		}
 		if(dir != NULL)
 		{
-			m_WDir = WD;
+			m_WDir.resize(strlen(dir));
 #ifdef _WIN32   // Add folder separating characer depending on the OS
-			m_WDir += '\\' 
+			m_WDir += '\\';
 #elif __linux__
 			m_WDir += '/';
 #endif
@@ -100,19 +266,24 @@ namespace dwf_utils
 #if DEBUG
 			std::cerr << "Could not find working directory" << std::endl;
 #endif
+			m_WDir.clear();
 			m_dirLoaded = false;
 		}
 
-		// Get executable location
-  		char exeLoc[ m_maxPathLength ];
+		// Get executable location, written in the string itself too
+		m_exeLoc.resize(m_maxPathLength);
+		ssize_t size = -1;
+		if(m_maxPathLength > 0)
+		{
 #ifdef _WIN32
-		ssize_t size = GetModuleFileName( NULL, exeLoc, m_maxPathLength ); 
+			size = GetModuleFileName( NULL, &m_exeLoc[0], m_maxPathLength ); 
 #elif __linux__
-		ssize_t size = readlink( "/proc/self/exe", exeLoc, m_maxPathLength );
+			size = readlink( "/proc/self/exe", &m_exeLoc[0], m_maxPathLength );
 #endif
-		if(size > 0)
+		}
+		if(size > 0 && static_cast<size_t>(size) < m_maxPathLength) // Name is truncated otherwise
 		{
-	 		m_exeLoc = exeLoc;
+	 		m_exeLoc.resize(size);
 			size_t last = m_exeLoc.find_last_of('\\');
 			if(last == m_exeLoc.npos)
 			{
@@ -136,9 +307,159 @@ namespace dwf_utils
 #if DEBUG
 			std::cerr << "Could not locate executable" << std::endl;
 #endif
+			m_exeLoc.clear();
 			m_dirLoaded = false;
 		}
+
+#ifdef __linux__
+		// Open directories again, registered folders after their parent
+		{
+			parserWatch& watch = sharedWatch();
+			std::lock_guard<std::mutex> lock(watch.m_mutex);
+			watch.readChanges(); // Changes made until now are seen by the new descriptors
+			m_lostEvents = watch.m_lostEvents;
+		}
+		if(m_dirs.empty())
+		{
+			m_dirs.resize(2);
+			for(size_t i = 0; i < m_dirs.size(); ++i)
+			{
+				m_dirs[i].m_fd = -1;
+				m_dirs[i].m_parent = -1;
+				m_dirs[i].m_create = false;
+				m_dirs[i].m_watch = -1;
+				m_dirs[i].m_changes = 0;
+			}
+		}
+		m_dirs[EXE_DIR].m_path = m_exeLoc;
+		m_dirs[WORKING_DIR].m_path = m_WDir;
+		for(size_t i = 0; i < m_dirs.size(); ++i)
+		{
+			if(i > WORKING_DIR)
+			{
+				m_dirs[i].m_path = m_dirs[m_dirs[i].m_parent].m_path + m_dirs[i].m_subPath;
+			}
+			if(!openDir(m_dirs[i]))
+			{
+				m_dirLoaded = false;
+			}
+		}
+#endif
+	}
+
+#ifdef __linux__
+	int dirParser::registerDir(int parent, string const& subPath, bool create)
+	{
+		if(getDirFd(parent) < 0 || subPath.empty())
+		{
+			return -1;
+		}
+		string path = subPath;
+		if(path[path.size() - 1] != '/')
+		{
+			path += '/';
+		}
+		for(size_t i = WORKING_DIR + 1; i < m_dirs.size(); ++i)
+		{
+			if(m_dirs[i].m_parent == parent && m_dirs[i].m_subPath == path)
+			{
+				m_dirs[i].m_create = m_dirs[i].m_create || create;
+				if(m_dirs[i].m_fd < 0 && !openDir(m_dirs[i]))
+				{
+					return -1;
+				}
+				return static_cast<int>(i);
+			}
+		}
+
+		cachedDir dir;
+		dir.m_fd = -1;
+		dir.m_parent = parent;
+		dir.m_subPath = path;
+		dir.m_path = m_dirs[parent].m_path + path;
+		dir.m_create = create;
+		dir.m_watch = -1;
+		dir.m_changes = 0;
+		if(!openDir(dir))
+		{
+			return -1;
+		}
+		m_dirs.push_back(dir);
+		return static_cast<int>(m_dirs.size() - 1);
+	}
+
+	int dirParser::getDirFd(int dir) const
+	{
+		if(dir < 0 || static_cast<size_t>(dir) >= m_dirs.size())
+		{
+			return -1;
+		}
+		return m_dirs[dir].m_fd;
 	}
+
+	string const& dirParser::getDirPath(int dir) const
+	{
+		static const string unknown;
+		if(dir < 0 || static_cast<size_t>(dir) >= m_dirs.size())
+		{
+			return unknown;
+		}
+		return m_dirs[dir].m_path;
+	}
+
+	bool dirParser::openDir(cachedDir& dir)
+	{
+		if(dir.m_fd >= 0)
+		{
+			close(dir.m_fd);
+			dir.m_fd = -1;
+		}
+		int flags = O_RDONLY | O_DIRECTORY | O_CLOEXEC;
+		if(dir.m_parent < 0)
+		{
+			if(!dir.m_path.empty())
+			{
+				dir.m_fd = open(dir.m_path.c_str(), flags);
+			}
+		}
+		else
+		{
+			int parentFd = getDirFd(dir.m_parent);
+			dir.m_fd = openat(parentFd, dir.m_subPath.c_str(), flags);
+			if(dir.m_fd < 0 && errno == ENOENT && dir.m_create && mkdirat(parentFd, dir.m_subPath.c_str(), 0755) == 0)
+			{
+				dir.m_fd = openat(parentFd, dir.m_subPath.c_str(), flags);
+			}
+		}
+		if(dir.m_fd < 0)
+		{
+#if DEBUG
+			std::cerr << "Could not open directory " << dir.m_path << std::endl;
+#endif
+			return false;
+		}
+		parserWatch& watch = sharedWatch();
+		std::lock_guard<std::mutex> lock(watch.m_mutex);
+		dir.m_watch = watch.m_watcher.addWatch(dir.m_fd, dir.m_path, DIRPARSER_WATCH_MASK);
+		if(dir.m_watch >= 0)
+		{
+			dir.m_changes = watch.m_changes[dir.m_watch];
+		}
+		return true;
+	}
+
+	void dirParser::closeDirs()
+	{
+		for(size_t i = 0; i < m_dirs.size(); ++i)
+		{
+			if(m_dirs[i].m_fd >= 0)
+			{
+				close(m_dirs[i].m_fd);
+				m_dirs[i].m_fd = -1;
+			}
+		}
+	}
+#endif
 }
 
 //  ______________________________
@@ -0,0 +1,487 @@
+/*!
+ * @file dirWalker.cpp
+ * @brief Class used to walk through a directory tree with several threads
+ * @author Sign Coding Dwarf
+ * @version 1.0
+ * @date 19 October 2026
+ *
+ * Implementation of the class walking recursively through a directory tree with a pool of threads stealing directories from each other.
+ *
+ */
+
+/*
+Copyright 2016 SignCodingDwarf
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "dirWalker.h"
+#include <iostream>
+#include <vector>
+#include <deque>
+#include <set>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/syscall.h>
+
+namespace dwf_utils
+{
+	/*! \struct linuxDirent64
+	* \brief Record written by getdents64, which glibc does not declare
+	*/
+	struct linuxDirent64
+	{
+		unsigned long long d_ino; /*!< Inode number */
+		long long d_off; /*!< Offset of the next record */
+		unsigned short d_reclen; /*!< Size of this record */
+		unsigned char d_type; /*!< Type of the entry */
+		char d_name[1]; /*!< Null terminated name */
+	};
+
+	/*! \struct dirHandle
+	* \brief Open directory, closed when no subdirectory waiting in queue needs it any more
+	*/
+	struct dirHandle
+	{
+		/*!
+		* @brief Constructor of the dirHandle structure
+		* @param fd : descriptor of the directory
+		* @param path : path of the directory, ending with '/'
+		*
+		*/
+		dirHandle(int fd, std::string path) : m_fd(fd), m_path(std::move(path))
+		{
+		}
+
+		/*!
+		* @brief Destructor of the dirHandle structure
+		*
+		* Closes the directory.
+		*
+		*/
+		~dirHandle()
+		{
+			close(m_fd);
+		}
+
+		int m_fd; /*!< Descriptor of the directory */
+		std::string m_path; /*!< Path of the directory, ending with '/' */
+	};
+
+	/*! \struct dirTask
+	* \brief Directory waiting to be read
+	*/
+	struct dirTask
+	{
+		std::shared_ptr<dirHandle> m_parent; /*!< Parent directory, NULL for the root */
+		std::string m_name; /*!< Name of the directory in its parent, path of the root */
+		unsigned int m_depth; /*!< Depth of the directory, 0 for the root */
+	};
+
+	/*! \struct walkQueue
+	* \brief Directories found by a thread
+	*/
+	struct walkQueue
+	{
+		std::mutex m_mutex; /*!< Mutex protecting the queue */
+		std::deque<dirTask> m_tasks; /*!< Directories, taken from the back by the owner and from the front by other threads */
+	};
+
+	/*! \struct walkState
+	* \brief State shared by the threads of a walk
+	*/
+	struct walkState
+	{
+		/*!
+		* @brief Constructor of the walkState structure
+		* @param options : optional behaviours of the walker
+		* @param callback : function receiving each entry
+		* @param threadNb : number of threads
+		*
+		*/
+		walkState(walkerOptions const& options, walkCallback const& callback, unsigned int threadNb) : m_options(options), m_callback(callback), m_pending(0), m_pushed(0), m_sleeping(0), m_entryNb(0), m_directoryNb(0), m_errorNb(0), m_stolenNb(0)
+		{
+			for(unsigned int i = 0; i < threadNb; ++i)
+			{
+				m_queues.push_back(std::unique_ptr<walkQueue>(new walkQueue()));
+			}
+		}
+
+		walkerOptions const& m_options; /*!< Optional behaviours */
+		walkCallback const& m_callback; /*!< Function receiving each entry */
+		std::vector<std::unique_ptr<walkQueue> > m_queues; /*!< Queue of each thread */
+		std::atomic<unsigned long long> m_pending; /*!< Number of directories queued or being read. Walk is over when it reaches 0 */
+		std::atomic<unsigned long long> m_pushed; /*!< Number of directories ever queued, used to wake up idle threads */
+		std::atomic<unsigned int> m_sleeping; /*!< Number of threads waiting for directories */
+		std::mutex m_idleMutex; /*!< Mutex of idle threads */
+		std::condition_variable m_idle; /*!< Condition notified when a directory is queued or when the walk is over */
+		std::mutex m_visitedMutex; /*!< Mutex protecting m_visited */
+		std::set<std::pair<dev_t, ino_t> > m_visited; /*!< Directories already walked, used when links are followed */
+		std::atomic<unsigned long long> m_entryNb; /*!< Number of entries given */
+		std::atomic<unsigned long long> m_directoryNb; /*!< Number of directories read */
+		std::atomic<unsigned long long> m_errorNb; /*!< Number of directories which could not be read */
+		std::atomic<unsigned long long> m_stolenNb; /*!< Number of directories stolen */
+	};
+
+	/*!
+	* @brief Get type of an entry from its mode
+	* @param mode : mode given by stat
+	* @return Type of the entry
+	*
+	*/
+	static entryType typeOfMode(mode_t mode)
+	{
+		if(S_ISREG(mode))
+		{
+			return ENTRY_FILE;
+		}
+		if(S_ISDIR(mode))
+		{
+			return ENTRY_DIRECTORY;
+		}
+		if(S_ISLNK(mode))
+		{
+			return ENTRY_LINK;
+		}
+		return ENTRY_OTHER;
+	}
+
+	/*!
+	* @brief Get type of an entry from getdents64
+	* @param type : d_type of the entry
+	* @return Type of the entry, ENTRY_UNKNOWN if the file system does not give it
+	*
+	*/
+	static entryType typeOfDirent(unsigned char type)
+	{
+		switch(type)
+		{
+		case DT_REG:
+			return ENTRY_FILE;
+		case DT_DIR:
+			return ENTRY_DIRECTORY;
+		case DT_LNK:
+			return ENTRY_LINK;
+		case DT_UNKNOWN:
+			return ENTRY_UNKNOWN;
+		default:
+			return ENTRY_OTHER;
+		}
+	}
+
+	/*!
+	* @brief Queue a directory
+	* @param state : state of the walk
+	* @param index : index of the calling thread
+	* @param task : directory to queue
+	*
+	*/
+	static void pushTask(walkState& state, unsigned int index, dirTask task)
+	{
+		state.m_pending.fetch_add(1);
+		{
+			std::lock_guard<std::mutex> lock(state.m_queues[index]->m_mutex);
+			state.m_queues[index]->m_tasks.push_back(std::move(task));
+		}
+		state.m_pushed.fetch_add(1);
+		if(state.m_sleeping.load() > 0)
+		{
+			std::lock_guard<std::mutex> lock(state.m_idleMutex);
+			state.m_idle.notify_one();
+		}
+	}
+
+	/*!
+	* @brief Take a directory
+	* @param state : state of the walk
+	* @param index : index of the calling thread
+	* @param task : receives the directory
+	* @return TRUE if a directory was found and FALSE otherwise
+	*
+	* Takes the newest directory of the own queue of the thread, otherwise the oldest one of another queue.
+	*
+	*/
+	static bool popTask(walkState& state, unsigned int index, dirTask& task)
+	{
+		size_t queueNb = state.m_queues.size();
+		for(size_t i = 0; i < queueNb; ++i)
+		{
+			walkQueue& queue = *state.m_queues[(index + i) % queueNb];
+			std::lock_guard<std::mutex> lock(queue.m_mutex);
+			if(queue.m_tasks.empty())
+			{
+				continue;
+			}
+			if(i == 0)
+			{
+				task = std::move(queue.m_tasks.back());
+				queue.m_tasks.pop_back();
+			}
+			else
+			{
+				task = std::move(queue.m_tasks.front());
+				queue.m_tasks.pop_front();
+				state.m_stolenNb.fetch_add(1, std::memory_order_relaxed);
+			}
+			return true;
+		}
+		return false;
+	}
+
+	/*!
+	* @brief Know if a directory was already walked
+	* @param state : state of the walk
+	* @param fd : descriptor of the directory
+	* @return TRUE if the directory was already walked or cannot be identified and FALSE otherwise
+	*
+	*/
+	static bool alreadyVisited(walkState& state, int fd)
+	{
+		struct stat status;
+		if(fstat(fd, &status) != 0)
+		{
+			return true;
+		}
+		std::lock_guard<std::mutex> lock(state.m_visitedMutex);
+		return !state.m_visited.insert(std::make_pair(status.st_dev, status.st_ino)).second;
+	}
+
+	/*!
+	* @brief Read a directory
+	* @param state : state of the walk
+	* @param index : index of the calling thread
+	* @param task : directory to read
+	* @param buffer : buffer receiving the records of getdents64
+	*
+	* Gives every entry to the callback and queues the subdirectories.
+	*
+	*/
+	static void readDirectory(walkState& state, unsigned int index, dirTask& task, std::vector<char>& buffer)
+	{
+		walkerOptions const& options = state.m_options;
+		int flags = O_RDONLY | O_DIRECTORY | O_CLOEXEC | (options.m_followLinks ? 0 : O_NOFOLLOW);
+		int fd = task.m_parent ? openat(task.m_parent->m_fd, task.m_name.c_str(), flags) : open(task.m_name.c_str(), flags & ~O_NOFOLLOW);
+		if(fd < 0)
+		{
+#if DEBUG
+			std::cerr << "Could not open directory " << (task.m_parent ? task.m_parent->m_path : "") << task.m_name << " : " << strerror(errno) << std::endl;
+#endif
+			state.m_errorNb.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+		if(options.m_followLinks && alreadyVisited(state, fd))
+		{
+			close(fd);
+			return;
+		}
+		std::string path = task.m_parent ? task.m_parent->m_path + task.m_name : task.m_name;
+		if(path.empty() || path[path.size() - 1] != '/')
+		{
+			path += '/';
+		}
+		std::shared_ptr<dirHandle> handle = std::make_shared<dirHandle>(fd, std::move(path));
+		task.m_parent.reset(); // Parent may be closed as soon as possible
+		state.m_directoryNb.fetch_add(1, std::memory_order_relaxed);
+
+		unsigned int depth = task.m_depth + 1;
+		bool descend = options.m_maxDepth == 0 || depth < options.m_maxDepth;
+		struct stat status;
+		while(true)
+		{
+			long size = syscall(SYS_getdents64, fd, &buffer[0], buffer.size());
+			if(size <= 0)
+			{
+				if(size < 0)
+				{
+#if DEBUG
+					std::cerr << "Could not read directory " << handle->m_path << " : " << strerror(errno) << std::endl;
+#endif
+					state.m_errorNb.fetch_add(1, std::memory_order_relaxed);
+				}
+				break;
+			}
+			for(long position = 0; position < size;)
+			{
+				const linuxDirent64* record = reinterpret_cast<const linuxDirent64*>(&buffer[position]);
+				position += record->d_reclen;
+				const char* name = record->d_name;
+				if(name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0')))
+				{
+					continue;
+				}
+
+				entryType type = typeOfDirent(record->d_type);
+				bool hasStatus = false;
+				if(options.m_stat || type == ENTRY_UNKNOWN)
+				{
+					hasStatus = fstatat(fd, name, &status, AT_SYMLINK_NOFOLLOW) == 0;
+					if(hasStatus)
+					{
+						type = typeOfMode(status.st_mode);
+					}
+				}
+				bool directory = type == ENTRY_DIRECTORY;
+				if(type == ENTRY_LINK && options.m_followLinks && descend)
+				{
+					struct stat target;
+					directory = fstatat(fd, name, &target, 0) == 0 && S_ISDIR(target.st_mode);
+				}
+
+				state.m_entryNb.fetch_add(1, std::memory_order_relaxed);
+				dirEntry entry(handle->m_path, name, fd, type, depth, options.m_stat && hasStatus ? &status : NULL);
+				if(state.m_callback(entry) && directory && descend)
+				{
+					dirTask child;
+					child.m_parent = handle;
+					child.m_name = name;
+					child.m_depth = depth;
+					pushTask(state, index, std::move(child));
+				}
+			}
+		}
+	}
+
+	/*!
+	* @brief Loop of a thread of the walk
+	* @param state : state of the walk
+	* @param index : index of the thread
+	*
+	* Reads directories until none is queued or being read.
+	*
+	*/
+	static void walkLoop(walkState& state, unsigned int index)
+	{
+		std::vector<char> buffer(WALKER_BUFFER_SIZE);
+		while(true)
+		{
+			unsigned long long pushed = state.m_pushed.load();
+			dirTask task;
+			if(popTask(state, index, task))
+			{
+				readDirectory(state, index, task, buffer);
+				task.m_parent.reset();
+				if(state.m_pending.fetch_sub(1) == 1) // Last directory of the walk
+				{
+					std::lock_guard<std::mutex> lock(state.m_idleMutex);
+					state.m_idle.notify_all();
+				}
+				continue;
+			}
+
+			std::unique_lock<std::mutex> lock(state.m_idleMutex);
+			state.m_sleeping.fetch_add(1);
+			state.m_idle.wait(lock, [&state, pushed]() { return state.m_pending.load() == 0 || state.m_pushed.load() != pushed; });
+			state.m_sleeping.fetch_sub(1);
+			if(state.m_pending.load() == 0)
+			{
+				return;
+			}
+		}
+	}
+
+	dirWalker::dirWalker(walkerOptions const& options) : m_options(options), m_entryNb(0), m_directoryNb(0), m_errorNb(0), m_stolenNb(0)
+	{
+	}
+
+	dirWalker::~dirWalker()
+	{
+	}
+
+	int dirWalker::walk(std::string const& root, walkCallback const& callback)
+	{
+		unsigned int threadNb = m_options.m_threadNb;
+		if(threadNb == 0)
+		{
+			threadNb = std::thread::hardware_concurrency();
+		}
+		if(threadNb == 0)
+		{
+			threadNb = 1;
+		}
+
+		walkState state(m_options, callback, threadNb);
+		dirTask task;
+		task.m_name = root;
+		task.m_depth = 0;
+		pushTask(state, 0, std::move(task));
+
+		std::vector<std::thread> threads;
+		for(unsigned int i = 1; i < threadNb; ++i)
+		{
+			threads.push_back(std::thread(&walkLoop, std::ref(state), i));
+		}
+		walkLoop(state, 0);
+		for(size_t i = 0; i < threads.size(); ++i)
+		{
+			threads[i].join();
+		}
+
+		m_entryNb = state.m_entryNb.load();
+		m_directoryNb = state.m_directoryNb.load();
+		m_errorNb = state.m_errorNb.load();
+		m_stolenNb = state.m_stolenNb.load();
+		return m_errorNb == 0 ? EXEC_SUCCESS : EXEC_FAILURE;
+	}
+
+	unsigned long long dirWalker::getEntryNb() const
+	{
+		return m_entryNb;
+	}
+
+	unsigned long long dirWalker::getDirectoryNb() const
+	{
+		return m_directoryNb;
+	}
+
+	unsigned long long dirWalker::getErrorNb() const
+	{
+		return m_errorNb;
+	}
+
+	unsigned long long dirWalker::getStolenNb() const
+	{
+		return m_stolenNb;
+	}
+}
+
+//  ______________________________
+// |                              |
+// |    ______________________    |       
+// |   |                      |   |
+// |   |         sign         |   |
+// |   |        coding        |   |
+// |   |        dw@rf         |   |
+// |   |         1.0          |   |
+// |   |______________________|   |
+// |                              |
+// |______________________________|
+//               |  |           
+//               |  |             
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |__|
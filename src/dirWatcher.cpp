@@ -0,0 +1,258 @@
+/*!
+ * @file dirWatcher.cpp
+ * @brief Class used to be notified of changes in directories
+ * @author Sign Coding Dwarf
+ * @version 1.0
+ * @date 19 October 2026
+ *
+ * Implementation of the class watching directories with inotify.
+ *
+ */
+
+/*
+Copyright 2016 SignCodingDwarf
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "dirWatcher.h"
+#include <iostream>
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <poll.h>
+
+namespace dwf_utils
+{
+	dirWatcher::dirWatcher() : m_fd(inotify_init1(IN_NONBLOCK | IN_CLOEXEC)), m_buffer(WATCH_BUFFER_SIZE)
+	{
+		m_wake[0] = -1;
+		m_wake[1] = -1;
+#if DEBUG
+		if(m_fd < 0)
+		{
+			std::cerr << "Could not create inotify descriptor : " << strerror(errno) << std::endl;
+		}
+#endif
+	}
+
+	dirWatcher::~dirWatcher()
+	{
+		stop();
+		if(m_fd >= 0)
+		{
+			close(m_fd); // Removes all watches
+		}
+	}
+
+	bool dirWatcher::getStatus() const
+	{
+		return m_fd >= 0;
+	}
+
+	int dirWatcher::addWatch(std::string const& path, uint32_t mask)
+	{
+		return watchTarget(path.c_str(), path, mask);
+	}
+
+	int dirWatcher::addWatch(int dirFd, std::string const& path, uint32_t mask)
+	{
+		if(dirFd < 0)
+		{
+			return -1;
+		}
+		return watchTarget(("/proc/self/fd/" + std::to_string(dirFd)).c_str(), path, mask); // Link to the directory itself
+	}
+
+	int dirWatcher::removeWatch(int watch)
+	{
+		if(m_fd < 0 || inotify_rm_watch(m_fd, watch) != 0)
+		{
+			return EXEC_FAILURE;
+		}
+		return EXEC_SUCCESS; // Path is forgotten with the IN_IGNORED event
+	}
+
+	int dirWatcher::getFd() const
+	{
+		return m_fd;
+	}
+
+	int dirWatcher::readEvents(std::vector<watchEvent>& events, int timeout)
+	{
+		if(m_fd < 0)
+		{
+			return EXEC_FAILURE;
+		}
+		if(timeout != 0)
+		{
+			struct pollfd ready;
+			ready.fd = m_fd;
+			ready.events = POLLIN;
+			if(poll(&ready, 1, timeout) < 0 && errno != EINTR)
+			{
+				return EXEC_FAILURE;
+			}
+		}
+
+		char* buffer = &m_buffer[0];
+		while(true)
+		{
+			ssize_t size = read(m_fd, buffer, m_buffer.size());
+			if(size <= 0)
+			{
+				if(size < 0 && errno != EAGAIN && errno != EINTR)
+				{
+#if DEBUG
+					std::cerr << "Could not read inotify events : " << strerror(errno) << std::endl;
+#endif
+					return EXEC_FAILURE;
+				}
+				return EXEC_SUCCESS;
+			}
+
+			std::lock_guard<std::mutex> lock(m_mutex);
+			for(ssize_t position = 0; position < size;)
+			{
+				const struct inotify_event* record = reinterpret_cast<const struct inotify_event*>(buffer + position);
+				position += sizeof(struct inotify_event) + record->len;
+
+				watchEvent event;
+				event.m_watch = record->wd;
+				event.m_mask = record->mask;
+				event.m_cookie = record->cookie;
+				if(record->len > 0)
+				{
+					event.m_name = record->name; // Padded with null characters
+				}
+				std::map<int, std::string>::iterator watch = m_watches.find(record->wd);
+				if(watch != m_watches.end())
+				{
+					event.m_dir = watch->second;
+					if(record->mask & IN_IGNORED)
+					{
+						m_watches.erase(watch);
+					}
+				}
+				events.push_back(event);
+			}
+		}
+	}
+
+	int dirWatcher::watchTarget(const char* target, std::string const& path, uint32_t mask)
+	{
+		if(m_fd < 0)
+		{
+			return -1;
+		}
+		int watch = inotify_add_watch(m_fd, target, mask | IN_ONLYDIR);
+		if(watch < 0)
+		{
+#if DEBUG
+			std::cerr << "Could not watch " << path << " : " << strerror(errno) << std::endl;
+#endif
+			return -1;
+		}
+		std::string dir = path;
+		if(dir.empty() || dir[dir.size() - 1] != '/')
+		{
+			dir += '/';
+		}
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_watches[watch] = dir;
+		return watch;
+	}
+
+	int dirWatcher::start(watchCallback const& callback)
+	{
+		if(m_fd < 0 || m_thread.joinable() || pipe2(m_wake, O_CLOEXEC) != 0)
+		{
+			return EXEC_FAILURE;
+		}
+		m_callback = callback;
+		m_thread = std::thread([this]()
+		{
+			struct pollfd ready[2];
+			ready[0].fd = m_fd;
+			ready[0].events = POLLIN;
+			ready[1].fd = m_wake[0];
+			ready[1].events = POLLIN;
+			std::vector<watchEvent> events;
+			while(true)
+			{
+				ready[0].revents = 0;
+				ready[1].revents = 0;
+				if(poll(ready, 2, -1) < 0 && errno != EINTR)
+				{
+					break;
+				}
+				events.clear();
+				if(ready[0].revents != 0 && readEvents(events) == EXEC_FAILURE)
+				{
+					break;
+				}
+				for(size_t i = 0; i < events.size(); ++i)
+				{
+					m_callback(events[i]);
+				}
+				if(ready[1].revents != 0)
+				{
+					break;
+				}
+			}
+		});
+		return EXEC_SUCCESS;
+	}
+
+	void dirWatcher::stop()
+	{
+		if(!m_thread.joinable())
+		{
+			return;
+		}
+		char wake = 0;
+		while(write(m_wake[1], &wake, 1) < 0 && errno == EINTR)
+		{
+		}
+		m_thread.join();
+		close(m_wake[0]);
+		close(m_wake[1]);
+		m_wake[0] = -1;
+		m_wake[1] = -1;
+	}
+}
+
+//  ______________________________
+// |                              |
+// |    ______________________    |       
+// |   |                      |   |
+// |   |         sign         |   |
+// |   |        coding        |   |
+// |   |        dw@rf         |   |
+// |   |         1.0          |   |
+// |   |______________________|   |
+// |                              |
+// |______________________________|
+//               |  |           
+//               |  |             
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |__|
@@ -0,0 +1,174 @@
+/*!
+ * @file directEngine.cpp
+ * @brief Class used to write split files without going through the page cache
+ * @author Sign Coding Dwarf
+ * @version 1.0
+ * @date 19 October 2026
+ *
+ * Implementation of the write engine opening files with O_DIRECT and writing aligned blocks from aligned buffers.
+ *
+ */
+
+/* 
+Copyright 2016 SignCodingDwarf
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "directEngine.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace dwf_utils
+{
+	directEngine::directEngine(size_t bufferSize) : writeEngine(), m_buffer(NULL), m_bufferSize((bufferSize + DIRECT_ALIGNMENT - 1) / DIRECT_ALIGNMENT * DIRECT_ALIGNMENT), m_pending(0), m_drained(false)
+	{
+		if(m_bufferSize < 2 * DIRECT_ALIGNMENT) // Room for a block after the incomplete one
+		{
+			m_bufferSize = 2 * DIRECT_ALIGNMENT;
+		}
+		void* buffer = NULL;
+		if(posix_memalign(&buffer, DIRECT_ALIGNMENT, m_bufferSize) != 0)
+		{
+#if DEBUG
+			std::cerr << "Could not allocate aligned buffer of " << m_bufferSize << " bytes" << std::endl;
+#endif
+			m_bufferSize = 0;
+			return;
+		}
+		m_buffer = static_cast<char*>(buffer);
+	}
+
+	directEngine* directEngine::create(size_t bufferSize)
+	{
+		directEngine* engine = new directEngine(bufferSize);
+		if(!engine->getStatus())
+		{
+			delete engine;
+			return NULL;
+		}
+		return engine;
+	}
+
+	directEngine::~directEngine()
+	{
+		if(m_fd >= 0)
+		{
+			detach();
+		}
+		free(m_buffer);
+	}
+
+	int directEngine::openFlags() const
+	{
+#ifdef O_DIRECT
+		return O_WRONLY | O_DIRECT;
+#else
+		return O_WRONLY;
+#endif
+	}
+
+	int directEngine::detach()
+	{
+		int result = drain();
+		m_pending = 0;
+		m_drained = false;
+		if(writeEngine::detach() == EXEC_FAILURE)
+		{
+			result = EXEC_FAILURE;
+		}
+		return result;
+	}
+
+	int directEngine::drain()
+	{
+		if(m_fd < 0 || m_pending == 0 || m_drained)
+		{
+			return EXEC_SUCCESS;
+		}
+		std::memset(m_buffer + m_pending, 0, DIRECT_ALIGNMENT - m_pending); // Direct writes need whole blocks
+		if(writeAt(m_fd, m_buffer, DIRECT_ALIGNMENT, m_offset - m_pending) == EXEC_FAILURE || ftruncate(m_fd, m_offset) != 0)
+		{
+			return EXEC_FAILURE;
+		}
+		m_drained = true;
+		return EXEC_SUCCESS;
+	}
+
+	unsigned long long directEngine::getWritten() const
+	{
+		return m_drained ? m_offset : m_offset - m_pending;
+	}
+
+	bool directEngine::getStatus() const
+	{
+		return m_buffer != NULL;
+	}
+
+	char* directEngine::getBuffer(size_t& size)
+	{
+		size = m_bufferSize - m_pending;
+		return m_buffer + m_pending;
+	}
+
+	int directEngine::commit(size_t size)
+	{
+		if(m_buffer == NULL)
+		{
+			return EXEC_FAILURE;
+		}
+		size_t filled = m_pending + size;
+		size_t blocks = filled / DIRECT_ALIGNMENT * DIRECT_ALIGNMENT;
+		m_offset += size;
+		if(blocks > 0)
+		{
+			if(writeAt(m_fd, m_buffer, blocks, m_offset - filled) == EXEC_FAILURE) // Offset of buffer start is always aligned
+			{
+				m_pending = 0;
+				return EXEC_FAILURE;
+			}
+			std::memmove(m_buffer, m_buffer + blocks, filled - blocks); // Keep incomplete block for next commit
+		}
+		m_pending = filled - blocks;
+		m_drained = m_drained && size == 0;
+		return EXEC_SUCCESS;
+	}
+}
+
+//  ______________________________
+// |                              |
+// |    ______________________    |       
+// |   |                      |   |
+// |   |         sign         |   |
+// |   |        coding        |   |
+// |   |        dw@rf         |   |
+// |   |         1.0          |   |
+// |   |______________________|   |
+// |                              |
+// |______________________________|
+//               |  |           
+//               |  |             
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |__|
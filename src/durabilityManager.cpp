@@ -0,0 +1,249 @@
+/*!
+ * @file durabilityManager.cpp
+ * @brief Class used to make the data of split files durable
+ * @author Sign Coding Dwarf
+ * @version 1.0
+ * @date 19 October 2026
+ *
+ * Implementation of the class flushing the files written by fileSplitter to disk according to a durability policy.
+ *
+ */
+
+/* 
+Copyright 2016 SignCodingDwarf
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "durabilityManager.h"
+
+#include <iostream>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace dwf_utils
+{
+	durabilityManager::durabilityManager(durabilityPolicy policy, unsigned long long bytes, unsigned int period) : m_policy(policy), m_bytes(bytes > 0 ? bytes : 1), m_period(period > 0 ? period : 1), m_current(-1), m_closed(), m_position(0), m_durable(0), m_waiters(0), m_failed(false), m_stop(false), m_stats()
+	{
+		m_thread = std::thread(&durabilityManager::run, this); // Started last, once every member is ready
+	}
+
+	durabilityManager::~durabilityManager()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_stop = true;
+			m_request.notify_one();
+		}
+		if(m_thread.joinable())
+		{
+			m_thread.join();
+		}
+		for(size_t i = 0; i < m_closed.size(); ++i)
+		{
+			close(m_closed[i]);
+		}
+		if(m_current >= 0)
+		{
+			close(m_current);
+		}
+	}
+
+	int durabilityManager::attach(int fd)
+	{
+		int copy = fcntl(fd, F_DUPFD_CLOEXEC, 0);
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if(m_current >= 0)
+		{
+			m_closed.push_back(m_current); // Background thread may be flushing it, it closes it afterwards
+			m_request.notify_one();
+		}
+		m_current = copy;
+		if(copy < 0)
+		{
+#if DEBUG
+			std::cerr << "Could not duplicate descriptor for durability" << std::endl;
+#endif
+			m_failed = true;
+			return EXEC_FAILURE;
+		}
+		return EXEC_SUCCESS;
+	}
+
+	void durabilityManager::update(unsigned long long position)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if(position <= m_position)
+		{
+			return;
+		}
+		bool threshold = m_policy == DURABLE_BYTES && m_position - m_durable < m_bytes && position - m_durable >= m_bytes;
+		m_position = position;
+		if(threshold) // Only notify when the threshold is crossed
+		{
+			m_request.notify_one();
+		}
+	}
+
+	int durabilityManager::waitDurable(unsigned long long ticket)
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		if(ticket > m_position) // Never declared, would never be flushed
+		{
+			return EXEC_FAILURE;
+		}
+		++m_waiters;
+		m_request.notify_one();
+		while(m_durable < ticket && !m_failed)
+		{
+			m_synced.wait(lock);
+		}
+		--m_waiters;
+		if(m_durable < ticket)
+		{
+			return EXEC_FAILURE;
+		}
+		++m_stats.m_released;
+		return EXEC_SUCCESS;
+	}
+
+	unsigned long long durabilityManager::getDurable() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_durable;
+	}
+
+	durabilityStats durabilityManager::getStats() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_stats;
+	}
+
+	bool durabilityManager::syncRequired(std::chrono::steady_clock::time_point last) const
+	{
+		if(!m_closed.empty()) // Descriptors of previous files must be released
+		{
+			return true;
+		}
+		if(m_position == m_durable || m_failed)
+		{
+			return false;
+		}
+		if(m_stop || (m_waiters > 0 && m_policy != DURABLE_PERIODIC))
+		{
+			return true;
+		}
+		switch(m_policy)
+		{
+			case DURABLE_BYTES:
+				return m_position - m_durable >= m_bytes;
+			case DURABLE_PERIODIC:
+				return std::chrono::steady_clock::now() >= last + m_period;
+			default:
+				return false;
+		}
+	}
+
+	void durabilityManager::run()
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		std::chrono::steady_clock::time_point last = std::chrono::steady_clock::now();
+		while(true)
+		{
+			if(!syncRequired(last))
+			{
+				if(m_stop)
+				{
+					break;
+				}
+				if(m_policy == DURABLE_PERIODIC)
+				{
+					m_request.wait_until(lock, last + m_period);
+				}
+				else
+				{
+					m_request.wait(lock);
+				}
+				continue;
+			}
+
+			std::vector<int> closed;
+			closed.swap(m_closed);
+			int current = m_current; // Only closed by this thread once moved to m_closed
+			unsigned long long target = m_position;
+			unsigned long long batch = m_waiters;
+			lock.unlock();
+
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			bool synced = true;
+			for(size_t i = 0; i < closed.size(); ++i) // Previous files first, data is only durable once all of them are
+			{
+				synced = fdatasync(closed[i]) == 0 && synced;
+				close(closed[i]);
+			}
+			if(current >= 0)
+			{
+				synced = fdatasync(current) == 0 && synced;
+			}
+			last = std::chrono::steady_clock::now();
+			unsigned long long elapsed = std::chrono::duration_cast<std::chrono::microseconds>(last - start).count();
+
+			lock.lock();
+			++m_stats.m_syncNb;
+			m_stats.m_syncTime += elapsed;
+			m_stats.m_maxSyncTime = std::max(m_stats.m_maxSyncTime, elapsed);
+			if(synced)
+			{
+				if(target > m_durable)
+				{
+					m_stats.m_bytes += target - m_durable;
+					m_durable = target;
+				}
+				m_stats.m_maxBatch = std::max(m_stats.m_maxBatch, batch);
+			}
+			else
+			{
+#if DEBUG
+				std::cerr << "Could not flush file to disk" << std::endl;
+#endif
+				m_failed = true;
+			}
+			m_synced.notify_all();
+		}
+	}
+}
+
+//  ______________________________
+// |                              |
+// |    ______________________    |       
+// |   |                      |   |
+// |   |         sign         |   |
+// |   |        coding        |   |
+// |   |        dw@rf         |   |
+// |   |         1.0          |   |
+// |   |______________________|   |
+// |                              |
+// |______________________________|
+//               |  |           
+//               |  |             
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |__|
@@ -0,0 +1,350 @@
+/*!
+ * @file fileJoiner.cpp
+ * @brief Class used to process the files written by fileSplitter in parallel
+ * @author Sign Coding Dwarf
+ * @version 1.0
+ * @date 19 October 2026
+ *
+ * Implementation of the class discovering the files written by a fileSplitter and giving them to a pool of threads.
+ *
+ */
+
+/* 
+Copyright 2016 SignCodingDwarf
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "fileJoiner.h"
+#include "splitManifest.h"
+#include "segmentCompressor.h"
+
+#include <iostream>
+#include <cstring>
+#include <cerrno>
+#include <cstdlib>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <utility>
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace dwf_utils
+{
+	fileJoiner::fileJoiner(std::string baseName, std::string extension, unsigned int threadNb, unsigned long long unitSize) : m_baseName(baseName), m_extension(extension), m_threadNb(threadNb), m_unitSize(unitSize), m_segments(), m_units()
+	{
+		if(m_extension.empty() || m_extension[0] != '.') // Same naming as fileSplitter
+		{
+			m_extension = "." + m_extension;
+		}
+		if(m_threadNb == 0)
+		{
+			m_threadNb = std::max(1u, std::thread::hardware_concurrency());
+		}
+		discover();
+	}
+
+	fileJoiner::~fileJoiner()
+	{
+	}
+
+	int fileJoiner::discover()
+	{
+		m_segments.clear();
+		m_units.clear();
+
+		std::vector<segmentInfo> manifest;
+		bool listed = loadManifest(manifestName(m_baseName), manifest) == EXEC_SUCCESS;
+		if(listed) // Only complete files are listed
+		{
+			for(size_t i = 0; i < manifest.size(); ++i)
+			{
+				m_segments.push_back(manifest[i].m_name);
+			}
+		}
+		else if(listDirectory(m_segments) == EXEC_FAILURE)
+		{
+			return EXEC_FAILURE;
+		}
+
+		for(size_t s = 0; s < m_segments.size(); ++s)
+		{
+			struct stat info;
+			if(stat(m_segments[s].c_str(), &info) != 0)
+			{
+				std::string compressed;
+				if(listed && findCompressed(m_segments[s], compressed) == EXEC_SUCCESS) // Size is only known once decompressed
+				{
+					unit u = {s, 0, ~0ULL};
+					m_units.push_back(u);
+					continue;
+				}
+				if(listed) // Complete file, its data must not be silently skipped
+				{
+#if DEBUG
+					std::cerr << "File " << m_segments[s] << " of the manifest is missing" << std::endl;
+#endif
+					m_units.clear();
+					return EXEC_FAILURE;
+				}
+				continue; // Removed since listed, processed as an empty file
+			}
+			unsigned long long size = static_cast<unsigned long long>(info.st_size);
+			unsigned long long unitNb = m_unitSize > 0 ? std::max(1ULL, size / m_unitSize) : 1; // Files slightly bigger than units do not get a tiny last unit
+			for(unsigned long long i = 0; i < unitNb && size > 0; ++i)
+			{
+				unit u = {s, size * i / unitNb, size * (i + 1) / unitNb};
+				m_units.push_back(u);
+			}
+		}
+		return EXEC_SUCCESS;
+	}
+
+	size_t fileJoiner::getSegmentNb() const
+	{
+		return m_segments.size();
+	}
+
+	std::string const& fileJoiner::getSegment(size_t i) const
+	{
+		return m_segments.at(i);
+	}
+
+	size_t fileJoiner::getUnitNb() const
+	{
+		return m_units.size();
+	}
+
+	int fileJoiner::forEach(std::function<void(segmentView const&)> task)
+	{
+		std::atomic<size_t> next(0);
+		std::atomic<bool> failed(false);
+		auto worker = [this, &task, &next, &failed]()
+		{
+			size_t index;
+			while((index = next.fetch_add(1)) < m_units.size()) // Units are taken in order so that file reads stay mostly sequential
+			{
+				if(processUnit(index, task) == EXEC_FAILURE)
+				{
+					failed.store(true);
+				}
+			}
+		};
+
+		std::vector<std::thread> threads;
+		for(unsigned int i = 1; i < std::min<size_t>(m_threadNb, m_units.size()); ++i)
+		{
+			threads.push_back(std::thread(worker));
+		}
+		worker(); // Calling thread also works
+		for(size_t i = 0; i < threads.size(); ++i)
+		{
+			threads[i].join();
+		}
+		return failed.load() ? EXEC_FAILURE : EXEC_SUCCESS;
+	}
+
+	/*!
+	* @brief List files of a directory matching a base name
+	* @param directory : directory to read, ending with a slash, empty for the current directory
+	* @param prefix : beginning of the file names
+	* @param extension : extension of the files
+	* @param found : receives the ids and names of the files
+	* @return EXEC_SUCCESS if directory could be read and EXEC_FAILURE otherwise
+	*
+	*/
+	static int listMatching(std::string const& directory, std::string const& prefix, std::string const& extension, std::vector<std::pair<unsigned long, std::string> >& found)
+	{
+		DIR* dir = opendir(directory.empty() ? "." : directory.c_str());
+		if(dir == NULL)
+		{
+			return EXEC_FAILURE;
+		}
+		struct dirent* entry;
+		while((entry = readdir(dir)) != NULL)
+		{
+			std::string name = entry->d_name;
+			if(name.size() <= prefix.size() + extension.size() || name.compare(0, prefix.size(), prefix) != 0 || name.compare(name.size() - extension.size(), extension.size(), extension) != 0)
+			{
+				continue;
+			}
+			std::string id = name.substr(prefix.size(), name.size() - prefix.size() - extension.size());
+			std::string::size_type separator = id.rfind('_');
+			if(separator != std::string::npos && id.find_first_not_of("0123456789T") == separator) // Time stamped name baseName_<Stamp>_<Id>.extension
+			{
+				id.erase(0, separator + 1);
+			}
+			if(id.find_first_not_of("0123456789") != std::string::npos) // Other base name sharing the prefix
+			{
+				continue;
+			}
+			found.push_back(std::make_pair(strtoul(id.c_str(), NULL, 10), directory + name));
+		}
+		closedir(dir);
+		return EXEC_SUCCESS;
+	}
+
+	int fileJoiner::listDirectory(std::vector<std::string>& names) const
+	{
+		std::string::size_type slash = m_baseName.rfind('/');
+		std::string directory = slash == std::string::npos ? "" : m_baseName.substr(0, slash + 1);
+		std::string prefix = (slash == std::string::npos ? m_baseName : m_baseName.substr(slash + 1)) + "_";
+
+		std::vector<std::pair<unsigned long, std::string> > found;
+		if(listMatching(directory, prefix, m_extension, found) == EXEC_FAILURE)
+		{
+			return EXEC_FAILURE;
+		}
+		DIR* dir = opendir(m_baseName.c_str()); // Subdirectories of fileSplitter m_fanOut option
+		if(dir != NULL)
+		{
+			struct dirent* entry;
+			while((entry = readdir(dir)) != NULL)
+			{
+				std::string name = entry->d_name;
+				if(name.find_first_not_of("0123456789") == std::string::npos)
+				{
+					listMatching(m_baseName + "/" + name + "/", prefix, m_extension, found);
+				}
+			}
+			closedir(dir);
+		}
+
+		std::sort(found.begin(), found.end());
+		names.clear();
+		for(size_t i = 0; i < found.size(); ++i)
+		{
+			names.push_back(found[i].second);
+		}
+		return EXEC_SUCCESS;
+	}
+
+	void fileJoiner::processRange(size_t index, const char* data, size_t size, std::function<void(segmentView const&)> const& task) const
+	{
+		unit const& u = m_units[index];
+		size_t begin = static_cast<size_t>(std::min<unsigned long long>(size, u.m_begin));
+		if(begin > 0) // Line started in previous unit belongs to it
+		{
+			const void* newLine = memchr(data + begin - 1, '\n', size - begin + 1);
+			begin = newLine == NULL ? size : static_cast<const char*>(newLine) - data + 1;
+		}
+		size_t end = static_cast<size_t>(std::min<unsigned long long>(size, u.m_end));
+		if(end < size && end > begin) // Complete last line
+		{
+			const void* newLine = memchr(data + end - 1, '\n', size - end + 1);
+			end = newLine == NULL ? size : static_cast<const char*>(newLine) - data + 1;
+		}
+		if(end > begin)
+		{
+			segmentView view = {u.m_segment, index, begin, data + begin, end - begin};
+			task(view);
+		}
+	}
+
+	int fileJoiner::processUnit(size_t index, std::function<void(segmentView const&)> const& task) const
+	{
+		unit const& u = m_units[index];
+		int fd = open(m_segments[u.m_segment].c_str(), O_RDONLY | O_CLOEXEC);
+		if(fd < 0 && errno == ENOENT) // Compressed since discovery, or before
+		{
+			std::string compressed;
+			std::vector<char> raw;
+			if(findCompressed(m_segments[u.m_segment], compressed) == EXEC_FAILURE || decompressFile(compressed, raw) == EXEC_FAILURE)
+			{
+				return EXEC_FAILURE;
+			}
+			processRange(index, raw.empty() ? NULL : &raw[0], raw.size(), task);
+			return EXEC_SUCCESS;
+		}
+		struct stat info;
+		if(fd < 0 || fstat(fd, &info) != 0)
+		{
+			fd >= 0 && close(fd);
+			return EXEC_FAILURE;
+		}
+		size_t size = static_cast<size_t>(info.st_size);
+		if(u.m_begin >= size) // Truncated since discovery
+		{
+			close(fd);
+			return EXEC_SUCCESS;
+		}
+
+		const char* data = NULL;
+		std::vector<char> copy;
+		void* map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0); // Lazy, only pages of this unit are read
+		if(map != MAP_FAILED)
+		{
+			data = static_cast<const char*>(map);
+			size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+			size_t start = u.m_begin / page * page;
+			madvise(static_cast<char*>(map) + start, std::min<size_t>(size, u.m_end) - start, MADV_SEQUENTIAL);
+		}
+		else // File system without mapping support, read whole file
+		{
+			copy.resize(size);
+			size_t done = 0;
+			while(done < size)
+			{
+				ssize_t got = pread(fd, &copy[done], size - done, done);
+				if(got < 0 && errno == EINTR)
+				{
+					continue;
+				}
+				if(got <= 0)
+				{
+					close(fd);
+					return EXEC_FAILURE;
+				}
+				done += got;
+			}
+			data = &copy[0];
+		}
+		close(fd); // Mapping stays valid
+
+		processRange(index, data, size, task);
+
+		if(map != MAP_FAILED)
+		{
+			munmap(map, size);
+		}
+		return EXEC_SUCCESS;
+	}
+}
+
+//  ______________________________
+// |                              |
+// |    ______________________    |       
+// |   |                      |   |
+// |   |         sign         |   |
+// |   |        coding        |   |
+// |   |        dw@rf         |   |
+// |   |         1.0          |   |
+// |   |______________________|   |
+// |                              |
+// |______________________________|
+//               |  |           
+//               |  |             
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |__|
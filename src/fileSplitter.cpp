@@ -6,7 +6,7 @@
  * @date 15 May 2016
  *
  * Implementation of the class used to store a big set of data in multiple subfiles to get smaller files and avoid too much data loss due to file corruption or bugs.
- * The amount of data to store is determined by the number of call to operator<<. User may also manually trigger a file change.
+ * The amount of data to store is determined by the number of call to operator<< or by the number of bytes written. User may also manually trigger a file change.
  *
  */
 
@@ -27,15 +27,120 @@ limitations under the License.
 */
 
 #include "fileSplitter.h"
+#include "uringEngine.h"
+#include "mmapEngine.h"
+#include "directEngine.h"
+
+#include <chrono>
+#include <climits>
+#include <algorithm>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/stat.h>
 
 namespace dwf_utils
 {
-	fileSplitter::fileSplitter(std::string baseName, std::string extension, unsigned long fileSize) : m_baseName(baseName), m_fileSize(fileSize), m_fileNb(0), m_status(true), m_written(0), m_extension(extension)
+	/*!
+	* @brief Get directory of a file
+	* @param name : name of the file
+	* @return Directory part of name, "." if there is none
+	*
+	*/
+	static std::string parentOf(std::string const& name)
+	{
+		std::string::size_type slash = name.rfind('/');
+		return slash == std::string::npos ? "." : name.substr(0, slash);
+	}
+
+	/*!
+	* @brief Create the missing directories of a file
+	* @param name : name of the file
+	* @return EXEC_SUCCESS if the directory of the file exists and EXEC_FAILURE otherwise
+	*
+	*/
+	static int makeParent(std::string const& name)
+	{
+		std::string directory = parentOf(name);
+		if(mkdir(directory.c_str(), 0755) == 0 || errno == EEXIST)
+		{
+			return EXEC_SUCCESS;
+		}
+		if(errno != ENOENT || directory == name || makeParent(directory) == EXEC_FAILURE)
+		{
+			return EXEC_FAILURE;
+		}
+		return mkdir(directory.c_str(), 0755) == 0 || errno == EEXIST ? EXEC_SUCCESS : EXEC_FAILURE;
+	}
+
+	/*!
+	* @brief Create the engine requested by fileSplitter options
+	* @param options : options of the fileSplitter
+	* @param fileSize : file size limit of the fileSplitter
+	* @return The created engine
+	*
+	*/
+	static std::unique_ptr<writeEngine> createEngine(splitterOptions const& options, unsigned long fileSize)
+	{
+		size_t bufferSize = SEGMENTBUF_DEFAULT_SIZE;
+		if(options.m_writer == WRITER_URING)
+		{
+			bufferSize = URING_BUFFER_SIZE;
+		}
+		else if(options.m_writer == WRITER_DIRECT)
+		{
+			bufferSize = DIRECT_BUFFER_SIZE;
+		}
+		else if(options.m_writer == WRITER_MMAP)
+		{
+			bufferSize = options.m_criterion == SPLIT_BYTES && fileSize > 0 ? fileSize + MMAP_WINDOW_SIZE : MMAP_SEGMENT_SIZE; // Whole file reserved at once, last record may cross the limit
+		}
+		if(options.m_bufferSize > 0 && options.m_writer != WRITER_MMAP)
+		{
+			bufferSize = options.m_bufferSize;
+		}
+		return createWriteEngine(options.m_writer, bufferSize);
+	}
+
+	/*!
+	* @brief Read the clock used for time rotation
+	* @return Monotonic time in nanoseconds
+	*
+	* Uses a clock that does not require a system call. Its resolution is a few milliseconds.
+	*
+	*/
+	static unsigned long long monotonicTime()
+	{
+		timespec now;
+#ifdef CLOCK_MONOTONIC_COARSE
+		clock_gettime(CLOCK_MONOTONIC_COARSE, &now); // Read from memory shared with the kernel
+#else
+		clock_gettime(CLOCK_MONOTONIC, &now);
+#endif
+		return static_cast<unsigned long long>(now.tv_sec) * 1000000000ULL + now.tv_nsec;
+	}
+
+	fileSplitter::fileSplitter(std::string baseName, std::string extension, unsigned long fileSize, splitterOptions const& options) : m_buf(createEngine(options, fileSize)), m_file(&m_buf), m_options(options), m_baseName(baseName), m_extension(extension), m_fileSize(fileSize), m_written(0), m_fileNb(0), m_status(true), m_recordDepth(0), m_worker(), m_next(), m_nextId(0), m_nextName(), m_stamp(0), m_periodEnd(0), m_durability(), m_compressor(), m_durableBase(0), m_reported(0), m_manifestFd(-1), m_segment(), m_recordNb(0), m_index(), m_indexCountdown(0), m_live(), m_liveBytes(0), m_indexFd(-1), m_counters(), m_bytesBase(0)
 	{
 		addDot();
-		std::string fileName = m_baseName + "_0" + m_extension;
-		m_file.open(fileName);
-		if(!m_file)
+		if(m_options.m_prepareNext)
+		{
+			m_worker.reset(new workerThread());
+		}
+		if(m_options.m_manifest)
+		{
+			m_manifestFd = ::open(manifestName(m_baseName).c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_APPEND | O_CLOEXEC, 0644);
+		}
+		if(m_options.m_durability != DURABLE_NONE)
+		{
+			m_durability.reset(new durabilityManager(m_options.m_durability, m_options.m_durableBytes, m_options.m_durablePeriod));
+		}
+		if(m_options.m_compression != COMPRESS_NONE)
+		{
+			m_compressor.reset(new segmentCompressor(m_options.m_compression, m_options.m_compressQueue, m_options.m_syncOnClose));
+		}
+		if(openFile(0) == EXEC_FAILURE)
 		{
 			m_status = false;
 		}
@@ -43,36 +148,530 @@ namespace dwf_utils
 
 	fileSplitter::~fileSplitter()
 	{
-		if(m_file)
+		closeFile();
+		m_durability.reset(); // Flush data not durable yet
+		m_worker.reset(); // Wait for background operations
+		discardNext();
+		m_compressor.reset(); // Compress files already queued
+		if(m_manifestFd >= 0)
 		{
-			m_file.close();
-		}	
+			::close(m_manifestFd);
+		}
 	}
 
 	int fileSplitter::changeFile()
 	{
-		if(m_file)
-		{
-			m_file.close();
-		}
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		closeFile();
 		++ m_fileNb;
 		m_written = 0;
-		std::string fileName = m_baseName + "_" + toString(m_fileNb) + m_extension;
-		m_file.open(fileName.c_str());
-		if(!m_file)
+		if(openFile(m_fileNb) == EXEC_FAILURE)
 		{
 			m_status = false;
 			return EXEC_FAILURE;
 		}
+		m_counters.addRotation(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
 		
 		return EXEC_SUCCESS;
 	}
 
+	void fileSplitter::beginRecord()
+	{
+		if(m_options.m_rotatePeriod > 0 && m_recordDepth == 0 && m_status)
+		{
+			rotateOnPeriod();
+		}
+		++m_recordDepth;
+	}
+
+	int fileSplitter::commitRecord()
+	{
+		if(m_recordDepth == 0)
+		{
+			return EXEC_FAILURE;
+		}
+		--m_recordDepth;
+		if(m_recordDepth == 0 && m_status)
+		{
+			updateStats();
+			bool limitReached = m_options.m_criterion == SPLIT_BYTES ? m_buf.getBytes() >= m_fileSize : m_written >= m_fileSize;
+			if(limitReached)
+			{
+				changeFile() == EXEC_FAILURE && (m_status = false);
+			}
+		}
+		return m_status ? EXEC_SUCCESS : EXEC_FAILURE;
+	}
+
 	bool fileSplitter::getStatus() const
 	{
 		return m_status;
 	}
 
+	int fileSplitter::flush()
+	{
+		if(!m_status || !m_file.flush())
+		{
+			return EXEC_FAILURE;
+		}
+		return EXEC_SUCCESS;
+	}
+
+	unsigned long long fileSplitter::requestDurability()
+	{
+		if(!m_durability)
+		{
+			return 0;
+		}
+		flush();
+		m_buf.drain() == EXEC_FAILURE && (m_status = false);
+		m_reported = m_buf.getCommitted();
+		unsigned long long ticket = m_durableBase + m_buf.getBytes();
+		m_durability->update(ticket);
+		return ticket;
+	}
+
+	int fileSplitter::waitDurable(unsigned long long ticket)
+	{
+		if(!m_durability)
+		{
+			return EXEC_FAILURE;
+		}
+		return m_durability->waitDurable(ticket);
+	}
+
+	durabilityStats fileSplitter::getDurabilityStats() const
+	{
+		return m_durability ? m_durability->getStats() : durabilityStats();
+	}
+
+	compressionStats fileSplitter::getCompressionStats() const
+	{
+		return m_compressor ? m_compressor->getStats() : compressionStats();
+	}
+
+	int fileSplitter::writeFrame(const char* data, size_t size)
+	{
+		if(!m_status || size > FRAME_MAX_SIZE)
+		{
+			return EXEC_FAILURE;
+		}
+		char header[FRAME_HEADER_SIZE];
+		frameHeader(data, size, header);
+		beginRecord();
+		if(m_options.m_manifest) // Binary frames are records without line ends
+		{
+			countRecord();
+		}
+		m_file.write(header, FRAME_HEADER_SIZE);
+		m_file.write(data, size);
+		++m_written;
+		trackDurability();
+		return commitRecord();
+	}
+
+	int fileSplitter::ingest(int fd, unsigned long long size, unsigned long long& moved)
+	{
+		moved = 0;
+		bool counted = false; // Data moved into the current file is already a record
+		while(m_status && moved < size)
+		{
+			if(m_options.m_rotatePeriod > 0 && m_recordDepth == 0)
+			{
+				unsigned long fileNb = m_fileNb;
+				rotateOnPeriod();
+				counted = counted && fileNb == m_fileNb;
+			}
+			unsigned long long chunk = size - moved;
+			if(m_options.m_criterion == SPLIT_BYTES && m_recordDepth == 0 && m_fileSize > 0)
+			{
+				if(m_buf.getBytes() >= m_fileSize) // Current file may already be full of formatted data
+				{
+					changeFile() == EXEC_FAILURE && (m_status = false);
+					counted = false;
+					continue;
+				}
+				chunk = std::min(chunk, m_fileSize - m_buf.getBytes());
+			}
+			if(!counted && m_options.m_manifest)
+			{
+				countLine();
+			}
+
+			long long got = m_buf.transfer(fd, static_cast<size_t>(std::min<unsigned long long>(chunk, SSIZE_MAX)));
+			if(got < 0)
+			{
+				if(errno == EAGAIN || errno == EWOULDBLOCK) // Source has no data yet
+				{
+					return EXEC_SUCCESS;
+				}
+				m_status = false;
+				return EXEC_FAILURE;
+			}
+			if(got == 0) // End of source data
+			{
+				break;
+			}
+			moved += got;
+			if(!counted)
+			{
+				++m_written;
+				updateStats();
+				counted = true;
+			}
+			else
+			{
+				m_counters.m_bytes.store(m_bytesBase + m_buf.getBytes(), std::memory_order_relaxed);
+			}
+			trackDurability();
+			if(splitRequired())
+			{
+				changeFile() == EXEC_FAILURE && (m_status = false);
+				counted = false;
+			}
+		}
+		return m_status ? EXEC_SUCCESS : EXEC_FAILURE;
+	}
+
+	splitterStats fileSplitter::getStats() const
+	{
+		splitterStats stats;
+		m_counters.load(stats);
+		stats.m_durability = getDurabilityStats();
+		stats.m_compression = getCompressionStats();
+		return stats;
+	}
+
+	void fileSplitter::indexRecord()
+	{
+		unsigned long long now = manifestTime();
+		if(m_recordNb == m_segment.m_firstRecord)
+		{
+			m_segment.m_firstTime = now;
+		}
+		m_segment.m_lastTime = now;
+		m_indexCountdown = m_options.m_indexInterval > 0 ? m_options.m_indexInterval : ~0ULL; // First record of each file is always taken into account
+		if(m_options.m_indexInterval > 0)
+		{
+			indexEntry entry = {m_recordNb, m_buf.getBytes(), now};
+			m_index.push_back(entry);
+			if(m_index.size() >= INDEX_FLUSH_ENTRIES)
+			{
+				flushIndex();
+			}
+		}
+	}
+
+	void fileSplitter::flushIndex()
+	{
+		if(m_index.empty())
+		{
+			return;
+		}
+		if(m_indexFd < 0) // Created with the first entries
+		{
+			m_indexFd = ::open(indexName(m_segment.m_name).c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_APPEND | O_CLOEXEC, 0644);
+		}
+		if(appendIndex(m_indexFd, m_index) == EXEC_FAILURE)
+		{
+#if DEBUG
+			std::cerr << "Could not write index of " << m_segment.m_name << std::endl;
+#endif
+		}
+		m_index.clear();
+	}
+
+	void fileSplitter::rotateOnPeriod()
+	{
+		if(monotonicTime() < m_periodEnd)
+		{
+			return;
+		}
+		if(m_buf.getBytes() > 0)
+		{
+			if(m_options.m_criterion != SPLIT_BYTES || m_buf.endsLine()) // Otherwise checked again before next insertion
+			{
+				changeFile() == EXEC_FAILURE && (m_status = false);
+			}
+			return;
+		}
+		startPeriod(); // Nothing to close, only the name changes
+		std::string name = segmentName(m_segment.m_id, m_stamp);
+		if(name != m_segment.m_name && rename(m_segment.m_name.c_str(), name.c_str()) == 0)
+		{
+			m_segment.m_name = name;
+		}
+	}
+
+	void fileSplitter::startPeriod()
+	{
+		timespec now;
+		clock_gettime(CLOCK_REALTIME, &now);
+		if(m_options.m_rotatePeriod == 0)
+		{
+			m_stamp = now.tv_sec;
+			return;
+		}
+		time_t stamp = now.tv_sec - now.tv_sec % m_options.m_rotatePeriod;
+		if(m_periodEnd != 0 && stamp <= m_stamp) // Coarse clock reached the end of the period slightly before the real time clock
+		{
+			stamp = m_stamp + m_options.m_rotatePeriod;
+		}
+		m_stamp = stamp;
+		long long remaining = static_cast<long long>(stamp + m_options.m_rotatePeriod - now.tv_sec) * 1000000000LL - now.tv_nsec;
+		m_periodEnd = monotonicTime() + (remaining > 0 ? remaining : 0);
+	}
+
+	std::string fileSplitter::segmentName(unsigned long id, time_t stamp) const
+	{
+		std::string prefix = m_baseName;
+		if(m_options.m_fanOut > 0)
+		{
+			std::string::size_type slash = m_baseName.rfind('/');
+			prefix += "/" + toString(id / m_options.m_fanOut) + "/" + (slash == std::string::npos ? m_baseName : m_baseName.substr(slash + 1));
+		}
+		if(!m_options.m_timeNames)
+		{
+			return prefix + "_" + toString(id) + m_extension;
+		}
+		struct tm date;
+		char buffer[32];
+		gmtime_r(&stamp, &date);
+		strftime(buffer, sizeof(buffer), "%Y%m%dT%H%M%S", &date); // Sorted like time
+		return prefix + "_" + buffer + "_" + toString(id) + m_extension;
+	}
+
+	int fileSplitter::createFile(std::string const& name, std::vector<std::string> const& victims) const
+	{
+		bool recycled = false;
+		for(size_t i = 0; i < victims.size(); ++i)
+		{
+			if(!m_compressor && !recycled && (rename(victims[i].c_str(), name.c_str()) == 0 || (m_options.m_fanOut > 0 && errno == ENOENT && makeParent(name) == EXEC_SUCCESS && rename(victims[i].c_str(), name.c_str()) == 0))) // Blocks of the oldest file stay allocated
+			{
+				recycled = true;
+			}
+			removeFile(victims[i], name); // Only index and subdirectory are left after a rename
+		}
+		int fd = m_buf.create(name, !recycled);
+		if(fd < 0 && m_options.m_fanOut > 0 && errno == ENOENT && makeParent(name) == EXEC_SUCCESS) // First file of a subdirectory
+		{
+			fd = m_buf.create(name, !recycled);
+		}
+		if(fd >= 0 && recycled) // Previous content must not be read back, e.g. as valid frames after a crash
+		{
+			bool cleared = false;
+#if defined(__linux__) && defined(FALLOC_FL_ZERO_RANGE)
+			struct stat st;
+			cleared = fstat(fd, &st) == 0 && (st.st_size == 0 || fallocate(fd, FALLOC_FL_ZERO_RANGE | FALLOC_FL_KEEP_SIZE, 0, st.st_size) == 0); // Blocks stay allocated
+#endif
+			if(!cleared)
+			{
+				cleared = ftruncate(fd, 0) == 0;
+			}
+			if(!cleared)
+			{
+#if DEBUG
+				std::cerr << "Could not clear previous content of " << name << std::endl;
+#endif
+				close(fd);
+				fd = -1;
+			}
+		}
+#ifdef __linux__
+		if(fd >= 0 && m_options.m_preallocate > 0)
+		{
+			fallocate(fd, FALLOC_FL_KEEP_SIZE, 0, m_options.m_preallocate); // Failure only means the file system cannot reserve space
+		}
+#endif
+		return fd;
+	}
+
+	int fileSplitter::openFile(unsigned long id)
+	{
+		if(m_options.m_rotatePeriod == 0 || monotonicTime() >= m_periodEnd) // A file change on size keeps the current period
+		{
+			startPeriod();
+		}
+		std::string name = segmentName(id, m_stamp);
+		int fd = -1;
+		if(m_next.valid() && m_nextId == id)
+		{
+			fd = m_next.get(); // Usually ready for a long time
+			if(fd >= 0 && name != m_nextName && (m_options.m_rotatePeriod == 0 || rename(m_nextName.c_str(), name.c_str()) != 0)) // Prepared before the period changed, or stamped when prepared without period
+			{
+				name = m_nextName;
+			}
+			std::vector<std::string> victims = fd >= 0 ? selectVictims(1) : std::vector<std::string>(); // Only now that the prepared file is used
+			if(!victims.empty())
+			{
+				m_worker->post([this, victims, name]() { for(size_t i = 0; i < victims.size(); ++i) removeFile(victims[i], name); });
+			}
+		}
+		else
+		{
+			discardNext();
+			fd = createFile(name, selectVictims(1));
+		}
+
+		if(m_buf.attach(fd) == EXEC_FAILURE)
+		{
+			if(fd >= 0) // File was created but the engine cannot write it
+			{
+				::close(fd);
+				unlink(name.c_str());
+			}
+			splitterCounters::add(m_counters.m_openFailures, 1);
+			m_file.setstate(std::ios_base::badbit);
+			return EXEC_FAILURE;
+		}
+		m_file.clear();
+		m_segment.m_id = id;
+		m_segment.m_name = name;
+		m_segment.m_firstRecord = m_recordNb;
+		m_segment.m_firstTime = 0;
+		m_segment.m_lastTime = 0;
+		m_indexCountdown = 0;
+		if(m_durability)
+		{
+			m_durability->attach(fd);
+		}
+
+		if(m_worker)
+		{
+			std::shared_ptr<std::promise<int> > next = std::make_shared<std::promise<int> >();
+			m_next = next->get_future();
+			m_nextId = id + 1;
+			m_nextName = segmentName(m_nextId, m_stamp); // Renamed when opened if the period changes
+			std::string nextName = m_nextName;
+			m_worker->post([this, next, nextName]() { next->set_value(createFile(nextName, std::vector<std::string>())); }); // Files kept are only removed if this one is used
+		}
+		return EXEC_SUCCESS;
+	}
+
+	void fileSplitter::closeFile()
+	{
+		unsigned long long size = m_buf.getBytes();
+		if(m_options.m_manifest && m_buf.isOpen())
+		{
+			flushIndex();
+			if(m_indexFd >= 0)
+			{
+				::close(m_indexFd);
+				m_indexFd = -1;
+			}
+		}
+		int fd = m_buf.detach();
+		if(fd < 0)
+		{
+			return;
+		}
+		m_bytesBase += size;
+		if(m_options.m_manifest) // File is complete, readers may use it
+		{
+			if(m_recordNb > m_segment.m_firstRecord) // Bound of the time of records written since last index entry
+			{
+				m_segment.m_lastTime = manifestTime();
+			}
+			m_segment.m_recordNb = m_recordNb - m_segment.m_firstRecord;
+			m_segment.m_bytes = size;
+			appendManifest(m_manifestFd, m_segment, manifestDirectory(manifestName(m_baseName))); // One small write per file
+		}
+		if(retention())
+		{
+			m_segment.m_bytes = size;
+			m_live.push_back(m_segment);
+			m_liveBytes += size;
+		}
+		if(m_durability) // Whole file is written, it is flushed in background from now on
+		{
+			m_durableBase += size;
+			m_reported = 0;
+			m_durability->update(m_durableBase);
+		}
+		if(m_worker)
+		{
+			std::string name = m_segment.m_name;
+			m_worker->post([this, fd, size, name]() { releaseFile(fd, size, name); });
+		}
+		else
+		{
+			releaseFile(fd, size, m_segment.m_name);
+		}
+	}
+
+	void fileSplitter::releaseFile(int fd, unsigned long long size, std::string const& name) const
+	{
+		if(m_options.m_preallocate > 0 || retention())
+		{
+			ftruncate(fd, size); // Give back reserved blocks that were not used, remove end of reused content
+		}
+		bool failed = m_options.m_syncOnClose && fdatasync(fd) != 0;
+		if(::close(fd) != 0 || failed)
+		{
+#if DEBUG
+			std::cerr << "Could not close file" << std::endl;
+#endif
+			m_counters.m_closeFailures.fetch_add(1, std::memory_order_relaxed); // Background thread and writer may both release files
+		}
+		if(m_compressor)
+		{
+			m_compressor->submit(name); // Never waits, file is kept raw if too many files are waiting
+		}
+	}
+
+	std::vector<std::string> fileSplitter::selectVictims(unsigned int pending)
+	{
+		std::vector<std::string> victims;
+		if(!retention())
+		{
+			return victims;
+		}
+		unsigned long long estimate = m_options.m_criterion == SPLIT_BYTES ? m_fileSize : (m_live.empty() ? 0 : m_live.back().m_bytes); // Size of files not complete yet
+		while(!m_live.empty() && ((m_options.m_maxSegments > 0 && m_live.size() + pending > m_options.m_maxSegments) || (m_options.m_maxBytes > 0 && m_liveBytes + pending * estimate > m_options.m_maxBytes)))
+		{
+			victims.push_back(m_live.front().m_name);
+			m_liveBytes -= m_live.front().m_bytes;
+			m_live.pop_front();
+		}
+		if(!victims.empty() && m_manifestFd >= 0) // Readers must not look for files about to be reused
+		{
+			writeManifest(manifestName(m_baseName), m_live);
+			::close(m_manifestFd);
+			m_manifestFd = ::open(manifestName(m_baseName).c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+		}
+		return victims;
+	}
+
+	void fileSplitter::removeFile(std::string const& name, std::string const& created) const
+	{
+		unlink(indexName(name).c_str());
+		std::string directory = m_options.m_fanOut > 0 && parentOf(name) != parentOf(created) ? parentOf(name) : std::string(); // Only removed with the last file of the subdirectory
+		if(m_compressor) // File may still be waiting for compression
+		{
+			m_compressor->remove(name, directory);
+			return;
+		}
+		unlink(name.c_str());
+		if(!directory.empty())
+		{
+			rmdir(directory.c_str());
+		}
+	}
+
+	void fileSplitter::discardNext()
+	{
+		if(!m_next.valid())
+		{
+			return;
+		}
+		int fd = m_next.get();
+		if(fd >= 0)
+		{
+			::close(fd);
+			unlink(m_nextName.c_str());
+		}
+	}
+
 	void fileSplitter::addDot()
 	{
 		if(m_extension[0] != '.') // Extension should start by a dot
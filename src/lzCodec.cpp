@@ -0,0 +1,250 @@
+/*!
+ * @file lzCodec.cpp
+ * @brief Functions used to compress data without external library
+ * @author Sign Coding Dwarf
+ * @version 1.0
+ * @date 19 October 2026
+ *
+ * Implementation of the LZ77 block codec.
+ * A sequence is a token giving the literal and match lengths on 4 bits each, extra length bytes, the literals, the match offset on 2 bytes and extra match length bytes. The last sequence only has literals.
+ *
+ */
+
+/*
+Copyright 2016 SignCodingDwarf
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "lzCodec.h"
+#include <cstring>
+#include <stdint.h>
+
+/*!
+* @def LZ_MIN_MATCH
+* @brief Length of the shortest match
+*/
+#define LZ_MIN_MATCH 4
+
+/*!
+* @def LZ_MAX_OFFSET
+* @brief Largest distance of a match
+*/
+#define LZ_MAX_OFFSET 65535
+
+/*!
+* @def LZ_END_LITERALS
+* @brief Number of bytes at the end of a block always written as literals
+*/
+#define LZ_END_LITERALS 12
+
+namespace dwf_utils
+{
+	/*!
+	* @brief Read 4 bytes
+	* @param data : position of the bytes
+	* @return The bytes as an integer
+	*
+	*/
+	static inline uint32_t read32(const char* data)
+	{
+		uint32_t value;
+		memcpy(&value, data, sizeof(value));
+		return value;
+	}
+
+	/*!
+	* @brief Hash 4 bytes
+	* @param value : the bytes
+	* @return Index in the hash table
+	*
+	*/
+	static inline uint32_t lzHash(uint32_t value)
+	{
+		return (value * 2654435761U) >> (32 - LZ_HASH_BITS);
+	}
+
+	/*!
+	* @brief Write the extra bytes of a length
+	* @param out : vector receiving the bytes
+	* @param length : part of the length not held by the token
+	*
+	*/
+	static void writeLength(std::vector<char>& out, size_t length)
+	{
+		while(length >= 255)
+		{
+			out.push_back(static_cast<char>(255));
+			length -= 255;
+		}
+		out.push_back(static_cast<char>(length));
+	}
+
+	/*!
+	* @brief Read the extra bytes of a length
+	* @param data : compressed block
+	* @param size : size of the compressed block
+	* @param position : position of the first extra byte, moved after the last one
+	* @param length : length to which extra bytes are added
+	* @return EXEC_SUCCESS if the bytes are in the block and EXEC_FAILURE otherwise
+	*
+	*/
+	static int readLength(const unsigned char* data, size_t size, size_t& position, size_t& length)
+	{
+		unsigned char byte = 255;
+		while(byte == 255)
+		{
+			if(position >= size)
+			{
+				return EXEC_FAILURE;
+			}
+			byte = data[position++];
+			length += byte;
+		}
+		return EXEC_SUCCESS;
+	}
+
+	/*!
+	* @brief Write a sequence
+	* @param out : vector receiving the sequence
+	* @param literals : literals of the sequence
+	* @param literalNb : number of literals
+	* @param offset : distance of the match, 0 for the last sequence
+	* @param matchLength : length of the match
+	*
+	*/
+	static void writeSequence(std::vector<char>& out, const char* literals, size_t literalNb, size_t offset, size_t matchLength)
+	{
+		size_t match = offset > 0 ? matchLength - LZ_MIN_MATCH : 0;
+		out.push_back(static_cast<char>(((literalNb < 15 ? literalNb : 15) << 4) | (match < 15 ? match : 15)));
+		if(literalNb >= 15)
+		{
+			writeLength(out, literalNb - 15);
+		}
+		out.insert(out.end(), literals, literals + literalNb);
+		if(offset == 0)
+		{
+			return;
+		}
+		out.push_back(static_cast<char>(offset & 0xFF));
+		out.push_back(static_cast<char>(offset >> 8));
+		if(match >= 15)
+		{
+			writeLength(out, match - 15);
+		}
+	}
+
+	void lzCompress(const char* data, size_t size, std::vector<char>& out)
+	{
+		std::vector<uint32_t> table(1 << LZ_HASH_BITS, 0);
+		size_t anchor = 0;
+		size_t position = 0;
+		size_t limit = size > LZ_END_LITERALS ? size - LZ_END_LITERALS : 0;
+		out.reserve(out.size() + size / 2);
+		while(position < limit)
+		{
+			uint32_t sequence = read32(data + position);
+			uint32_t hash = lzHash(sequence);
+			size_t candidate = table[hash];
+			table[hash] = static_cast<uint32_t>(position);
+			if(candidate >= position || position - candidate > LZ_MAX_OFFSET || read32(data + candidate) != sequence)
+			{
+				position += 1 + ((position - anchor) >> 6); // Move faster through incompressible data
+				continue;
+			}
+			size_t length = LZ_MIN_MATCH;
+			while(position + length < size - LZ_END_LITERALS / 2 && data[candidate + length] == data[position + length])
+			{
+				++length;
+			}
+			writeSequence(out, data + anchor, position - anchor, position - candidate, length);
+			position += length;
+			anchor = position;
+		}
+		writeSequence(out, data + anchor, size - anchor, 0, 0);
+	}
+
+	int lzDecompress(const char* data, size_t size, char* out, size_t rawSize)
+	{
+		const unsigned char* in = reinterpret_cast<const unsigned char*>(data);
+		size_t position = 0;
+		size_t written = 0;
+		while(position < size)
+		{
+			unsigned char token = in[position++];
+			size_t literalNb = token >> 4;
+			if(literalNb == 15 && readLength(in, size, position, literalNb) == EXEC_FAILURE)
+			{
+				return EXEC_FAILURE;
+			}
+			if(literalNb > size - position || literalNb > rawSize - written)
+			{
+				return EXEC_FAILURE;
+			}
+			memcpy(out + written, data + position, literalNb);
+			position += literalNb;
+			written += literalNb;
+			if(position == size) // Last sequence
+			{
+				break;
+			}
+
+			if(size - position < 2)
+			{
+				return EXEC_FAILURE;
+			}
+			size_t offset = in[position] | (in[position + 1] << 8);
+			position += 2;
+			size_t length = token & 15;
+			if(length == 15 && readLength(in, size, position, length) == EXEC_FAILURE)
+			{
+				return EXEC_FAILURE;
+			}
+			length += LZ_MIN_MATCH;
+			if(offset == 0 || offset > written || length > rawSize - written)
+			{
+				return EXEC_FAILURE;
+			}
+			for(size_t i = 0; i < length; ++i) // Byte by byte, match may overlap the copied data
+			{
+				out[written + i] = out[written + i - offset];
+			}
+			written += length;
+		}
+		return written == rawSize ? EXEC_SUCCESS : EXEC_FAILURE;
+	}
+}
+
+//  ______________________________
+// |                              |
+// |    ______________________    |       
+// |   |                      |   |
+// |   |         sign         |   |
+// |   |        coding        |   |
+// |   |        dw@rf         |   |
+// |   |         1.0          |   |
+// |   |______________________|   |
+// |                              |
+// |______________________________|
+//               |  |           
+//               |  |             
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |__|
@@ -0,0 +1,206 @@
+/*!
+ * @file mmapEngine.cpp
+ * @brief Class used to write split files through a memory mapping
+ * @author Sign Coding Dwarf
+ * @version 1.0
+ * @date 19 October 2026
+ *
+ * Implementation of the write engine reserving each file on disk and mapping it in memory so that writing a record is a plain copy without any system call.
+ *
+ */
+
+/* 
+Copyright 2016 SignCodingDwarf
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "mmapEngine.h"
+
+#include <iostream>
+#include <algorithm>
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+namespace dwf_utils
+{
+	mmapEngine::mmapEngine(size_t mapSize) : writeEngine(), m_mapSize(mapSize), m_map(NULL), m_mapped(0), m_writtenBack(0), m_failed(false), m_scratch(BUFSIZ)
+	{
+		size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+		m_mapSize = std::max(page, (mapSize + page - 1) / page * page); // Mappings are made of whole pages
+	}
+
+	mmapEngine::~mmapEngine()
+	{
+		if(m_fd >= 0)
+		{
+			detach();
+		}
+	}
+
+	int mmapEngine::openFlags() const
+	{
+		return O_RDWR;
+	}
+
+	int mmapEngine::attach(int fd)
+	{
+		if(m_fd >= 0)
+		{
+			detach();
+		}
+		if(writeEngine::attach(fd) == EXEC_FAILURE)
+		{
+			return EXEC_FAILURE;
+		}
+		m_writtenBack = 0;
+		m_failed = false;
+		if(grow() == EXEC_FAILURE)
+		{
+			m_fd = -1;
+			return EXEC_FAILURE;
+		}
+		return EXEC_SUCCESS;
+	}
+
+	int mmapEngine::detach()
+	{
+		if(m_fd < 0)
+		{
+			return EXEC_SUCCESS;
+		}
+		int result = m_failed ? EXEC_FAILURE : EXEC_SUCCESS;
+		unmap(); // Dirty pages stay in the page cache and are written back by the system
+		if(ftruncate(m_fd, m_offset) != 0) // Remove reserved bytes that were not used
+		{
+			result = EXEC_FAILURE;
+		}
+		m_fd = -1;
+		m_offset = 0;
+		return result;
+	}
+
+	char* mmapEngine::getBuffer(size_t& size)
+	{
+		if(m_fd >= 0 && !m_failed && m_offset == m_mapped && grow() == EXEC_FAILURE)
+		{
+			m_failed = true;
+		}
+		if(m_map == NULL || m_failed)
+		{
+			size = m_scratch.size();
+			return &m_scratch[0];
+		}
+		size = std::min<size_t>(MMAP_WINDOW_SIZE - m_offset % MMAP_WINDOW_SIZE, m_mapped - m_offset); // Window ends trigger write back requests
+		return m_map + m_offset;
+	}
+
+	int mmapEngine::commit(size_t size)
+	{
+		if(m_map == NULL || m_failed)
+		{
+			return EXEC_FAILURE;
+		}
+		m_offset += size; // Data is already in the file
+		if(m_offset - m_writtenBack >= MMAP_WINDOW_SIZE)
+		{
+			writeBack();
+		}
+		return EXEC_SUCCESS;
+	}
+
+	int mmapEngine::grow()
+	{
+		size_t length = m_mapped + m_mapSize;
+		int error = posix_fallocate(m_fd, m_mapped, m_mapSize); // Reserve blocks so that page faults cannot fail on a full disk
+		if(error != 0)
+		{
+#if DEBUG
+			std::cerr << "Could not reserve " << m_mapSize << " bytes for mapping" << std::endl;
+#endif
+			return EXEC_FAILURE;
+		}
+
+		void* map = MAP_FAILED;
+#ifdef __linux__
+		if(m_map != NULL)
+		{
+			map = mremap(m_map, m_mapped, length, MREMAP_MAYMOVE); // Mapped pages are kept
+		}
+		else
+		{
+			map = mmap(NULL, length, PROT_WRITE, MAP_SHARED, m_fd, 0);
+		}
+#else
+		unmap();
+		map = mmap(NULL, length, PROT_WRITE, MAP_SHARED, m_fd, 0);
+#endif
+		if(map == MAP_FAILED)
+		{
+			unmap();
+			return EXEC_FAILURE;
+		}
+		m_map = static_cast<char*>(map);
+		m_mapped = length;
+		madvise(m_map, m_mapped, MADV_SEQUENTIAL); // Pages behind the write position are reclaimed first
+		return EXEC_SUCCESS;
+	}
+
+	void mmapEngine::writeBack()
+	{
+		size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+		unsigned long long start = m_writtenBack / page * page;
+#ifdef __linux__
+		sync_file_range(m_fd, start, m_offset - start, SYNC_FILE_RANGE_WRITE); // Start write back without waiting, MS_ASYNC does nothing on Linux
+#else
+		msync(m_map + start, m_offset - start, MS_ASYNC);
+#endif
+		m_writtenBack = m_offset;
+	}
+
+	void mmapEngine::unmap()
+	{
+		if(m_map != NULL)
+		{
+			munmap(m_map, m_mapped);
+		}
+		m_map = NULL;
+		m_mapped = 0;
+	}
+}
+
+//  ______________________________
+// |                              |
+// |    ______________________    |       
+// |   |                      |   |
+// |   |         sign         |   |
+// |   |        coding        |   |
+// |   |        dw@rf         |   |
+// |   |         1.0          |   |
+// |   |______________________|   |
+// |                              |
+// |______________________________|
+//               |  |           
+//               |  |             
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |__|
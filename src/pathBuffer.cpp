@@ -0,0 +1,387 @@
+/*!
+ * @file pathBuffer.cpp
+ * @brief Class used to build paths without heap allocation
+ * @author Sign Coding Dwarf
+ * @version 1.0
+ * @date 19 October 2026
+ *
+ * Implementation of the path type holding usual paths in an inline buffer.
+ *
+ */
+
+/*
+Copyright 2016 SignCodingDwarf
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "pathBuffer.h"
+
+namespace dwf_utils
+{
+	/*!
+	* @brief Know if a component is ".."
+	* @param component : first character of the component
+	* @param size : number of characters of the component
+	* @return TRUE if component is ".." and FALSE otherwise
+	*
+	*/
+	static inline bool isParentComponent(const char* component, size_t size)
+	{
+		return size == 2 && component[0] == '.' && component[1] == '.';
+	}
+
+	/*!
+	* @brief Find the next component of a path
+	* @param path : path
+	* @param size : number of characters of the path
+	* @param position : position from which to search, moved after the component
+	* @param length : receives the number of characters of the component
+	* @return Position of the component, size if there is none left
+	*
+	*/
+	static size_t nextComponent(const char* path, size_t size, size_t& position, size_t& length)
+	{
+		while(position < size && path[position] == '/')
+		{
+			++position;
+		}
+		size_t start = position;
+		while(position < size && path[position] != '/')
+		{
+			++position;
+		}
+		length = position - start;
+		return start;
+	}
+
+	pathBuffer::pathBuffer() : m_data(m_inline), m_size(0), m_capacity(PATH_BUFFER_SIZE - 1)
+	{
+		m_inline[0] = '\0';
+	}
+
+	pathBuffer::pathBuffer(const char* path) : m_data(m_inline), m_size(0), m_capacity(PATH_BUFFER_SIZE - 1)
+	{
+		m_inline[0] = '\0';
+		append(path, strlen(path));
+	}
+
+	pathBuffer::pathBuffer(const char* path, size_t size) : m_data(m_inline), m_size(0), m_capacity(PATH_BUFFER_SIZE - 1)
+	{
+		m_inline[0] = '\0';
+		append(path, size);
+	}
+
+	pathBuffer::pathBuffer(std::string const& path) : m_data(m_inline), m_size(0), m_capacity(PATH_BUFFER_SIZE - 1)
+	{
+		m_inline[0] = '\0';
+		append(path.c_str(), path.size());
+	}
+
+	pathBuffer::pathBuffer(pathBuffer const& other) : m_data(m_inline), m_size(0), m_capacity(PATH_BUFFER_SIZE - 1)
+	{
+		m_inline[0] = '\0';
+		append(other.m_data, other.m_size);
+	}
+
+	pathBuffer::pathBuffer(pathBuffer&& other) : m_data(m_inline), m_size(0), m_capacity(PATH_BUFFER_SIZE - 1)
+	{
+		m_inline[0] = '\0';
+		*this = std::move(other);
+	}
+
+	pathBuffer& pathBuffer::operator=(pathBuffer const& other)
+	{
+		if(this != &other)
+		{
+			assign(other.m_data, other.m_size);
+		}
+		return *this;
+	}
+
+	pathBuffer& pathBuffer::operator=(pathBuffer&& other)
+	{
+		if(this == &other)
+		{
+			return *this;
+		}
+		if(other.isInline())
+		{
+			assign(other.m_data, other.m_size);
+		}
+		else // Take the allocated buffer
+		{
+			if(!isInline())
+			{
+				delete[] m_data;
+			}
+			m_data = other.m_data;
+			m_size = other.m_size;
+			m_capacity = other.m_capacity;
+			other.m_data = other.m_inline;
+			other.m_capacity = PATH_BUFFER_SIZE - 1;
+		}
+		other.m_size = 0;
+		other.m_data[0] = '\0';
+		return *this;
+	}
+
+	pathBuffer::~pathBuffer()
+	{
+		if(!isInline())
+		{
+			delete[] m_data;
+		}
+	}
+
+	const char* pathBuffer::name() const
+	{
+		size_t position = m_size;
+		while(position > 0 && m_data[position - 1] != '/')
+		{
+			--position;
+		}
+		return m_data + position;
+	}
+
+	void pathBuffer::reserve(size_t size)
+	{
+		if(size <= m_capacity)
+		{
+			return;
+		}
+		size_t capacity = m_capacity * 2 > size ? m_capacity * 2 : size;
+		char* data = new char[capacity + 1];
+		memcpy(data, m_data, m_size + 1);
+		if(!isInline())
+		{
+			delete[] m_data;
+		}
+		m_data = data;
+		m_capacity = capacity;
+	}
+
+	pathBuffer& pathBuffer::assign(const char* path, size_t size)
+	{
+		if(path >= m_data && path <= m_data + m_size) // Part of this path
+		{
+			memmove(m_data, path, size);
+			m_size = size;
+			m_data[m_size] = '\0';
+			return *this;
+		}
+		m_size = 0;
+		return append(path, size);
+	}
+
+	pathBuffer& pathBuffer::append(const char* data, size_t size)
+	{
+		if(m_size + size > m_capacity)
+		{
+			bool inside = data >= m_data && data <= m_data + m_size; // Buffer is freed by reserve
+			size_t offset = data - m_data;
+			reserve(m_size + size);
+			if(inside)
+			{
+				data = m_data + offset;
+			}
+		}
+		memmove(m_data + m_size, data, size);
+		m_size += size;
+		m_data[m_size] = '\0';
+		return *this;
+	}
+
+	pathBuffer& pathBuffer::join(const char* name, size_t size)
+	{
+		if(size == 0)
+		{
+			return *this;
+		}
+		if(name[0] == '/')
+		{
+			return assign(name, size);
+		}
+		if(m_size > 0 && m_data[m_size - 1] != '/')
+		{
+			if(m_size + 1 + size > m_capacity)
+			{
+				bool inside = name >= m_data && name <= m_data + m_size;
+				size_t offset = name - m_data;
+				reserve(m_size + 1 + size);
+				if(inside)
+				{
+					name = m_data + offset;
+				}
+			}
+			m_data[m_size++] = '/';
+		}
+		return append(name, size);
+	}
+
+	pathBuffer& pathBuffer::parent()
+	{
+		size_t position = m_size;
+		while(position > 1 && m_data[position - 1] == '/') // Trailing separators, root being kept
+		{
+			--position;
+		}
+		while(position > 0 && m_data[position - 1] != '/')
+		{
+			--position;
+		}
+		truncate(position);
+		return *this;
+	}
+
+	pathBuffer& pathBuffer::normalize()
+	{
+		bool absolute = isAbsolute();
+		bool directory = m_size > 0 && m_data[m_size - 1] == '/';
+		size_t base = absolute ? 1 : 0;
+		size_t written = base; // Components are moved toward the start, never after the one being read
+		size_t position = 0;
+		size_t length = 0;
+		while(true)
+		{
+			size_t start = nextComponent(m_data, m_size, position, length);
+			if(length == 0)
+			{
+				break;
+			}
+			if(length == 1 && m_data[start] == '.')
+			{
+				directory = directory || position == m_size;
+				continue;
+			}
+			if(isParentComponent(m_data + start, length))
+			{
+				directory = directory || position == m_size;
+				size_t last = written;
+				while(last > base && m_data[last - 1] != '/')
+				{
+					--last;
+				}
+				if(written > base && !isParentComponent(m_data + last, written - last)) // Remove previous component
+				{
+					written = last > base ? last - 1 : base;
+					continue;
+				}
+				if(absolute) // Nothing above the root
+				{
+					continue;
+				}
+			}
+			if(written > base)
+			{
+				m_data[written++] = '/';
+			}
+			memmove(m_data + written, m_data + start, length);
+			written += length;
+		}
+
+		if(written == base && !absolute)
+		{
+			m_data[written++] = '.';
+		}
+		else if(directory && written > base)
+		{
+			m_data[written++] = '/';
+		}
+		m_size = written;
+		m_data[m_size] = '\0';
+		return *this;
+	}
+
+	int pathBuffer::relativeTo(pathBuffer const& base, pathBuffer& result) const
+	{
+		pathBuffer path(*this);
+		pathBuffer from(base);
+		path.normalize();
+		from.normalize();
+		if(path.isAbsolute() != from.isAbsolute())
+		{
+			return EXEC_FAILURE;
+		}
+
+		// Skip common components
+		size_t pathPosition = 0;
+		size_t fromPosition = 0;
+		size_t pathLength = 0;
+		size_t fromLength = 0;
+		size_t pathStart = nextComponent(path.m_data, path.m_size, pathPosition, pathLength);
+		size_t fromStart = nextComponent(from.m_data, from.m_size, fromPosition, fromLength);
+		if(fromLength == 1 && from.m_data[fromStart] == '.') // Normalized empty path
+		{
+			fromStart = nextComponent(from.m_data, from.m_size, fromPosition, fromLength);
+		}
+		if(pathLength == 1 && path.m_data[pathStart] == '.')
+		{
+			pathStart = nextComponent(path.m_data, path.m_size, pathPosition, pathLength);
+		}
+		while(pathLength > 0 && pathLength == fromLength && memcmp(path.m_data + pathStart, from.m_data + fromStart, pathLength) == 0)
+		{
+			pathStart = nextComponent(path.m_data, path.m_size, pathPosition, pathLength);
+			fromStart = nextComponent(from.m_data, from.m_size, fromPosition, fromLength);
+		}
+
+		// Go up from the rest of base, then down to the rest of path
+		result.clear();
+		while(fromLength > 0)
+		{
+			if(isParentComponent(from.m_data + fromStart, fromLength)) // Name of the directory is unknown
+			{
+				return EXEC_FAILURE;
+			}
+			result.join("..", 2);
+			fromStart = nextComponent(from.m_data, from.m_size, fromPosition, fromLength);
+		}
+		if(pathLength > 0)
+		{
+			result.join(path.m_data + pathStart, path.m_size - pathStart);
+		}
+		else if(result.empty())
+		{
+			result.assign(".", 1);
+		}
+		else if(path.m_size > 1 && path.m_data[path.m_size - 1] == '/')
+		{
+			result.append("/", 1);
+		}
+		return EXEC_SUCCESS;
+	}
+}
+
+//  ______________________________
+// |                              |
+// |    ______________________    |       
+// |   |                      |   |
+// |   |         sign         |   |
+// |   |        coding        |   |
+// |   |        dw@rf         |   |
+// |   |         1.0          |   |
+// |   |______________________|   |
+// |                              |
+// |______________________________|
+//               |  |           
+//               |  |             
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |__|
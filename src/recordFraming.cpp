@@ -0,0 +1,276 @@
+/*!
+ * @file recordFraming.cpp
+ * @brief Functions used to write binary records that can be checked after a crash
+ * @author Sign Coding Dwarf
+ * @version 1.0
+ * @date 19 October 2026
+ *
+ * Implementation of the framing of binary records and of the recovery scan.
+ * CRC32C is computed 8 bytes at a time with 8 tables (slicing-by-8).
+ *
+ */
+
+/*
+Copyright 2016 SignCodingDwarf
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "recordFraming.h"
+
+#include <iostream>
+#include <vector>
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+namespace dwf_utils
+{
+	/*! \struct crcTables
+	* \brief Tables of the slicing-by-8 CRC32C, built once
+	*/
+	struct crcTables
+	{
+		/*!
+		* @brief Constructor of the crcTables structure
+		*
+		* Compute the tables of the reflected Castagnoli polynomial.
+		*
+		*/
+		crcTables()
+		{
+			for(uint32_t i = 0; i < 256; ++i)
+			{
+				uint32_t crc = i;
+				for(int bit = 0; bit < 8; ++bit)
+				{
+					crc = (crc >> 1) ^ (0x82F63B78U & (0U - (crc & 1)));
+				}
+				m_table[0][i] = crc;
+			}
+			for(uint32_t i = 0; i < 256; ++i)
+			{
+				for(int k = 1; k < 8; ++k)
+				{
+					m_table[k][i] = (m_table[k - 1][i] >> 8) ^ m_table[0][m_table[k - 1][i] & 0xFF];
+				}
+			}
+		}
+
+		uint32_t m_table[8][256]; /*!< Table k gives the CRC of a byte followed by k null bytes */
+	};
+
+	/*!
+	* @brief Write 4 bytes in little endian order
+	* @param out : position of the bytes
+	* @param value : value to write
+	*
+	*/
+	static inline void write32(char* out, uint32_t value)
+	{
+		out[0] = static_cast<char>(value & 0xFF);
+		out[1] = static_cast<char>((value >> 8) & 0xFF);
+		out[2] = static_cast<char>((value >> 16) & 0xFF);
+		out[3] = static_cast<char>(value >> 24);
+	}
+
+	/*!
+	* @brief Read 4 bytes in little endian order
+	* @param data : position of the bytes
+	* @return The read value
+	*
+	*/
+	static inline uint32_t read32(const char* data)
+	{
+		const unsigned char* in = reinterpret_cast<const unsigned char*>(data);
+		return in[0] | (in[1] << 8) | (in[2] << 16) | (static_cast<uint32_t>(in[3]) << 24);
+	}
+
+	/*!
+	* @brief Read bytes of a file
+	* @param fd : descriptor of the file
+	* @param buffer : buffer receiving the bytes
+	* @param size : number of bytes to read
+	* @param offset : position of the first byte in file
+	* @return EXEC_SUCCESS if all bytes could be read and EXEC_FAILURE otherwise
+	*
+	*/
+	static int readAt(int fd, char* buffer, size_t size, unsigned long long offset)
+	{
+		size_t done = 0;
+		while(done < size)
+		{
+			ssize_t got = pread(fd, buffer + done, size - done, offset + done);
+			if(got < 0 && errno == EINTR)
+			{
+				continue;
+			}
+			if(got <= 0)
+			{
+				return EXEC_FAILURE;
+			}
+			done += got;
+		}
+		return EXEC_SUCCESS;
+	}
+
+	uint32_t crc32c(const char* data, size_t size, uint32_t crc)
+	{
+		static const crcTables tables;
+		const uint32_t (*t)[256] = tables.m_table;
+		const unsigned char* in = reinterpret_cast<const unsigned char*>(data);
+		crc = ~crc;
+		while(size >= 8)
+		{
+			uint32_t low = read32(reinterpret_cast<const char*>(in)) ^ crc;
+			uint32_t high = read32(reinterpret_cast<const char*>(in + 4));
+			crc = t[7][low & 0xFF] ^ t[6][(low >> 8) & 0xFF] ^ t[5][(low >> 16) & 0xFF] ^ t[4][low >> 24] ^ t[3][high & 0xFF] ^ t[2][(high >> 8) & 0xFF] ^ t[1][(high >> 16) & 0xFF] ^ t[0][high >> 24];
+			in += 8;
+			size -= 8;
+		}
+		while(size-- > 0)
+		{
+			crc = (crc >> 8) ^ t[0][(crc ^ *in++) & 0xFF];
+		}
+		return ~crc;
+	}
+
+	void frameHeader(const char* data, size_t size, char* header)
+	{
+		write32(header, FRAME_MAGIC);
+		write32(header + 4, static_cast<uint32_t>(size));
+		write32(header + 8, crc32c(data, size, crc32c(header + 4, 4))); // Length is checked too
+	}
+
+	void appendFrame(std::string& out, const char* data, size_t size)
+	{
+		char header[FRAME_HEADER_SIZE];
+		frameHeader(data, size, header);
+		out.reserve(out.size() + FRAME_HEADER_SIZE + size);
+		out.append(header, FRAME_HEADER_SIZE);
+		out.append(data, size);
+	}
+
+	size_t checkFrame(const char* data, size_t size)
+	{
+		if(size < FRAME_HEADER_SIZE || read32(data) != FRAME_MAGIC)
+		{
+			return 0;
+		}
+		size_t length = read32(data + 4);
+		if(length > FRAME_MAX_SIZE || length > size - FRAME_HEADER_SIZE)
+		{
+			return 0;
+		}
+		if(crc32c(data + FRAME_HEADER_SIZE, length, crc32c(data + 4, 4)) != read32(data + 8))
+		{
+			return 0;
+		}
+		return FRAME_HEADER_SIZE + length;
+	}
+
+	int recoverFramedFile(std::string const& name, bool truncate, frameRecovery& result)
+	{
+		result = frameRecovery();
+		int fd = open(name.c_str(), (truncate ? O_RDWR : O_RDONLY) | O_CLOEXEC);
+		struct stat info;
+		if(fd < 0 || fstat(fd, &info) != 0)
+		{
+			fd >= 0 && close(fd);
+			return EXEC_FAILURE;
+		}
+		result.m_fileSize = static_cast<unsigned long long>(info.st_size);
+
+		std::vector<char> buffer; // Bytes from start to the end of file
+		unsigned long long start = result.m_fileSize;
+		unsigned long long window = FRAME_RECOVERY_WINDOW;
+		while(true)
+		{
+			unsigned long long previous = start;
+			start = result.m_fileSize > window ? result.m_fileSize - window : 0;
+			size_t added = static_cast<size_t>(previous - start);
+			buffer.insert(buffer.begin(), added, 0); // Only bytes before the previous window are read
+			if(readAt(fd, buffer.data(), added, start) == EXEC_FAILURE)
+			{
+				close(fd);
+				return EXEC_FAILURE;
+			}
+			result.m_scannedBytes += added;
+			size_t size = buffer.size();
+
+			// Find the first valid frame starting in the added bytes, no frame starts further. From the beginning of the file, the first frame must be valid.
+			size_t position = 0;
+			size_t frame = checkFrame(buffer.data(), size);
+			while(frame == 0 && start > 0 && position + 1 < added)
+			{
+				const void* magic = memchr(buffer.data() + position + 1, FRAME_MAGIC & 0xFF, added - position - 1);
+				if(magic == NULL)
+				{
+					break;
+				}
+				position = static_cast<const char*>(magic) - buffer.data();
+				frame = checkFrame(buffer.data() + position, size - position);
+			}
+
+			if(frame > 0 || start == 0)
+			{
+				while(frame > 0) // Follow the chain until the torn frame
+				{
+					position += frame;
+					++result.m_frameNb;
+					frame = checkFrame(buffer.data() + position, size - position);
+				}
+				result.m_validSize = start + position;
+				break;
+			}
+			window *= 2; // Torn frame longer than the window, the previous complete frame starts before
+		}
+
+		int status = EXEC_SUCCESS;
+		if(truncate && result.m_validSize < result.m_fileSize && ftruncate(fd, result.m_validSize) != 0)
+		{
+#if DEBUG
+			std::cerr << "Could not truncate " << name << " to " << result.m_validSize << " bytes" << std::endl;
+#endif
+			status = EXEC_FAILURE;
+		}
+		close(fd);
+		return status;
+	}
+}
+
+//  ______________________________
+// |                              |
+// |    ______________________    |       
+// |   |                      |   |
+// |   |         sign         |   |
+// |   |        coding        |   |
+// |   |        dw@rf         |   |
+// |   |         1.0          |   |
+// |   |______________________|   |
+// |                              |
+// |______________________________|
+//               |  |           
+//               |  |             
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |__|
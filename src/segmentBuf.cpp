@@ -0,0 +1,274 @@
+/*!
+ * @file segmentBuf.cpp
+ * @brief Stream buffer used to write the segments of split files
+ * @author Sign Coding Dwarf
+ * @version 1.0
+ * @date 19 October 2026
+ *
+ * Implementation of the stream buffer used by fileSplitter to write into its files.
+ * It keeps track of the number of bytes written in the current file without any system call so that files can be split according to their size.
+ *
+ */
+
+/* 
+Copyright 2016 SignCodingDwarf
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "segmentBuf.h"
+
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace dwf_utils
+{
+	segmentBuf::segmentBuf(size_t bufferSize) : m_engine(new pwriteEngine(bufferSize)), m_fd(-1), m_flushed(0), m_lastChar('\0')
+	{
+		resetBuffer();
+	}
+
+	segmentBuf::segmentBuf(std::unique_ptr<writeEngine> engine) : m_engine(std::move(engine)), m_fd(-1), m_flushed(0), m_lastChar('\0')
+	{
+		if(!m_engine)
+		{
+			m_engine.reset(new pwriteEngine(SEGMENTBUF_DEFAULT_SIZE));
+		}
+		resetBuffer();
+	}
+
+	segmentBuf::~segmentBuf()
+	{
+		close();
+	}
+
+	int segmentBuf::open(const std::string& fileName)
+	{
+		close();
+		int fd = create(fileName);
+		if(fd < 0)
+		{
+			return EXEC_FAILURE;
+		}
+		return attach(fd);
+	}
+
+	int segmentBuf::create(const std::string& fileName, bool truncate) const
+	{
+		int flags = O_CREAT | O_CLOEXEC | openFlags() | (truncate ? O_TRUNC : 0);
+		int fd = ::open(fileName.c_str(), flags, 0644);
+#ifdef O_DIRECT
+		if(fd < 0 && errno == EINVAL && (flags & O_DIRECT) != 0) // File system without direct access support
+		{
+			fd = ::open(fileName.c_str(), flags & ~O_DIRECT, 0644);
+		}
+#endif
+		return fd;
+	}
+
+	int segmentBuf::close()
+	{
+		if(m_fd < 0)
+		{
+			return EXEC_SUCCESS;
+		}
+		int fd = detach();
+		if(fd < 0 || ::close(fd) != 0)
+		{
+			return EXEC_FAILURE;
+		}
+		return EXEC_SUCCESS;
+	}
+
+	int segmentBuf::attach(int fd)
+	{
+		close();
+		if(fd < 0 || m_engine->attach(fd) == EXEC_FAILURE)
+		{
+			return EXEC_FAILURE;
+		}
+		m_fd = fd;
+		resetBuffer(); // Engine may provide buffers depending on the file
+		return EXEC_SUCCESS;
+	}
+
+	int segmentBuf::detach()
+	{
+		if(m_fd < 0)
+		{
+			return -1;
+		}
+		int fd = m_fd;
+		int result = writeBuffer();
+		if(m_engine->detach() == EXEC_FAILURE || result == EXEC_FAILURE)
+		{
+			::close(fd);
+			fd = -1;
+		}
+		m_fd = -1;
+		m_flushed = 0;
+		m_lastChar = '\0';
+		resetBuffer(); // Data that could not be written is dropped with the file
+		return fd;
+	}
+
+	bool segmentBuf::isOpen() const
+	{
+		return m_fd >= 0;
+	}
+
+	int segmentBuf::openFlags() const
+	{
+		return m_engine->openFlags();
+	}
+
+	unsigned long long segmentBuf::getWritten() const
+	{
+		return m_fd >= 0 ? m_engine->getWritten() : 0;
+	}
+
+	int segmentBuf::drain()
+	{
+		if(m_fd < 0)
+		{
+			return EXEC_FAILURE;
+		}
+		int result = writeBuffer();
+		if(m_engine->drain() == EXEC_FAILURE)
+		{
+			result = EXEC_FAILURE;
+		}
+		return result;
+	}
+
+	long long segmentBuf::transfer(int source, size_t size)
+	{
+		if(m_fd < 0 || writeBuffer() == EXEC_FAILURE)
+		{
+			return -1;
+		}
+		long long moved = m_engine->transferFrom(source, size);
+		if(moved > 0)
+		{
+			m_flushed += moved;
+			m_lastChar = '\n'; // Content is unknown, a split point is allowed after it
+		}
+		resetBuffer(); // Engine may have used its buffer
+		return moved;
+	}
+
+	segmentBuf::int_type segmentBuf::overflow(int_type c)
+	{
+		if(writeBuffer() == EXEC_FAILURE)
+		{
+			return traits_type::eof();
+		}
+		if(!traits_type::eq_int_type(c, traits_type::eof()))
+		{
+			*pptr() = traits_type::to_char_type(c);
+			pbump(1);
+			return c;
+		}
+		return traits_type::not_eof(c);
+	}
+
+	std::streamsize segmentBuf::xsputn(const char* s, std::streamsize n)
+	{
+		std::streamsize room = epptr() - pptr();
+		if(n <= room) // Most common case, data fits in buffer
+		{
+			std::memcpy(pptr(), s, n);
+			pbump(static_cast<int>(n));
+			return n;
+		}
+
+		if(m_fd < 0)
+		{
+			return 0;
+		}
+		if(n >= epptr() - pbase()) // Copying big blocks in buffer is useless, buffer and block are given together to the engine
+		{
+			int result = m_engine->commitWith(pptr() - pbase(), s, n);
+			m_flushed += (pptr() - pbase()) + n;
+			m_lastChar = s[n - 1];
+			resetBuffer();
+			return result == EXEC_SUCCESS ? n : 0;
+		}
+		std::memcpy(pptr(), s, room); // Buffer is filled before being written, so that all writes have the buffer size
+		pbump(static_cast<int>(room));
+		if(writeBuffer() == EXEC_FAILURE)
+		{
+			return room;
+		}
+		std::memcpy(pptr(), s + room, n - room);
+		pbump(static_cast<int>(n - room));
+		return n;
+	}
+
+	int segmentBuf::sync()
+	{
+		return writeBuffer() == EXEC_SUCCESS ? 0 : -1;
+	}
+
+	int segmentBuf::writeBuffer()
+	{
+		size_t size = pptr() - pbase();
+		if(size == 0)
+		{
+			return EXEC_SUCCESS;
+		}
+		if(m_fd < 0)
+		{
+			return EXEC_FAILURE;
+		}
+		char last = pptr()[-1];
+		int result = m_engine->commit(size);
+		m_flushed += size;
+		m_lastChar = last;
+		resetBuffer();
+		return result;
+	}
+
+	void segmentBuf::resetBuffer()
+	{
+		size_t size = 0;
+		char* buffer = m_engine->getBuffer(size);
+		setp(buffer, buffer + size);
+	}
+}
+
+//  ______________________________
+// |                              |
+// |    ______________________    |       
+// |   |                      |   |
+// |   |         sign         |   |
+// |   |        coding        |   |
+// |   |        dw@rf         |   |
+// |   |         1.0          |   |
+// |   |______________________|   |
+// |                              |
+// |______________________________|
+//               |  |           
+//               |  |             
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |__|
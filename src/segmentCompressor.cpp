@@ -0,0 +1,462 @@
+/*!
+ * @file segmentCompressor.cpp
+ * @brief Class used to compress the files written by fileSplitter in background
+ * @author Sign Coding Dwarf
+ * @version 1.0
+ * @date 19 October 2026
+ *
+ * Implementation of the compression stage run on complete split files.
+ * Built-in files start with the DWLZ magic followed by blocks made of the raw size, the stored size and the data. A block whose stored size is its raw size is not compressed.
+ *
+ */
+
+/*
+Copyright 2016 SignCodingDwarf
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "segmentCompressor.h"
+#include "lzCodec.h"
+#include <iostream>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#ifndef USE_ZLIB
+#define USE_ZLIB 0
+#endif
+
+#if USE_ZLIB
+#include <zlib.h>
+#endif
+
+/*!
+* @def LZ_FILE_MAGIC
+* @brief First bytes of the files written with COMPRESS_LZ
+*/
+#define LZ_FILE_MAGIC "DWLZ"
+
+namespace dwf_utils
+{
+	/*!
+	* @brief Read a whole buffer from a file
+	* @param fd : descriptor of the file
+	* @param data : buffer to fill
+	* @param size : size of the buffer
+	* @return Number of bytes read, lower than size at the end of the file, -1 on failure
+	*
+	*/
+	static ssize_t readFull(int fd, char* data, size_t size)
+	{
+		size_t done = 0;
+		while(done < size)
+		{
+			ssize_t result = ::read(fd, data + done, size - done);
+			if(result < 0)
+			{
+				return -1;
+			}
+			if(result == 0)
+			{
+				break;
+			}
+			done += result;
+		}
+		return static_cast<ssize_t>(done);
+	}
+
+	/*!
+	* @brief Write a whole buffer into a file
+	* @param fd : descriptor of the file
+	* @param data : data to write
+	* @param size : number of bytes to write
+	* @return EXEC_SUCCESS if every byte could be written and EXEC_FAILURE otherwise
+	*
+	*/
+	static int writeFull(int fd, const char* data, size_t size)
+	{
+		while(size > 0)
+		{
+			ssize_t result = ::write(fd, data, size);
+			if(result <= 0)
+			{
+				return EXEC_FAILURE;
+			}
+			data += result;
+			size -= result;
+		}
+		return EXEC_SUCCESS;
+	}
+
+	/*!
+	* @brief Compress a file with the built-in codec
+	* @param in : descriptor of the raw file
+	* @param out : descriptor of the compressed file
+	* @return EXEC_SUCCESS if file could be compressed and EXEC_FAILURE otherwise
+	*
+	*/
+	static int compressLz(int in, int out)
+	{
+		std::vector<char> raw(COMPRESSION_BLOCK_SIZE);
+		std::vector<char> block;
+		if(writeFull(out, LZ_FILE_MAGIC, 4) == EXEC_FAILURE)
+		{
+			return EXEC_FAILURE;
+		}
+		while(true)
+		{
+			ssize_t size = readFull(in, &raw[0], raw.size());
+			if(size <= 0)
+			{
+				return size == 0 ? EXEC_SUCCESS : EXEC_FAILURE;
+			}
+			block.assign(2 * sizeof(uint32_t), '\0');
+			lzCompress(&raw[0], size, block);
+			uint32_t header[2] = {static_cast<uint32_t>(size), static_cast<uint32_t>(block.size() - sizeof(header))};
+			if(header[1] >= header[0]) // Stored as is
+			{
+				header[1] = header[0];
+				block.resize(sizeof(header));
+				block.insert(block.end(), raw.begin(), raw.begin() + size);
+			}
+			memcpy(&block[0], header, sizeof(header));
+			if(writeFull(out, &block[0], block.size()) == EXEC_FAILURE)
+			{
+				return EXEC_FAILURE;
+			}
+		}
+	}
+
+#if USE_ZLIB
+	/*!
+	* @brief Compress a file as gzip
+	* @param in : descriptor of the raw file
+	* @param out : descriptor of the compressed file
+	* @return EXEC_SUCCESS if file could be compressed and EXEC_FAILURE otherwise
+	*
+	*/
+	static int compressZlib(int in, int out)
+	{
+		z_stream stream;
+		memset(&stream, 0, sizeof(stream));
+		if(deflateInit2(&stream, Z_BEST_SPEED, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) // 16 asks for a gzip header
+		{
+			return EXEC_FAILURE;
+		}
+		std::vector<char> raw(COMPRESSION_BLOCK_SIZE);
+		std::vector<char> compressed(COMPRESSION_BLOCK_SIZE);
+		int result = EXEC_SUCCESS;
+		int flush = Z_NO_FLUSH;
+		while(flush != Z_FINISH && result == EXEC_SUCCESS)
+		{
+			ssize_t size = readFull(in, &raw[0], raw.size());
+			if(size < 0)
+			{
+				result = EXEC_FAILURE;
+				break;
+			}
+			flush = static_cast<size_t>(size) < raw.size() ? Z_FINISH : Z_NO_FLUSH;
+			stream.next_in = reinterpret_cast<Bytef*>(&raw[0]);
+			stream.avail_in = static_cast<uInt>(size);
+			do
+			{
+				stream.next_out = reinterpret_cast<Bytef*>(&compressed[0]);
+				stream.avail_out = static_cast<uInt>(compressed.size());
+				if(deflate(&stream, flush) == Z_STREAM_ERROR || writeFull(out, &compressed[0], compressed.size() - stream.avail_out) == EXEC_FAILURE)
+				{
+					result = EXEC_FAILURE;
+					break;
+				}
+			} while(stream.avail_out == 0);
+		}
+		deflateEnd(&stream);
+		return result;
+	}
+#endif
+
+	compressionCodec availableCodec(compressionCodec codec)
+	{
+#if USE_ZLIB
+		return codec;
+#else
+		return codec == COMPRESS_ZLIB ? COMPRESS_LZ : codec;
+#endif
+	}
+
+	std::string compressedName(std::string const& name, compressionCodec codec)
+	{
+		switch(availableCodec(codec))
+		{
+		case COMPRESS_LZ:
+			return name + ".dlz";
+		case COMPRESS_ZLIB:
+			return name + ".gz";
+		default:
+			return name;
+		}
+	}
+
+	int compressFile(std::string const& source, std::string const& destination, compressionCodec codec, bool sync, unsigned long long& compressedBytes)
+	{
+		codec = availableCodec(codec);
+		int in = ::open(source.c_str(), O_RDONLY | O_CLOEXEC);
+		if(in < 0 || codec == COMPRESS_NONE)
+		{
+			in >= 0 && ::close(in);
+			return EXEC_FAILURE;
+		}
+		int out = ::open(destination.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+		if(out < 0)
+		{
+			::close(in);
+			return EXEC_FAILURE;
+		}
+		posix_fadvise(in, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+		int result = EXEC_FAILURE;
+#if USE_ZLIB
+		result = codec == COMPRESS_ZLIB ? compressZlib(in, out) : compressLz(in, out);
+#else
+		result = compressLz(in, out);
+#endif
+		posix_fadvise(in, 0, 0, POSIX_FADV_DONTNEED); // Raw file is removed, its pages are useless
+		::close(in);
+
+		struct stat info;
+		if(result == EXEC_SUCCESS && fstat(out, &info) == 0)
+		{
+			compressedBytes = info.st_size;
+		}
+		if(result == EXEC_SUCCESS && sync && fdatasync(out) != 0)
+		{
+			result = EXEC_FAILURE;
+		}
+		if(::close(out) != 0)
+		{
+			result = EXEC_FAILURE;
+		}
+		return result;
+	}
+
+	int findCompressed(std::string const& name, std::string& compressed)
+	{
+		const char* extensions[] = {".dlz", ".gz"}; // Names of every codec, whatever the ones this library supports
+		for(size_t i = 0; i < sizeof(extensions) / sizeof(extensions[0]); ++i)
+		{
+			compressed = name + extensions[i];
+			if(access(compressed.c_str(), F_OK) == 0)
+			{
+				return EXEC_SUCCESS;
+			}
+		}
+		compressed.clear();
+		return EXEC_FAILURE;
+	}
+
+	int decompressFile(std::string const& source, std::vector<char>& data)
+	{
+		data.clear();
+		int in = ::open(source.c_str(), O_RDONLY | O_CLOEXEC);
+		if(in < 0)
+		{
+			return EXEC_FAILURE;
+		}
+		char magic[4];
+		if(readFull(in, magic, sizeof(magic)) != sizeof(magic))
+		{
+			::close(in);
+			return EXEC_FAILURE;
+		}
+
+		if(memcmp(magic, LZ_FILE_MAGIC, sizeof(magic)) != 0)
+		{
+			::close(in);
+#if USE_ZLIB
+			gzFile gz = gzopen(source.c_str(), "rb");
+			if(gz == NULL)
+			{
+				return EXEC_FAILURE;
+			}
+			std::vector<char> buffer(COMPRESSION_BLOCK_SIZE);
+			int size;
+			while((size = gzread(gz, &buffer[0], static_cast<unsigned int>(buffer.size()))) > 0)
+			{
+				data.insert(data.end(), buffer.begin(), buffer.begin() + size);
+			}
+			gzclose(gz);
+			return size == 0 ? EXEC_SUCCESS : EXEC_FAILURE;
+#else
+			return EXEC_FAILURE;
+#endif
+		}
+
+		std::vector<char> block;
+		uint32_t header[2]; // Raw size and stored size
+		ssize_t size;
+		int result = EXEC_SUCCESS;
+		while(result == EXEC_SUCCESS && (size = readFull(in, reinterpret_cast<char*>(header), sizeof(header))) > 0)
+		{
+			if(size != sizeof(header) || header[1] == 0 || header[1] > header[0] || header[0] > COMPRESSION_BLOCK_SIZE) // Corrupted or truncated file, checked before any allocation
+			{
+				result = EXEC_FAILURE;
+				break;
+			}
+			block.resize(header[1]);
+			if(readFull(in, &block[0], header[1]) != static_cast<ssize_t>(header[1]))
+			{
+				result = EXEC_FAILURE;
+				break;
+			}
+			size_t position = data.size();
+			data.resize(position + header[0]);
+			if(header[1] == header[0])
+			{
+				memcpy(&data[position], &block[0], header[0]);
+			}
+			else
+			{
+				result = lzDecompress(&block[0], header[1], &data[position], header[0]);
+			}
+		}
+		::close(in);
+		return result;
+	}
+
+	segmentCompressor::segmentCompressor(compressionCodec codec, size_t capacity, bool sync) : m_codec(availableCodec(codec)), m_capacity(capacity > 0 ? capacity : 1), m_sync(sync), m_depth(0), m_stats(), m_worker(new workerThread())
+	{
+	}
+
+	segmentCompressor::~segmentCompressor()
+	{
+		m_worker.reset(); // Compress remaining files
+	}
+
+	bool segmentCompressor::submit(std::string const& name)
+	{
+		size_t depth = m_depth.load();
+		do
+		{
+			if(depth >= m_capacity)
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				++m_stats.m_skipped;
+				return false;
+			}
+		} while(!m_depth.compare_exchange_weak(depth, depth + 1));
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			++m_stats.m_queued;
+			m_stats.m_maxDepth = depth + 1 > m_stats.m_maxDepth ? depth + 1 : m_stats.m_maxDepth;
+		}
+		m_worker->post([this, name]() { compress(name); m_depth.fetch_sub(1); });
+		return true;
+	}
+
+	void segmentCompressor::remove(std::string const& name, std::string const& directory)
+	{
+		m_worker->post([this, name, directory]()
+		{
+			unlink(compressedName(name, m_codec).c_str());
+			unlink(name.c_str()); // Kept raw if it was skipped or could not be compressed
+			if(!directory.empty())
+			{
+				rmdir(directory.c_str());
+			}
+		});
+	}
+
+	void segmentCompressor::wait()
+	{
+		m_worker->wait();
+	}
+
+	compressionCodec segmentCompressor::getCodec() const
+	{
+		return m_codec;
+	}
+
+	size_t segmentCompressor::getDepth() const
+	{
+		return m_depth.load();
+	}
+
+	compressionStats segmentCompressor::getStats() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_stats;
+	}
+
+	void segmentCompressor::compress(std::string const& name)
+	{
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		std::string destination = compressedName(name, m_codec);
+		std::string temporary = destination + ".tmp";
+		unsigned long long compressedBytes = 0;
+		struct stat info;
+		bool success = stat(name.c_str(), &info) == 0 && compressFile(name, temporary, m_codec, m_sync, compressedBytes) == EXEC_SUCCESS && rename(temporary.c_str(), destination.c_str()) == 0; // Readers see the raw or the complete compressed file
+		if(success)
+		{
+			unlink(name.c_str());
+		}
+		else
+		{
+			unlink(temporary.c_str());
+#if DEBUG
+			std::cerr << "Could not compress " << name << std::endl;
+#endif
+		}
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if(success)
+		{
+			++m_stats.m_compressed;
+			m_stats.m_rawBytes += info.st_size;
+			m_stats.m_compressedBytes += compressedBytes;
+		}
+		else
+		{
+			++m_stats.m_failed;
+		}
+		m_stats.m_time += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+	}
+}
+
+//  ______________________________
+// |                              |
+// |    ______________________    |       
+// |   |                      |   |
+// |   |         sign         |   |
+// |   |        coding        |   |
+// |   |        dw@rf         |   |
+// |   |         1.0          |   |
+// |   |______________________|   |
+// |                              |
+// |______________________________|
+//               |  |           
+//               |  |             
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |__|
@@ -0,0 +1,149 @@
+/*!
+ * @file shardedFileSplitter.cpp
+ * @brief Class used to spread records over several independent file splittings
+ * @author Sign Coding Dwarf
+ * @version 1.0
+ * @date 19 October 2026
+ *
+ * Implementation of the class routing records to several concurrentFileSplitter shards.
+ *
+ */
+
+/*
+Copyright 2016 SignCodingDwarf
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "shardedFileSplitter.h"
+#include <functional>
+#include <thread>
+
+namespace dwf_utils
+{
+	shardedFileSplitter::shardedFileSplitter(std::string baseName, std::string extension, unsigned long fileSize, unsigned int shardNb, splitterOptions const& options) : m_shards()
+	{
+		for(unsigned int i = 0; i < (shardNb > 0 ? shardNb : 1); ++i)
+		{
+			m_shards.push_back(std::unique_ptr<concurrentFileSplitter>(new concurrentFileSplitter(shardName(baseName, i), extension, fileSize, options)));
+		}
+	}
+
+	shardedFileSplitter::~shardedFileSplitter()
+	{
+		m_shards.clear(); // Each shard writes its remaining records
+	}
+
+	std::string shardedFileSplitter::shardName(std::string const& baseName, unsigned int shard)
+	{
+		return baseName + "_s" + toString(shard);
+	}
+
+	void shardedFileSplitter::submit(std::string data)
+	{
+		static thread_local size_t next = std::hash<std::thread::id>()(std::this_thread::get_id()); // Threads start on different shards, no shared counter
+		m_shards[next++ % m_shards.size()]->submit(std::move(data));
+	}
+
+	unsigned int shardedFileSplitter::shardOf(std::string const& key) const
+	{
+		return shardOf(static_cast<unsigned long long>(std::hash<std::string>()(key)));
+	}
+
+	concurrentFileSplitter& shardedFileSplitter::getShard(unsigned int shard)
+	{
+		return *m_shards[shard];
+	}
+
+	unsigned int shardedFileSplitter::getShardNb() const
+	{
+		return static_cast<unsigned int>(m_shards.size());
+	}
+
+	void shardedFileSplitter::flush()
+	{
+		for(size_t i = 0; i < m_shards.size(); ++i)
+		{
+			m_shards[i]->flush();
+		}
+	}
+
+	int shardedFileSplitter::waitDurable()
+	{
+		int result = EXEC_SUCCESS;
+		for(size_t i = 0; i < m_shards.size(); ++i)
+		{
+			if(m_shards[i]->waitDurable() == EXEC_FAILURE)
+			{
+				result = EXEC_FAILURE;
+			}
+		}
+		return result;
+	}
+
+	bool shardedFileSplitter::getStatus() const
+	{
+		for(size_t i = 0; i < m_shards.size(); ++i)
+		{
+			if(!m_shards[i]->getStatus())
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	size_t shardedFileSplitter::getQueueDepth() const
+	{
+		size_t depth = 0;
+		for(size_t i = 0; i < m_shards.size(); ++i)
+		{
+			depth += m_shards[i]->getQueueDepth();
+		}
+		return depth;
+	}
+
+	splitterStats shardedFileSplitter::getStats() const
+	{
+		splitterStats stats;
+		for(size_t i = 0; i < m_shards.size(); ++i)
+		{
+			mergeStats(stats, m_shards[i]->getStats());
+		}
+		return stats;
+	}
+}
+
+//  ______________________________
+// |                              |
+// |    ______________________    |       
+// |   |                      |   |
+// |   |         sign         |   |
+// |   |        coding        |   |
+// |   |        dw@rf         |   |
+// |   |         1.0          |   |
+// |   |______________________|   |
+// |                              |
+// |______________________________|
+//               |  |           
+//               |  |             
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |__|
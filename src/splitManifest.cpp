@@ -0,0 +1,218 @@
+/*!
+ * @file splitManifest.cpp
+ * @brief Description of the files written by fileSplitter
+ * @author Sign Coding Dwarf
+ * @version 1.0
+ * @date 19 October 2026
+ *
+ * Implementation of the reading and writing of the manifest and of the sparse indexes written by fileSplitter.
+ *
+ */
+
+/* 
+Copyright 2016 SignCodingDwarf
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "splitManifest.h"
+
+#include <fstream>
+#include <sstream>
+#include <cerrno>
+#include <ctime>
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace dwf_utils
+{
+	/*!
+	* @brief Write a whole block
+	* @param fd : descriptor of the file opened in append mode
+	* @param data : data to write
+	* @param size : number of bytes to write
+	* @return EXEC_SUCCESS if every byte could be written and EXEC_FAILURE otherwise
+	*
+	*/
+	static int writeAll(int fd, const char* data, size_t size)
+	{
+		while(size > 0)
+		{
+			ssize_t written = ::write(fd, data, size);
+			if(written < 0)
+			{
+				if(errno == EINTR)
+				{
+					continue;
+				}
+				return EXEC_FAILURE;
+			}
+			data += written;
+			size -= written;
+		}
+		return EXEC_SUCCESS;
+	}
+
+	std::string manifestName(const std::string& baseName)
+	{
+		return baseName + ".manifest";
+	}
+
+	std::string manifestDirectory(const std::string& fileName)
+	{
+		std::string::size_type slash = fileName.rfind('/');
+		return slash == std::string::npos ? std::string() : fileName.substr(0, slash + 1);
+	}
+
+	std::string indexName(const std::string& fileName)
+	{
+		return fileName + ".idx";
+	}
+
+	unsigned long long manifestTime()
+	{
+		timespec now;
+#ifdef CLOCK_REALTIME_COARSE
+		clock_gettime(CLOCK_REALTIME_COARSE, &now); // Read from memory shared with the kernel
+#else
+		clock_gettime(CLOCK_REALTIME, &now);
+#endif
+		return static_cast<unsigned long long>(now.tv_sec) * 1000000ULL + now.tv_nsec / 1000;
+	}
+
+	int appendManifest(int fd, segmentInfo const& info, const std::string& directory)
+	{
+		if(fd < 0)
+		{
+			return EXEC_FAILURE;
+		}
+		std::ostringstream line;
+		line << info.m_id << " " << info.m_firstRecord << " " << info.m_recordNb << " " << info.m_bytes << " " << info.m_firstTime << " " << info.m_lastTime << " ";
+		if(!directory.empty() && info.m_name.compare(0, directory.size(), directory) == 0) // Files are written under the directory of the manifest
+		{
+			line << info.m_name.substr(directory.size());
+		}
+		else
+		{
+			line << info.m_name;
+		}
+		line << "\n";
+		std::string data = line.str();
+		return writeAll(fd, data.c_str(), data.size());
+	}
+
+	int writeManifest(const std::string& fileName, std::deque<segmentInfo> const& segments)
+	{
+		std::string temporary = fileName + ".tmp";
+		int fd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+		if(fd < 0)
+		{
+			return EXEC_FAILURE;
+		}
+		std::string directory = manifestDirectory(fileName);
+		int result = EXEC_SUCCESS;
+		for(size_t i = 0; i < segments.size() && result == EXEC_SUCCESS; ++i)
+		{
+			result = appendManifest(fd, segments[i], directory);
+		}
+		if(::close(fd) != 0 || result == EXEC_FAILURE || rename(temporary.c_str(), fileName.c_str()) != 0)
+		{
+			unlink(temporary.c_str());
+			return EXEC_FAILURE;
+		}
+		return EXEC_SUCCESS;
+	}
+
+	int loadManifest(const std::string& fileName, std::vector<segmentInfo>& segments)
+	{
+		segments.clear();
+		std::string directory = manifestDirectory(fileName);
+		std::ifstream manifest(fileName.c_str());
+		if(!manifest)
+		{
+			return EXEC_FAILURE;
+		}
+		std::string line;
+		while(std::getline(manifest, line))
+		{
+			std::istringstream fields(line);
+			segmentInfo info;
+			if(!(fields >> info.m_id >> info.m_firstRecord >> info.m_recordNb >> info.m_bytes >> info.m_firstTime >> info.m_lastTime))
+			{
+				return EXEC_FAILURE;
+			}
+			fields.get(); // Separator, the name may contain spaces
+			std::getline(fields, info.m_name);
+			if(!info.m_name.empty() && info.m_name[0] != '/')
+			{
+				info.m_name = directory + info.m_name;
+			}
+			segments.push_back(info);
+		}
+		return EXEC_SUCCESS;
+	}
+
+	int appendIndex(int fd, std::vector<indexEntry> const& entries)
+	{
+		if(fd < 0)
+		{
+			return EXEC_FAILURE;
+		}
+		if(entries.empty())
+		{
+			return EXEC_SUCCESS;
+		}
+		return writeAll(fd, reinterpret_cast<const char*>(&entries[0]), entries.size() * sizeof(indexEntry));
+	}
+
+	int loadIndex(const std::string& fileName, std::vector<indexEntry>& entries)
+	{
+		entries.clear();
+		std::ifstream index(fileName.c_str(), std::ios::binary);
+		if(!index)
+		{
+			return EXEC_FAILURE;
+		}
+		indexEntry entry;
+		while(index.read(reinterpret_cast<char*>(&entry), sizeof(entry)))
+		{
+			entries.push_back(entry);
+		}
+		return EXEC_SUCCESS;
+	}
+}
+
+//  ______________________________
+// |                              |
+// |    ______________________    |       
+// |   |                      |   |
+// |   |         sign         |   |
+// |   |        coding        |   |
+// |   |        dw@rf         |   |
+// |   |         1.0          |   |
+// |   |______________________|   |
+// |                              |
+// |______________________________|
+//               |  |           
+//               |  |             
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |__|
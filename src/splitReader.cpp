@@ -0,0 +1,222 @@
+/*!
+ * @file splitReader.cpp
+ * @brief Class used to read the files written by fileSplitter
+ * @author Sign Coding Dwarf
+ * @version 1.0
+ * @date 19 October 2026
+ *
+ * Implementation of the class reading the set of files written by fileSplitter with the m_manifest option.
+ *
+ */
+
+/* 
+Copyright 2016 SignCodingDwarf
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "splitReader.h"
+#include "segmentCompressor.h"
+
+#include <limits>
+
+namespace dwf_utils
+{
+	splitReader::splitReader(std::string baseName) : m_baseName(baseName), m_segments(), m_status(false), m_current(0), m_fileBuf(), m_memoryBuf(), m_file(&m_fileBuf), m_open(false)
+	{
+		reload();
+	}
+
+	splitReader::~splitReader()
+	{
+	}
+
+	int splitReader::reload()
+	{
+		std::vector<segmentInfo> segments;
+		if(loadManifest(manifestName(m_baseName), segments) == EXEC_FAILURE)
+		{
+			return EXEC_FAILURE;
+		}
+		m_segments.swap(segments);
+		m_status = true;
+		return EXEC_SUCCESS;
+	}
+
+	bool splitReader::getStatus() const
+	{
+		return m_status;
+	}
+
+	size_t splitReader::getSegmentNb() const
+	{
+		return m_segments.size();
+	}
+
+	segmentInfo const& splitReader::getSegment(size_t i) const
+	{
+		return m_segments.at(i);
+	}
+
+	unsigned long long splitReader::getRecordNb() const
+	{
+		if(m_segments.empty())
+		{
+			return 0;
+		}
+		return m_segments.back().m_firstRecord + m_segments.back().m_recordNb;
+	}
+
+	int splitReader::seekRecord(unsigned long long record)
+	{
+		if(record >= getRecordNb() || record < m_segments.front().m_firstRecord) // Older files may have been recycled
+		{
+			return EXEC_FAILURE;
+		}
+		size_t low = 0; // Last file starting at or before record, files are sorted by first record
+		size_t high = m_segments.size();
+		while(high - low > 1)
+		{
+			size_t middle = (low + high) / 2;
+			(m_segments[middle].m_firstRecord <= record ? low : high) = middle;
+		}
+		while(m_segments[low].m_recordNb == 0 || record >= m_segments[low].m_firstRecord + m_segments[low].m_recordNb) // Skip empty files
+		{
+			++low;
+		}
+
+		std::vector<indexEntry> entries;
+		loadIndex(indexName(m_segments[low].m_name), entries); // No index means reading from the start
+		unsigned long long first = m_segments[low].m_firstRecord;
+		unsigned long long offset = 0;
+		for(size_t i = entries.size(); i > 0; --i) // Indexes are small, last entries are the most likely
+		{
+			if(entries[i - 1].m_record <= record)
+			{
+				first = entries[i - 1].m_record;
+				offset = entries[i - 1].m_offset;
+				break;
+			}
+		}
+		if(openSegment(low, offset) == EXEC_FAILURE)
+		{
+			return EXEC_FAILURE;
+		}
+		for(; first < record; ++first)
+		{
+			m_file.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+		}
+		return m_file ? EXEC_SUCCESS : EXEC_FAILURE;
+	}
+
+	int splitReader::seekTime(unsigned long long time)
+	{
+		for(size_t s = 0; s < m_segments.size(); ++s)
+		{
+			if(m_segments[s].m_recordNb == 0 || m_segments[s].m_lastTime < time)
+			{
+				continue;
+			}
+			std::vector<indexEntry> entries;
+			loadIndex(indexName(m_segments[s].m_name), entries);
+			unsigned long long offset = 0;
+			for(size_t i = entries.size(); i > 0; --i) // Records before this entry are all older than time
+			{
+				if(entries[i - 1].m_time < time)
+				{
+					offset = entries[i - 1].m_offset;
+					break;
+				}
+			}
+			return openSegment(s, offset);
+		}
+		return EXEC_FAILURE;
+	}
+
+	bool splitReader::getLine(std::string& line)
+	{
+		while(m_current < m_segments.size())
+		{
+			if(!m_open && openSegment(m_current, 0) == EXEC_FAILURE) // Lines of a complete file must not be skipped
+			{
+				return false;
+			}
+			if(std::getline(m_file, line))
+			{
+				return true;
+			}
+			closeSegment(); // Go on with next file
+			++m_current;
+		}
+		return false;
+	}
+
+	int splitReader::openSegment(size_t i, unsigned long long offset)
+	{
+		closeSegment();
+		m_current = i;
+		if(m_fileBuf.open(m_segments[i].m_name.c_str(), std::ios::in | std::ios::binary) != NULL)
+		{
+			m_file.rdbuf(&m_fileBuf);
+		}
+		else
+		{
+			std::string compressed;
+			std::vector<char> data;
+			if(findCompressed(m_segments[i].m_name, compressed) == EXEC_FAILURE || decompressFile(compressed, data) == EXEC_FAILURE)
+			{
+				return EXEC_FAILURE;
+			}
+			m_memoryBuf.str(std::string(data.begin(), data.end()));
+			m_file.rdbuf(&m_memoryBuf);
+		}
+		m_open = true;
+		if(!m_file.seekg(offset))
+		{
+			return EXEC_FAILURE;
+		}
+		return EXEC_SUCCESS;
+	}
+
+	void splitReader::closeSegment()
+	{
+		m_fileBuf.close();
+		m_memoryBuf.str(std::string());
+		m_file.rdbuf(&m_fileBuf); // Also clears state flags
+		m_open = false;
+	}
+}
+
+//  ______________________________
+// |                              |
+// |    ______________________    |       
+// |   |                      |   |
+// |   |         sign         |   |
+// |   |        coding        |   |
+// |   |        dw@rf         |   |
+// |   |         1.0          |   |
+// |   |______________________|   |
+// |                              |
+// |______________________________|
+//               |  |           
+//               |  |             
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |__|
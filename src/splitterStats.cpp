@@ -0,0 +1,243 @@
+/*!
+ * @file splitterStats.cpp
+ * @brief Statistics of file splitters and their text export
+ * @author Sign Coding Dwarf
+ * @version 1.0
+ * @date 19 October 2026
+ *
+ * Implementation of the statistics counters and of their export in the Prometheus text format.
+ *
+ */
+
+/*
+Copyright 2016 SignCodingDwarf
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "splitterStats.h"
+
+#include <iostream>
+#include <sstream>
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace dwf_utils
+{
+	splitterStats::splitterStats() : m_bytes(0), m_records(0), m_rotations(0), m_rotationTime(0), m_maxRotationTime(0), m_openFailures(0), m_closeFailures(0), m_queueDepth(0), m_maxQueueDepth(0), m_dropped(0), m_durability(), m_compression()
+	{
+		std::fill(m_rotationHistogram, m_rotationHistogram + SPLITTER_LATENCY_BUCKETS, 0ULL);
+	}
+
+	splitterCounters::splitterCounters() : m_bytes(0), m_records(0), m_rotations(0), m_rotationTime(0), m_maxRotationTime(0), m_openFailures(0), m_closeFailures(0)
+	{
+		for(unsigned int i = 0; i < SPLITTER_LATENCY_BUCKETS; ++i)
+		{
+			m_rotationHistogram[i].store(0, std::memory_order_relaxed);
+		}
+	}
+
+	void splitterCounters::addRotation(unsigned long long time)
+	{
+		unsigned int bucket = 0;
+		while(bucket < SPLITTER_LATENCY_BUCKETS - 1 && time >= (1ULL << bucket))
+		{
+			++bucket;
+		}
+		add(m_rotationHistogram[bucket], 1);
+		add(m_rotations, 1);
+		add(m_rotationTime, time);
+		if(time > m_maxRotationTime.load(std::memory_order_relaxed))
+		{
+			m_maxRotationTime.store(time, std::memory_order_relaxed);
+		}
+	}
+
+	void splitterCounters::load(splitterStats& stats) const
+	{
+		stats.m_bytes = m_bytes.load(std::memory_order_relaxed);
+		stats.m_records = m_records.load(std::memory_order_relaxed);
+		stats.m_rotations = m_rotations.load(std::memory_order_relaxed);
+		stats.m_rotationTime = m_rotationTime.load(std::memory_order_relaxed);
+		stats.m_maxRotationTime = m_maxRotationTime.load(std::memory_order_relaxed);
+		for(unsigned int i = 0; i < SPLITTER_LATENCY_BUCKETS; ++i)
+		{
+			stats.m_rotationHistogram[i] = m_rotationHistogram[i].load(std::memory_order_relaxed);
+		}
+		stats.m_openFailures = m_openFailures.load(std::memory_order_relaxed);
+		stats.m_closeFailures = m_closeFailures.load(std::memory_order_relaxed);
+	}
+
+	void mergeStats(splitterStats& total, splitterStats const& stats)
+	{
+		total.m_bytes += stats.m_bytes;
+		total.m_records += stats.m_records;
+		total.m_rotations += stats.m_rotations;
+		total.m_rotationTime += stats.m_rotationTime;
+		total.m_maxRotationTime = std::max(total.m_maxRotationTime, stats.m_maxRotationTime);
+		for(unsigned int i = 0; i < SPLITTER_LATENCY_BUCKETS; ++i)
+		{
+			total.m_rotationHistogram[i] += stats.m_rotationHistogram[i];
+		}
+		total.m_openFailures += stats.m_openFailures;
+		total.m_closeFailures += stats.m_closeFailures;
+		total.m_queueDepth += stats.m_queueDepth;
+		total.m_maxQueueDepth = std::max(total.m_maxQueueDepth, stats.m_maxQueueDepth);
+		total.m_dropped += stats.m_dropped;
+
+		total.m_durability.m_syncNb += stats.m_durability.m_syncNb;
+		total.m_durability.m_syncTime += stats.m_durability.m_syncTime;
+		total.m_durability.m_maxSyncTime = std::max(total.m_durability.m_maxSyncTime, stats.m_durability.m_maxSyncTime);
+		total.m_durability.m_bytes += stats.m_durability.m_bytes;
+		total.m_durability.m_released += stats.m_durability.m_released;
+		total.m_durability.m_maxBatch = std::max(total.m_durability.m_maxBatch, stats.m_durability.m_maxBatch);
+
+		total.m_compression.m_queued += stats.m_compression.m_queued;
+		total.m_compression.m_compressed += stats.m_compression.m_compressed;
+		total.m_compression.m_skipped += stats.m_compression.m_skipped;
+		total.m_compression.m_failed += stats.m_compression.m_failed;
+		total.m_compression.m_rawBytes += stats.m_compression.m_rawBytes;
+		total.m_compression.m_compressedBytes += stats.m_compression.m_compressedBytes;
+		total.m_compression.m_time += stats.m_compression.m_time;
+		total.m_compression.m_maxDepth = std::max(total.m_compression.m_maxDepth, stats.m_compression.m_maxDepth);
+	}
+
+	/*!
+	* @brief Append a metric to a text exposition
+	* @param text : flux receiving the lines
+	* @param splitters : statistics of each splitter with the value of its label
+	* @param name : name of the metric without the dwf_splitter_ prefix
+	* @param type : counter or gauge
+	* @param help : description of the metric
+	* @param value : pointer to the member of splitterStats giving the value
+	*
+	*/
+	static void appendMetric(std::ostringstream& text, std::vector<std::pair<std::string, splitterStats> > const& splitters, const char* name, const char* type, const char* help, unsigned long long splitterStats::* value)
+	{
+		text << "# HELP dwf_splitter_" << name << " " << help << "\n";
+		text << "# TYPE dwf_splitter_" << name << " " << type << "\n";
+		for(size_t i = 0; i < splitters.size(); ++i)
+		{
+			text << "dwf_splitter_" << name << "{splitter=\"" << splitters[i].first << "\"} " << splitters[i].second.*value << "\n";
+		}
+	}
+
+	std::string formatStats(std::vector<std::pair<std::string, splitterStats> > const& splitters)
+	{
+		std::ostringstream text;
+		appendMetric(text, splitters, "bytes_total", "counter", "Bytes written in files.", &splitterStats::m_bytes);
+		appendMetric(text, splitters, "records_total", "counter", "Records written in files.", &splitterStats::m_records);
+		appendMetric(text, splitters, "open_failures_total", "counter", "Files that could not be opened.", &splitterStats::m_openFailures);
+		appendMetric(text, splitters, "close_failures_total", "counter", "Files that could not be flushed or closed.", &splitterStats::m_closeFailures);
+		appendMetric(text, splitters, "queue_depth", "gauge", "Records waiting for the writer thread.", &splitterStats::m_queueDepth);
+		appendMetric(text, splitters, "queue_depth_max", "gauge", "Largest number of records found waiting by the writer thread.", &splitterStats::m_maxQueueDepth);
+		appendMetric(text, splitters, "dropped_total", "counter", "Submitted records lost because files could not be written.", &splitterStats::m_dropped);
+
+		text << "# HELP dwf_splitter_rotation_seconds File change latency.\n";
+		text << "# TYPE dwf_splitter_rotation_seconds histogram\n";
+		for(size_t i = 0; i < splitters.size(); ++i)
+		{
+			splitterStats const& stats = splitters[i].second;
+			std::string label = "splitter=\"" + splitters[i].first + "\"";
+			unsigned long long cumulated = 0;
+			for(unsigned int b = 0; b < SPLITTER_LATENCY_BUCKETS - 1; ++b)
+			{
+				cumulated += stats.m_rotationHistogram[b];
+				text << "dwf_splitter_rotation_seconds_bucket{" << label << ",le=\"" << (1ULL << b) / 1e6 << "\"} " << cumulated << "\n";
+			}
+			text << "dwf_splitter_rotation_seconds_bucket{" << label << ",le=\"+Inf\"} " << stats.m_rotations << "\n";
+			text << "dwf_splitter_rotation_seconds_sum{" << label << "} " << stats.m_rotationTime / 1e6 << "\n";
+			text << "dwf_splitter_rotation_seconds_count{" << label << "} " << stats.m_rotations << "\n";
+		}
+
+		text << "# HELP dwf_splitter_rotation_seconds_max Longest file change.\n";
+		text << "# TYPE dwf_splitter_rotation_seconds_max gauge\n";
+		for(size_t i = 0; i < splitters.size(); ++i)
+		{
+			text << "dwf_splitter_rotation_seconds_max{splitter=\"" << splitters[i].first << "\"} " << splitters[i].second.m_maxRotationTime / 1e6 << "\n";
+		}
+		text << "# HELP dwf_splitter_sync_total Flushes to disk.\n";
+		text << "# TYPE dwf_splitter_sync_total counter\n";
+		for(size_t i = 0; i < splitters.size(); ++i)
+		{
+			text << "dwf_splitter_sync_total{splitter=\"" << splitters[i].first << "\"} " << splitters[i].second.m_durability.m_syncNb << "\n";
+		}
+		text << "# HELP dwf_splitter_compression_skipped_total Complete files kept raw because the compression queue was full.\n";
+		text << "# TYPE dwf_splitter_compression_skipped_total counter\n";
+		for(size_t i = 0; i < splitters.size(); ++i)
+		{
+			text << "dwf_splitter_compression_skipped_total{splitter=\"" << splitters[i].first << "\"} " << splitters[i].second.m_compression.m_skipped << "\n";
+		}
+		return text.str();
+	}
+
+	int exportStats(std::string const& fileName, std::string const& text)
+	{
+		std::string temporary = fileName + ".tmp";
+		int fd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+		if(fd < 0)
+		{
+			return EXEC_FAILURE;
+		}
+		size_t done = 0;
+		while(done < text.size())
+		{
+			ssize_t written = ::write(fd, text.data() + done, text.size() - done);
+			if(written < 0 && errno == EINTR)
+			{
+				continue;
+			}
+			if(written <= 0)
+			{
+				break;
+			}
+			done += written;
+		}
+		if(::close(fd) != 0 || done < text.size() || rename(temporary.c_str(), fileName.c_str()) != 0)
+		{
+#if DEBUG
+			std::cerr << "Could not export statistics to " << fileName << std::endl;
+#endif
+			unlink(temporary.c_str());
+			return EXEC_FAILURE;
+		}
+		return EXEC_SUCCESS;
+	}
+}
+
+//  ______________________________
+// |                              |
+// |    ______________________    |       
+// |   |                      |   |
+// |   |         sign         |   |
+// |   |        coding        |   |
+// |   |        dw@rf         |   |
+// |   |         1.0          |   |
+// |   |______________________|   |
+// |                              |
+// |______________________________|
+//               |  |           
+//               |  |             
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |__|
@@ -0,0 +1,460 @@
+/*!
+ * @file treeFingerprint.cpp
+ * @brief Class used to know if the content of a directory tree changed
+ * @author Sign Coding Dwarf
+ * @version 1.0
+ * @date 19 October 2026
+ *
+ * Implementation of the class computing a digest of a directory tree.
+ * The tree is first listed by a dirWalker, then the files missing from the cache are hashed by a pool of threads and the sorted entries are hashed together.
+ *
+ */
+
+/*
+Copyright 2016 SignCodingDwarf
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "treeFingerprint.h"
+#include "dirWalker.h"
+#include "pathBuffer.h"
+#include "xxHash.h"
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <ctime>
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <cinttypes>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+namespace dwf_utils
+{
+	/*! \struct treeEntry
+	* \brief Entry of the tree being fingerprinted
+	*/
+	struct treeEntry
+	{
+		std::string m_path; /*!< Path relative to the root */
+		entryType m_type; /*!< Type of the entry, links not being followed */
+		unsigned long long m_size; /*!< Size of the file */
+		long long m_mtime; /*!< Modification time of the file in seconds */
+		long m_mtimeNsec; /*!< Nanoseconds of the modification time */
+		uint64_t m_hash; /*!< Hash of the file content or of the link target */
+		bool m_hashed; /*!< TRUE if m_hash is known */
+		bool m_failed; /*!< TRUE if the entry could not be read when listed */
+	};
+
+	/*! \struct cachedHash
+	* \brief Hash of a file kept between computations
+	*/
+	struct cachedHash
+	{
+		uint64_t m_hash; /*!< Hash of the file content */
+		unsigned long long m_size; /*!< Size of the file when hashed */
+		long long m_mtime; /*!< Modification time of the file in seconds when hashed */
+		long m_mtimeNsec; /*!< Nanoseconds of the modification time */
+	};
+
+	typedef std::unordered_map<std::string, cachedHash> hashCache; /*!< Cached hashes by path relative to the root */
+
+	static const char* CACHE_HEADER = "dwf_tree_cache 1"; /*!< First word and version of a cache file */
+
+	/*!
+	* @brief Read a cache file
+	* @param fileName : name of the cache file
+	* @param root : root the cache must have been written for
+	* @param cache : receives the cached hashes
+	*
+	* Missing, unreadable or foreign caches give an empty cache, every file being hashed again.
+	* Lines are : hash in hexadecimal, size, modification time seconds and nanoseconds, path length and path.
+	*
+	*/
+	static void loadCache(std::string const& fileName, std::string const& root, hashCache& cache)
+	{
+		cache.clear();
+		std::ifstream in(fileName.c_str(), std::ios::binary);
+		std::string line;
+		if(!in || !std::getline(in, line) || line != std::string(CACHE_HEADER) + " " + root)
+		{
+			return;
+		}
+		while(in)
+		{
+			std::string hash;
+			cachedHash entry;
+			size_t length = 0;
+			if(!(in >> hash >> entry.m_size >> entry.m_mtime >> entry.m_mtimeNsec >> length) || in.get() != ' ')
+			{
+				break;
+			}
+			std::string path(length, '\0');
+			if(!in.read(&path[0], length) || in.get() != '\n')
+			{
+				break;
+			}
+			entry.m_hash = strtoull(hash.c_str(), NULL, 16);
+			cache[path] = entry;
+		}
+	}
+
+	/*!
+	* @brief Write a cache file
+	* @param fileName : name of the cache file
+	* @param root : root of the tree
+	* @param entries : entries of the tree
+	* @param racyTime : files modified at or after this time are left out
+	* @return EXEC_SUCCESS if file could be written and EXEC_FAILURE otherwise
+	*
+	* Cache is written in fileName.tmp then renamed, so that an interrupted computation leaves the previous cache.
+	*
+	*/
+	static int saveCache(std::string const& fileName, std::string const& root, std::vector<treeEntry> const& entries, time_t racyTime)
+	{
+		std::string text = std::string(CACHE_HEADER) + " " + root + "\n";
+		char line[96];
+		for(size_t i = 0; i < entries.size(); ++i)
+		{
+			treeEntry const& entry = entries[i];
+			if(entry.m_type != ENTRY_FILE || !entry.m_hashed || entry.m_mtime >= racyTime) // A later change in the same clock tick could not be seen
+			{
+				continue;
+			}
+			snprintf(line, sizeof(line), "%016" PRIx64 " %llu %lld %ld %zu ", entry.m_hash, entry.m_size, entry.m_mtime, entry.m_mtimeNsec, entry.m_path.size());
+			text += line;
+			text += entry.m_path;
+			text += '\n';
+		}
+
+		std::string temporary = fileName + ".tmp";
+		int fd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+		if(fd < 0)
+		{
+			return EXEC_FAILURE;
+		}
+		size_t done = 0;
+		while(done < text.size())
+		{
+			ssize_t written = ::write(fd, text.data() + done, text.size() - done);
+			if(written < 0 && errno == EINTR)
+			{
+				continue;
+			}
+			if(written <= 0)
+			{
+				break;
+			}
+			done += written;
+		}
+		if(::close(fd) != 0 || done < text.size() || rename(temporary.c_str(), fileName.c_str()) != 0)
+		{
+#if DEBUG
+			std::cerr << "Could not write fingerprint cache " << fileName << std::endl;
+#endif
+			unlink(temporary.c_str());
+			return EXEC_FAILURE;
+		}
+		return EXEC_SUCCESS;
+	}
+
+	/*!
+	* @brief Hash the content of a file
+	* @param path : path of the file
+	* @param buffer : buffer used to read the file
+	* @param hash : receives the hash
+	* @param bytes : receives the number of bytes read
+	* @return EXEC_SUCCESS if file could be read and EXEC_FAILURE otherwise
+	*
+	*/
+	static int hashFile(const char* path, std::vector<char>& buffer, uint64_t& hash, unsigned long long& bytes)
+	{
+		int fd = ::open(path, O_RDONLY | O_CLOEXEC | O_NOFOLLOW);
+		if(fd < 0)
+		{
+#if DEBUG
+			std::cerr << "Could not open " << path << " : " << strerror(errno) << std::endl;
+#endif
+			return EXEC_FAILURE;
+		}
+#ifdef POSIX_FADV_SEQUENTIAL
+		posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+		xxHash64State state;
+		bytes = 0;
+		while(true)
+		{
+			ssize_t size = ::read(fd, &buffer[0], buffer.size());
+			if(size < 0 && errno == EINTR)
+			{
+				continue;
+			}
+			if(size < 0)
+			{
+#if DEBUG
+				std::cerr << "Could not read " << path << " : " << strerror(errno) << std::endl;
+#endif
+				::close(fd);
+				return EXEC_FAILURE;
+			}
+			if(size == 0)
+			{
+				break;
+			}
+			state.update(&buffer[0], size);
+			bytes += size;
+		}
+		::close(fd);
+		hash = state.digest();
+		return EXEC_SUCCESS;
+	}
+
+	treeFingerprint::treeFingerprint(fingerprintOptions const& options) : m_options(options), m_entryNb(0), m_hashedNb(0), m_cachedNb(0), m_hashedBytes(0), m_errorNb(0)
+	{
+		if(m_options.m_threadNb == 0)
+		{
+			m_options.m_threadNb = std::max(1u, std::thread::hardware_concurrency());
+		}
+	}
+
+	treeFingerprint::~treeFingerprint()
+	{
+	}
+
+	int treeFingerprint::compute(std::string const& root, uint64_t& digest)
+	{
+		time_t racyTime = time(NULL) - FINGERPRINT_RACY_DELAY;
+		std::string prefix = root;
+		if(prefix.empty() || prefix[prefix.size() - 1] != '/')
+		{
+			prefix += '/';
+		}
+		hashCache cache;
+		if(!m_options.m_cacheFile.empty())
+		{
+			loadCache(m_options.m_cacheFile, root, cache);
+		}
+
+		// List the tree, links being read while their directory is open
+		std::vector<treeEntry> entries;
+		std::mutex entriesMutex;
+		std::atomic<unsigned long long> errorNb(0);
+		walkerOptions walkOptions;
+		walkOptions.m_threadNb = m_options.m_threadNb;
+		walkOptions.m_stat = true;
+		dirWalker walker(walkOptions);
+		walker.walk(root, [&](dirEntry const& found)
+		{
+			treeEntry entry;
+			entry.m_path = found.m_dir.substr(prefix.size()) + found.m_name;
+			entry.m_type = found.m_type;
+			entry.m_size = 0;
+			entry.m_mtime = 0;
+			entry.m_mtimeNsec = 0;
+			entry.m_hash = 0;
+			entry.m_hashed = false;
+			entry.m_failed = false;
+			if(found.m_type == ENTRY_FILE)
+			{
+				if(found.m_stat == NULL)
+				{
+					entry.m_failed = true;
+					errorNb.fetch_add(1, std::memory_order_relaxed);
+				}
+				else
+				{
+					entry.m_size = found.m_stat->st_size;
+					entry.m_mtime = found.m_stat->st_mtim.tv_sec;
+					entry.m_mtimeNsec = found.m_stat->st_mtim.tv_nsec;
+				}
+			}
+			else if(found.m_type == ENTRY_LINK)
+			{
+				char target[PATH_BUFFER_SIZE * 16];
+				ssize_t size = readlinkat(found.m_dirFd, found.m_name, target, sizeof(target));
+				if(size < 0 || size == static_cast<ssize_t>(sizeof(target)))
+				{
+					entry.m_failed = true;
+					errorNb.fetch_add(1, std::memory_order_relaxed);
+				}
+				else
+				{
+					entry.m_hash = xxHash64(target, size);
+					entry.m_hashed = true;
+				}
+			}
+			std::lock_guard<std::mutex> lock(entriesMutex);
+			entries.push_back(std::move(entry));
+			return true;
+		});
+		errorNb.fetch_add(walker.getErrorNb(), std::memory_order_relaxed);
+
+		// Take unchanged files from cache and hash the others
+		std::vector<size_t> toHash;
+		m_cachedNb = 0;
+		for(size_t i = 0; i < entries.size(); ++i)
+		{
+			treeEntry& entry = entries[i];
+			if(entry.m_type != ENTRY_FILE || entry.m_failed)
+			{
+				continue;
+			}
+			hashCache::const_iterator cached = cache.find(entry.m_path);
+			if(cached != cache.end() && cached->second.m_size == entry.m_size && cached->second.m_mtime == entry.m_mtime && cached->second.m_mtimeNsec == entry.m_mtimeNsec)
+			{
+				entry.m_hash = cached->second.m_hash;
+				entry.m_hashed = true;
+				++m_cachedNb;
+			}
+			else
+			{
+				toHash.push_back(i);
+			}
+		}
+
+		std::atomic<size_t> next(0);
+		std::atomic<unsigned long long> hashedBytes(0);
+		auto worker = [&]()
+		{
+			std::vector<char> buffer(FINGERPRINT_READ_SIZE);
+			pathBuffer path(prefix);
+			size_t rootSize = path.size();
+			size_t index;
+			while((index = next.fetch_add(1)) < toHash.size())
+			{
+				treeEntry& entry = entries[toHash[index]];
+				path.truncate(rootSize);
+				path.join(entry.m_path);
+				unsigned long long bytes = 0;
+				if(hashFile(path.c_str(), buffer, entry.m_hash, bytes) == EXEC_SUCCESS)
+				{
+					entry.m_hashed = true;
+					if(bytes != entry.m_size) // Changed since listed, must not be cached with the listed status
+					{
+						entry.m_size = bytes;
+						entry.m_mtime = racyTime;
+					}
+				}
+				else
+				{
+					errorNb.fetch_add(1, std::memory_order_relaxed);
+				}
+				hashedBytes.fetch_add(bytes, std::memory_order_relaxed);
+			}
+		};
+		std::vector<std::thread> threads;
+		for(unsigned int i = 1; i < std::min<size_t>(m_options.m_threadNb, toHash.size()); ++i)
+		{
+			threads.push_back(std::thread(worker));
+		}
+		worker(); // Calling thread also works
+		for(size_t i = 0; i < threads.size(); ++i)
+		{
+			threads[i].join();
+		}
+
+		// Hash the sorted entries, so that the digest does not depend on listing order
+		std::sort(entries.begin(), entries.end(), [](treeEntry const& a, treeEntry const& b)
+		{
+			return a.m_path < b.m_path;
+		});
+		xxHash64State state;
+		for(size_t i = 0; i < entries.size(); ++i)
+		{
+			treeEntry const& entry = entries[i];
+			unsigned char record[17];
+			record[0] = static_cast<unsigned char>(entry.m_type);
+			size_t recordSize = 1;
+			if(entry.m_type == ENTRY_FILE || entry.m_type == ENTRY_LINK)
+			{
+				uint64_t values[2] = {entry.m_type == ENTRY_FILE ? entry.m_size : 0, entry.m_hash};
+				for(int v = 0; v < 2; ++v)
+				{
+					for(int b = 0; b < 8; ++b) // Little endian whatever the processor
+					{
+						record[recordSize++] = static_cast<unsigned char>(values[v] >> (8 * b));
+					}
+				}
+			}
+			state.update(entry.m_path.c_str(), entry.m_path.size() + 1); // Terminating null separates the path from the record
+			state.update(record, recordSize);
+		}
+		digest = state.digest();
+
+		m_entryNb = entries.size();
+		m_hashedNb = toHash.size();
+		m_hashedBytes = hashedBytes.load();
+		m_errorNb = errorNb.load();
+		if(!m_options.m_cacheFile.empty())
+		{
+			saveCache(m_options.m_cacheFile, root, entries, racyTime);
+		}
+		return m_errorNb == 0 ? EXEC_SUCCESS : EXEC_FAILURE;
+	}
+
+	unsigned long long treeFingerprint::getEntryNb() const
+	{
+		return m_entryNb;
+	}
+
+	unsigned long long treeFingerprint::getHashedNb() const
+	{
+		return m_hashedNb;
+	}
+
+	unsigned long long treeFingerprint::getCachedNb() const
+	{
+		return m_cachedNb;
+	}
+
+	unsigned long long treeFingerprint::getHashedBytes() const
+	{
+		return m_hashedBytes;
+	}
+
+	unsigned long long treeFingerprint::getErrorNb() const
+	{
+		return m_errorNb;
+	}
+}
+//  ______________________________
+// |                              |
+// |    ______________________    |       
+// |   |                      |   |
+// |   |         sign         |   |
+// |   |        coding        |   |
+// |   |        dw@rf         |   |
+// |   |         1.0          |   |
+// |   |______________________|   |
+// |                              |
+// |______________________________|
+//               |  |           
+//               |  |             
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |__|
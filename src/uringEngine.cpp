@@ -0,0 +1,411 @@
+/*!
+ * @file uringEngine.cpp
+ * @brief Class used to write the buffers of split files with io_uring
+ * @author Sign Coding Dwarf
+ * @version 1.0
+ * @date 19 October 2026
+ *
+ * Implementation of the write engine keeping several buffers in flight with the Linux io_uring interface.
+ * The ring is driven with raw system calls so that no external library is required.
+ *
+ */
+
+/* 
+Copyright 2016 SignCodingDwarf
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "uringEngine.h"
+
+#include <iostream>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
+#include <sys/syscall.h>
+
+#ifndef USE_IO_URING
+#define USE_IO_URING 0
+#endif
+
+#if USE_IO_URING
+#include <linux/io_uring.h>
+#endif
+
+namespace dwf_utils
+{
+	uringEngine* uringEngine::create(size_t bufferSize, unsigned int depth)
+	{
+		uringEngine* engine = new uringEngine(bufferSize > 0 ? bufferSize : 1, depth > 0 ? depth : 1);
+		if(engine->setUp() == EXEC_FAILURE)
+		{
+#if DEBUG
+			std::cerr << "io_uring is not available, using pwrite" << std::endl;
+#endif
+			delete engine;
+			return NULL;
+		}
+		return engine;
+	}
+
+	uringEngine::uringEngine(size_t bufferSize, unsigned int depth) : writeEngine(), m_ring(-1), m_depth(depth), m_bufferSize(bufferSize), m_memory(NULL), m_free(), m_bufferOffset(depth, 0), m_bufferLength(depth, 0), m_current(-1), m_queued(0), m_inFlight(0), m_failed(false), m_sqRing(NULL), m_sqRingSize(0), m_cqRing(NULL), m_cqRingSize(0), m_sqes(NULL), m_sqesSize(0), m_sqTail(NULL), m_sqMask(NULL), m_sqArray(NULL), m_cqHead(NULL), m_cqTail(NULL), m_cqMask(NULL), m_cqes(NULL)
+	{
+	}
+
+	uringEngine::~uringEngine()
+	{
+		if(m_ring >= 0)
+		{
+			drain();
+		}
+		tearDown();
+		free(m_memory);
+	}
+
+	int uringEngine::detach()
+	{
+		int result = writeEngine::detach();
+		m_failed = false;
+		if(m_ring < 0) // Ring could not be set up again after a failure, try for the next file
+		{
+			reset();
+		}
+		return result;
+	}
+
+	char* uringEngine::getBuffer(size_t& size)
+	{
+		size = m_bufferSize;
+		if(m_current < 0)
+		{
+			while(m_free.empty() && m_ring >= 0) // Every buffer is in flight, wait for the oldest
+			{
+				submit(1);
+			}
+			m_current = m_free.back();
+			m_free.pop_back();
+		}
+		return m_memory + m_current * m_bufferSize;
+	}
+
+	int uringEngine::commit(size_t size)
+	{
+#if USE_IO_URING
+		if(size == 0)
+		{
+			return m_failed ? EXEC_FAILURE : EXEC_SUCCESS;
+		}
+		if(m_current < 0 || m_fd < 0 || m_ring < 0)
+		{
+			return EXEC_FAILURE;
+		}
+
+		unsigned int index = static_cast<unsigned int>(m_current);
+		unsigned int tail = *m_sqTail; // Only this thread writes the tail
+		unsigned int slot = tail & *m_sqMask;
+		io_uring_sqe* sqe = static_cast<io_uring_sqe*>(m_sqes) + slot;
+		std::memset(sqe, 0, sizeof(io_uring_sqe));
+		sqe->opcode = IORING_OP_WRITE_FIXED;
+		sqe->fd = m_fd;
+		sqe->addr = reinterpret_cast<unsigned long long>(m_memory + index * m_bufferSize);
+		sqe->len = static_cast<unsigned int>(size);
+		sqe->off = m_offset;
+		sqe->buf_index = static_cast<unsigned short>(index);
+		sqe->user_data = index;
+		m_sqArray[slot] = slot;
+		__atomic_store_n(m_sqTail, tail + 1, __ATOMIC_RELEASE); // Publish entry to the kernel
+
+		m_bufferOffset[index] = m_offset;
+		m_bufferLength[index] = size;
+		m_offset += size;
+		m_current = -1;
+		++m_queued;
+
+		if(m_queued >= URING_SUBMIT_BATCH) // Group submissions to save system calls
+		{
+			submit(0);
+		}
+		return m_failed ? EXEC_FAILURE : EXEC_SUCCESS;
+#else
+		return EXEC_FAILURE;
+#endif
+	}
+
+	int uringEngine::drain()
+	{
+		while((m_queued > 0 || m_inFlight > 0) && m_ring >= 0) // Entries belong to the kernel until they complete, even after a failed write
+		{
+			submit(1);
+		}
+		return m_failed ? EXEC_FAILURE : EXEC_SUCCESS;
+	}
+
+	unsigned long long uringEngine::getWritten() const
+	{
+		if(m_queued == 0 && m_inFlight == 0)
+		{
+			return m_offset;
+		}
+		std::vector<bool> pending(m_depth, true);
+		for(size_t i = 0; i < m_free.size(); ++i)
+		{
+			pending[m_free[i]] = false;
+		}
+		if(m_current >= 0) // Not committed yet
+		{
+			pending[m_current] = false;
+		}
+		unsigned long long written = m_offset;
+		for(unsigned int i = 0; i < m_depth; ++i) // Completions may be out of order
+		{
+			if(pending[i] && m_bufferOffset[i] < written)
+			{
+				written = m_bufferOffset[i];
+			}
+		}
+		return written;
+	}
+
+	int uringEngine::setUp()
+	{
+#if USE_IO_URING
+		if(m_memory == NULL) // Buffers are kept when the ring is set up again
+		{
+			void* memory = NULL;
+			if(posix_memalign(&memory, 4096, m_depth * m_bufferSize) != 0)
+			{
+				return EXEC_FAILURE;
+			}
+			m_memory = static_cast<char*>(memory);
+		}
+		m_free.clear();
+		for(unsigned int i = 0; i < m_depth; ++i)
+		{
+			m_free.push_back(m_depth - 1 - i);
+		}
+
+		io_uring_params params;
+		std::memset(&params, 0, sizeof(params));
+		m_ring = static_cast<int>(syscall(__NR_io_uring_setup, m_depth, &params));
+		if(m_ring < 0)
+		{
+			return EXEC_FAILURE;
+		}
+
+		// Map rings
+		m_sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned int);
+		m_cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+		bool singleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+		if(singleMap && m_cqRingSize > m_sqRingSize)
+		{
+			m_sqRingSize = m_cqRingSize;
+		}
+		void* map = mmap(NULL, m_sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ring, IORING_OFF_SQ_RING);
+		if(map == MAP_FAILED)
+		{
+			return EXEC_FAILURE;
+		}
+		m_sqRing = map;
+		if(singleMap)
+		{
+			m_cqRing = m_sqRing;
+		}
+		else
+		{
+			map = mmap(NULL, m_cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ring, IORING_OFF_CQ_RING);
+			if(map == MAP_FAILED)
+			{
+				return EXEC_FAILURE;
+			}
+			m_cqRing = map;
+		}
+		m_sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+		map = mmap(NULL, m_sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ring, IORING_OFF_SQES);
+		if(map == MAP_FAILED)
+		{
+			return EXEC_FAILURE;
+		}
+		m_sqes = map;
+
+		char* sq = static_cast<char*>(m_sqRing);
+		char* cq = static_cast<char*>(m_cqRing);
+		m_sqTail = reinterpret_cast<unsigned int*>(sq + params.sq_off.tail);
+		m_sqMask = reinterpret_cast<unsigned int*>(sq + params.sq_off.ring_mask);
+		m_sqArray = reinterpret_cast<unsigned int*>(sq + params.sq_off.array);
+		m_cqHead = reinterpret_cast<unsigned int*>(cq + params.cq_off.head);
+		m_cqTail = reinterpret_cast<unsigned int*>(cq + params.cq_off.tail);
+		m_cqMask = reinterpret_cast<unsigned int*>(cq + params.cq_off.ring_mask);
+		m_cqes = cq + params.cq_off.cqes;
+
+		// Register buffers so that the kernel does not map them for every write
+		std::vector<iovec> buffers(m_depth);
+		for(unsigned int i = 0; i < m_depth; ++i)
+		{
+			buffers[i].iov_base = m_memory + i * m_bufferSize;
+			buffers[i].iov_len = m_bufferSize;
+		}
+		if(syscall(__NR_io_uring_register, m_ring, IORING_REGISTER_BUFFERS, &buffers[0], m_depth) < 0)
+		{
+			return EXEC_FAILURE;
+		}
+		return EXEC_SUCCESS;
+#else
+		return EXEC_FAILURE;
+#endif
+	}
+
+	void uringEngine::tearDown()
+	{
+		if(m_ring >= 0)
+		{
+			close(m_ring); // Also unregisters buffers and cancels pending writes
+			m_ring = -1;
+		}
+		if(m_sqes != NULL)
+		{
+			munmap(m_sqes, m_sqesSize);
+		}
+		if(m_cqRing != NULL && m_cqRing != m_sqRing)
+		{
+			munmap(m_cqRing, m_cqRingSize);
+		}
+		if(m_sqRing != NULL)
+		{
+			munmap(m_sqRing, m_sqRingSize);
+		}
+		m_sqRing = NULL;
+		m_cqRing = NULL;
+		m_sqes = NULL;
+		m_sqTail = NULL;
+		m_sqMask = NULL;
+		m_sqArray = NULL;
+		m_cqHead = NULL;
+		m_cqTail = NULL;
+		m_cqMask = NULL;
+		m_cqes = NULL;
+	}
+
+	void uringEngine::reset()
+	{
+#if DEBUG
+		std::cerr << "io_uring failed, setting it up again" << std::endl;
+#endif
+		tearDown();
+		m_queued = 0;
+		m_inFlight = 0;
+		m_current = -1;
+		if(setUp() == EXEC_FAILURE)
+		{
+			tearDown(); // Commits fail until a later reset succeeds
+		}
+	}
+
+	int uringEngine::submit(unsigned int waitNb)
+	{
+#if USE_IO_URING
+		if(m_ring < 0)
+		{
+			return EXEC_FAILURE;
+		}
+		if(m_queued + m_inFlight < waitNb) // Never wait for more completions than expected
+		{
+			waitNb = m_queued + m_inFlight;
+		}
+		unsigned int flags = waitNb > 0 ? IORING_ENTER_GETEVENTS : 0;
+		while(m_queued > 0 || waitNb > 0)
+		{
+			long submitted = syscall(__NR_io_uring_enter, m_ring, m_queued, waitNb, flags, NULL, 0);
+			if(submitted < 0)
+			{
+				if(errno == EINTR)
+				{
+					continue;
+				}
+				if(errno == EAGAIN || errno == EBUSY) // Completion ring is full, empty it first
+				{
+					reap();
+					continue;
+				}
+				m_failed = true;
+				reset(); // Published entries must not be submitted later with the descriptor of another file
+				return EXEC_FAILURE;
+			}
+			m_queued -= static_cast<unsigned int>(submitted);
+			m_inFlight += static_cast<unsigned int>(submitted);
+			break;
+		}
+		reap();
+		return m_failed ? EXEC_FAILURE : EXEC_SUCCESS;
+#else
+		(void)waitNb;
+		return EXEC_FAILURE;
+#endif
+	}
+
+	void uringEngine::reap()
+	{
+#if USE_IO_URING
+		unsigned int head = *m_cqHead;
+		unsigned int tail = __atomic_load_n(m_cqTail, __ATOMIC_ACQUIRE);
+		io_uring_cqe* cqes = static_cast<io_uring_cqe*>(m_cqes);
+		while(head != tail)
+		{
+			io_uring_cqe* cqe = cqes + (head & *m_cqMask);
+			unsigned int index = static_cast<unsigned int>(cqe->user_data);
+			if(cqe->res < 0)
+			{
+				m_failed = true;
+			}
+			else if(static_cast<size_t>(cqe->res) < m_bufferLength[index]) // Short write, rare on regular files
+			{
+				size_t done = static_cast<size_t>(cqe->res);
+				if(writeAt(m_fd, m_memory + index * m_bufferSize + done, m_bufferLength[index] - done, m_bufferOffset[index] + done) == EXEC_FAILURE)
+				{
+					m_failed = true;
+				}
+			}
+			m_free.push_back(index);
+			--m_inFlight;
+			++head;
+		}
+		__atomic_store_n(m_cqHead, head, __ATOMIC_RELEASE);
+#endif
+	}
+}
+
+//  ______________________________
+// |                              |
+// |    ______________________    |       
+// |   |                      |   |
+// |   |         sign         |   |
+// |   |        coding        |   |
+// |   |        dw@rf         |   |
+// |   |         1.0          |   |
+// |   |______________________|   |
+// |                              |
+// |______________________________|
+//               |  |           
+//               |  |             
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |__|
@@ -0,0 +1,124 @@
+/*!
+ * @file workerThread.cpp
+ * @brief Class used to run tasks in a background thread
+ * @author Sign Coding Dwarf
+ * @version 1.0
+ * @date 19 October 2026
+ *
+ * Implementation of the class used to run tasks in a background thread in the order they were posted.
+ * Used to move slow operations such as file opening or closing out of the writing thread.
+ *
+ */
+
+/* 
+Copyright 2016 SignCodingDwarf
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "workerThread.h"
+
+namespace dwf_utils
+{
+	workerThread::workerThread() : m_tasks(), m_running(0), m_stop(false)
+	{
+		m_thread = std::thread(&workerThread::run, this);
+	}
+
+	workerThread::~workerThread()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_stop = true;
+		}
+		m_posted.notify_one();
+		if(m_thread.joinable())
+		{
+			m_thread.join();
+		}
+	}
+
+	void workerThread::post(std::function<void()> task)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_tasks.push_back(std::move(task));
+		}
+		m_posted.notify_one();
+	}
+
+	void workerThread::wait()
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		while(!m_tasks.empty() || m_running > 0)
+		{
+			m_done.wait(lock);
+		}
+	}
+
+	size_t workerThread::getPending() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_tasks.size() + m_running;
+	}
+
+	void workerThread::run()
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		while(true)
+		{
+			if(m_tasks.empty())
+			{
+				if(m_stop) // Stop only once every task is done
+				{
+					break;
+				}
+				m_posted.wait(lock);
+				continue;
+			}
+
+			std::function<void()> task = std::move(m_tasks.front());
+			m_tasks.pop_front();
+			m_running = 1;
+			lock.unlock(); // Tasks are run without lock so that posting never waits for them
+			task();
+			lock.lock();
+			m_running = 0;
+			m_done.notify_all();
+		}
+	}
+}
+
+//  ______________________________
+// |                              |
+// |    ______________________    |       
+// |   |                      |   |
+// |   |         sign         |   |
+// |   |        coding        |   |
+// |   |        dw@rf         |   |
+// |   |         1.0          |   |
+// |   |______________________|   |
+// |                              |
+// |______________________________|
+//               |  |           
+//               |  |             
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |__|
@@ -0,0 +1,364 @@
+/*!
+ * @file writeEngine.cpp
+ * @brief Classes used to write the buffers of split files to the system
+ * @author Sign Coding Dwarf
+ * @version 1.0
+ * @date 19 October 2026
+ *
+ * Implementation of the interface of the engines used by segmentBuf to write its buffers into a file and of the default engine based on pwrite.
+ *
+ */
+
+/* 
+Copyright 2016 SignCodingDwarf
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "writeEngine.h"
+#include "uringEngine.h"
+#include "mmapEngine.h"
+#include "directEngine.h"
+
+#include <cstring>
+#include <cerrno>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/uio.h>
+#include <sys/stat.h>
+#ifdef __linux__
+#include <sys/sendfile.h>
+#endif
+
+namespace dwf_utils
+{
+	writeEngine::writeEngine() : m_fd(-1), m_offset(0)
+	{
+	}
+
+	writeEngine::~writeEngine()
+	{
+	}
+
+	int writeEngine::openFlags() const
+	{
+		return O_WRONLY;
+	}
+
+	int writeEngine::attach(int fd)
+	{
+		m_fd = fd;
+		m_offset = 0;
+		return fd >= 0 ? EXEC_SUCCESS : EXEC_FAILURE;
+	}
+
+	int writeEngine::detach()
+	{
+		int result = drain();
+		m_fd = -1;
+		m_offset = 0;
+		return result;
+	}
+
+	int writeEngine::write(const char* data, size_t size)
+	{
+		while(size > 0)
+		{
+			size_t capacity = 0;
+			char* buffer = getBuffer(capacity);
+			size_t chunk = std::min(capacity, size);
+			std::memcpy(buffer, data, chunk);
+			if(commit(chunk) == EXEC_FAILURE)
+			{
+				return EXEC_FAILURE;
+			}
+			data += chunk;
+			size -= chunk;
+		}
+		return EXEC_SUCCESS;
+	}
+
+	int writeEngine::commitWith(size_t size, const char* data, size_t dataSize)
+	{
+		if(size > 0 && commit(size) == EXEC_FAILURE)
+		{
+			return EXEC_FAILURE;
+		}
+		return write(data, dataSize);
+	}
+
+	long long writeEngine::transferFrom(int source, size_t size)
+	{
+		size_t capacity = 0;
+		char* buffer = getBuffer(capacity);
+		ssize_t got = -1;
+		do
+		{
+			got = read(source, buffer, std::min(capacity, size)); // Kernel copies directly into the buffer
+		}
+		while(got < 0 && errno == EINTR);
+		if(got <= 0)
+		{
+			return got;
+		}
+		return commit(got) == EXEC_SUCCESS ? got : -1;
+	}
+
+	int writeEngine::drain()
+	{
+		return EXEC_SUCCESS;
+	}
+
+	unsigned long long writeEngine::getOffset() const
+	{
+		return m_offset;
+	}
+
+	unsigned long long writeEngine::getWritten() const
+	{
+		return m_offset;
+	}
+
+	int writeEngine::writeAt(int fd, const char* data, size_t size, unsigned long long offset)
+	{
+		if(fd < 0)
+		{
+			return EXEC_FAILURE;
+		}
+		while(size > 0)
+		{
+			ssize_t written = pwrite(fd, data, size, offset);
+			if(written < 0)
+			{
+				if(errno == EINTR) // Interrupted by a signal, try again
+				{
+					continue;
+				}
+				return EXEC_FAILURE;
+			}
+			data += written;
+			size -= written;
+			offset += written;
+		}
+		return EXEC_SUCCESS;
+	}
+
+	pwriteEngine::pwriteEngine(size_t bufferSize) : writeEngine(), m_buffer(bufferSize > 0 ? bufferSize : 1), m_pipeError(0)
+	{
+		m_pipe[0] = -1;
+		m_pipe[1] = -1;
+	}
+
+	pwriteEngine::~pwriteEngine()
+	{
+		if(m_pipe[0] >= 0)
+		{
+			close(m_pipe[0]);
+			close(m_pipe[1]);
+		}
+	}
+
+	char* pwriteEngine::getBuffer(size_t& size)
+	{
+		size = m_buffer.size();
+		return &m_buffer[0];
+	}
+
+	int pwriteEngine::commit(size_t size)
+	{
+		return write(&m_buffer[0], size);
+	}
+
+	int pwriteEngine::write(const char* data, size_t size)
+	{
+		if(writeAt(m_fd, data, size, m_offset) == EXEC_FAILURE)
+		{
+			return EXEC_FAILURE;
+		}
+		m_offset += size;
+		return EXEC_SUCCESS;
+	}
+
+	int pwriteEngine::commitWith(size_t size, const char* data, size_t dataSize)
+	{
+		if(m_fd < 0)
+		{
+			return EXEC_FAILURE;
+		}
+		struct iovec blocks[2] = {{&m_buffer[0], size}, {const_cast<char*>(data), dataSize}};
+		int first = size > 0 ? 0 : 1;
+		unsigned long long offset = m_offset;
+		while(first < 2)
+		{
+			ssize_t written = pwritev(m_fd, blocks + first, 2 - first, offset);
+			if(written < 0)
+			{
+				if(errno == EINTR) // Interrupted by a signal, try again
+				{
+					continue;
+				}
+				return EXEC_FAILURE;
+			}
+			offset += written;
+			while(first < 2 && static_cast<size_t>(written) >= blocks[first].iov_len) // Skip blocks written entirely
+			{
+				written -= blocks[first].iov_len;
+				++first;
+			}
+			if(first < 2) // Partial write inside a block
+			{
+				blocks[first].iov_base = static_cast<char*>(blocks[first].iov_base) + written;
+				blocks[first].iov_len -= written;
+			}
+		}
+		m_offset = offset;
+		return EXEC_SUCCESS;
+	}
+
+	long long pwriteEngine::transferFrom(int source, size_t size)
+	{
+#ifdef __linux__
+		if(m_pipeError != 0) // Previous call moved part of its data then failed
+		{
+			errno = m_pipeError;
+			m_pipeError = 0;
+			return -1;
+		}
+		struct stat info;
+		if(m_fd < 0 || fstat(source, &info) != 0)
+		{
+			return -1;
+		}
+		loff_t offset = m_offset;
+		ssize_t moved = -1;
+		if(S_ISFIFO(info.st_mode))
+		{
+			do
+			{
+				moved = splice(source, NULL, m_fd, &offset, size, SPLICE_F_MOVE | SPLICE_F_MORE);
+			}
+			while(moved < 0 && errno == EINTR);
+		}
+		else if(S_ISREG(info.st_mode) || S_ISBLK(info.st_mode))
+		{
+			moved = copy_file_range(source, NULL, m_fd, &offset, size, 0); // May share blocks on file systems supporting it
+			if(moved < 0 && (errno == EXDEV || errno == EINVAL || errno == ENOSYS || errno == EOPNOTSUPP)) // Old kernel or other file system
+			{
+				if(lseek(m_fd, m_offset, SEEK_SET) < 0)
+				{
+					return -1;
+				}
+				moved = sendfile(m_fd, source, NULL, size); // Writes at the file position
+			}
+		}
+		else // Sockets and character devices go through a pipe, splice needing a pipe on one side
+		{
+			if(m_pipe[0] < 0)
+			{
+				if(pipe2(m_pipe, O_CLOEXEC) != 0)
+				{
+					return -1;
+				}
+				fcntl(m_pipe[1], F_SETPIPE_SZ, 1 << 20); // Fewer calls per socket, default size is kept on failure
+			}
+			do
+			{
+				moved = splice(source, NULL, m_pipe[1], NULL, size, SPLICE_F_MOVE | SPLICE_F_MORE);
+			}
+			while(moved < 0 && errno == EINTR);
+			ssize_t remaining = moved;
+			while(remaining > 0) // Pipe must be empty for next calls
+			{
+				ssize_t written = splice(m_pipe[0], NULL, m_fd, &offset, remaining, SPLICE_F_MOVE | SPLICE_F_MORE);
+				if(written < 0 && errno == EINTR)
+				{
+					continue;
+				}
+				if(written <= 0) // Bytes left in the pipe are lost, written ones stay in the file
+				{
+					int error = written < 0 ? errno : EIO;
+					close(m_pipe[0]);
+					close(m_pipe[1]);
+					m_pipe[0] = -1;
+					m_pipe[1] = -1;
+					if(remaining == moved)
+					{
+						errno = error;
+						return -1;
+					}
+					m_pipeError = error;
+					moved -= remaining; // Short count, like the other paths
+					break;
+				}
+				remaining -= written;
+			}
+		}
+		if(moved > 0)
+		{
+			m_offset += moved;
+		}
+		return moved;
+#else
+		return writeEngine::transferFrom(source, size);
+#endif
+	}
+
+	std::unique_ptr<writeEngine> createWriteEngine(writerMode mode, size_t bufferSize)
+	{
+		writeEngine* engine = NULL;
+		switch(mode)
+		{
+			case WRITER_URING:
+				engine = uringEngine::create(bufferSize);
+				break;
+			case WRITER_MMAP:
+				engine = new mmapEngine(bufferSize);
+				break;
+			case WRITER_DIRECT:
+				engine = directEngine::create(bufferSize);
+				break;
+			default:
+				break;
+		}
+		if(engine == NULL) // Default engine, also used when requested one is not supported
+		{
+			engine = new pwriteEngine(bufferSize);
+		}
+		return std::unique_ptr<writeEngine>(engine);
+	}
+}
+
+//  ______________________________
+// |                              |
+// |    ______________________    |       
+// |   |                      |   |
+// |   |         sign         |   |
+// |   |        coding        |   |
+// |   |        dw@rf         |   |
+// |   |         1.0          |   |
+// |   |______________________|   |
+// |                              |
+// |______________________________|
+//               |  |           
+//               |  |             
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |__|
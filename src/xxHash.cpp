@@ -0,0 +1,247 @@
+/*!
+ * @file xxHash.cpp
+ * @brief Functions used to hash data with the xxHash64 algorithm
+ * @author Sign Coding Dwarf
+ * @version 1.0
+ * @date 19 October 2026
+ *
+ * Implementation of the 64 bits xxHash. Data is read as little endian words whatever the processor, so that hashes can be stored and compared between machines.
+ *
+ */
+
+/*
+Copyright 2016 SignCodingDwarf
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "xxHash.h"
+#include <cstring>
+
+namespace dwf_utils
+{
+	static const uint64_t PRIME64_1 = 11400714785074694791ULL; /*!< First prime of xxHash64 */
+	static const uint64_t PRIME64_2 = 14029467366897019727ULL; /*!< Second prime of xxHash64 */
+	static const uint64_t PRIME64_3 = 1609587929392839161ULL; /*!< Third prime of xxHash64 */
+	static const uint64_t PRIME64_4 = 9650029242287828579ULL; /*!< Fourth prime of xxHash64 */
+	static const uint64_t PRIME64_5 = 2870177450012600261ULL; /*!< Fifth prime of xxHash64 */
+
+	/*!
+	* @brief Rotate bits to the left
+	* @param value : value to rotate
+	* @param bits : number of bits
+	* @return Rotated value
+	*
+	*/
+	static inline uint64_t rotateLeft(uint64_t value, int bits)
+	{
+		return (value << bits) | (value >> (64 - bits));
+	}
+
+	/*!
+	* @brief Read 8 little endian bytes
+	* @param data : position of the bytes
+	* @return The bytes as an integer
+	*
+	*/
+	static inline uint64_t read64(const unsigned char* data)
+	{
+		return static_cast<uint64_t>(data[0]) | (static_cast<uint64_t>(data[1]) << 8) | (static_cast<uint64_t>(data[2]) << 16) | (static_cast<uint64_t>(data[3]) << 24)
+			| (static_cast<uint64_t>(data[4]) << 32) | (static_cast<uint64_t>(data[5]) << 40) | (static_cast<uint64_t>(data[6]) << 48) | (static_cast<uint64_t>(data[7]) << 56);
+	}
+
+	/*!
+	* @brief Read 4 little endian bytes
+	* @param data : position of the bytes
+	* @return The bytes as an integer
+	*
+	*/
+	static inline uint64_t read32(const unsigned char* data)
+	{
+		return static_cast<uint64_t>(data[0]) | (static_cast<uint64_t>(data[1]) << 8) | (static_cast<uint64_t>(data[2]) << 16) | (static_cast<uint64_t>(data[3]) << 24);
+	}
+
+	/*!
+	* @brief Add 8 bytes to an accumulator
+	* @param accumulator : accumulator
+	* @param input : bytes to add
+	* @return New accumulator
+	*
+	*/
+	static inline uint64_t round64(uint64_t accumulator, uint64_t input)
+	{
+		accumulator += input * PRIME64_2;
+		return rotateLeft(accumulator, 31) * PRIME64_1;
+	}
+
+	/*!
+	* @brief Merge an accumulator into the hash
+	* @param hash : hash
+	* @param accumulator : accumulator to merge
+	* @return New hash
+	*
+	*/
+	static inline uint64_t mergeRound(uint64_t hash, uint64_t accumulator)
+	{
+		hash ^= round64(0, accumulator);
+		return hash * PRIME64_1 + PRIME64_4;
+	}
+
+	/*!
+	* @brief Hash the last bytes and mix the result
+	* @param hash : hash before the last bytes
+	* @param data : last bytes, fewer than 32
+	* @param size : number of last bytes
+	* @return Final hash
+	*
+	*/
+	static uint64_t finalize(uint64_t hash, const unsigned char* data, size_t size)
+	{
+		while(size >= 8)
+		{
+			hash ^= round64(0, read64(data));
+			hash = rotateLeft(hash, 27) * PRIME64_1 + PRIME64_4;
+			data += 8;
+			size -= 8;
+		}
+		if(size >= 4)
+		{
+			hash ^= read32(data) * PRIME64_1;
+			hash = rotateLeft(hash, 23) * PRIME64_2 + PRIME64_3;
+			data += 4;
+			size -= 4;
+		}
+		while(size > 0)
+		{
+			hash ^= *data * PRIME64_5;
+			hash = rotateLeft(hash, 11) * PRIME64_1;
+			++data;
+			--size;
+		}
+		hash ^= hash >> 33;
+		hash *= PRIME64_2;
+		hash ^= hash >> 29;
+		hash *= PRIME64_3;
+		hash ^= hash >> 32;
+		return hash;
+	}
+
+	uint64_t xxHash64(const void* data, size_t size, uint64_t seed)
+	{
+		xxHash64State state(seed);
+		state.update(data, size);
+		return state.digest();
+	}
+
+	xxHash64State::xxHash64State(uint64_t seed)
+	{
+		reset(seed);
+	}
+
+	void xxHash64State::reset(uint64_t seed)
+	{
+		m_seed = seed;
+		m_accumulators[0] = seed + PRIME64_1 + PRIME64_2;
+		m_accumulators[1] = seed + PRIME64_2;
+		m_accumulators[2] = seed;
+		m_accumulators[3] = seed - PRIME64_1;
+		m_stripeSize = 0;
+		m_totalSize = 0;
+	}
+
+	void xxHash64State::update(const void* data, size_t size)
+	{
+		const unsigned char* in = static_cast<const unsigned char*>(data);
+		m_totalSize += size;
+		if(m_stripeSize + size < sizeof(m_stripe))
+		{
+			memcpy(m_stripe + m_stripeSize, in, size);
+			m_stripeSize += size;
+			return;
+		}
+		if(m_stripeSize > 0) // Complete the pending stripe
+		{
+			size_t missing = sizeof(m_stripe) - m_stripeSize;
+			memcpy(m_stripe + m_stripeSize, in, missing);
+			for(int i = 0; i < 4; ++i)
+			{
+				m_accumulators[i] = round64(m_accumulators[i], read64(m_stripe + 8 * i));
+			}
+			in += missing;
+			size -= missing;
+			m_stripeSize = 0;
+		}
+		uint64_t v1 = m_accumulators[0];
+		uint64_t v2 = m_accumulators[1];
+		uint64_t v3 = m_accumulators[2];
+		uint64_t v4 = m_accumulators[3];
+		while(size >= 32)
+		{
+			v1 = round64(v1, read64(in));
+			v2 = round64(v2, read64(in + 8));
+			v3 = round64(v3, read64(in + 16));
+			v4 = round64(v4, read64(in + 24));
+			in += 32;
+			size -= 32;
+		}
+		m_accumulators[0] = v1;
+		m_accumulators[1] = v2;
+		m_accumulators[2] = v3;
+		m_accumulators[3] = v4;
+		memcpy(m_stripe, in, size);
+		m_stripeSize = size;
+	}
+
+	uint64_t xxHash64State::digest() const
+	{
+		uint64_t hash;
+		if(m_totalSize >= 32)
+		{
+			hash = rotateLeft(m_accumulators[0], 1) + rotateLeft(m_accumulators[1], 7) + rotateLeft(m_accumulators[2], 12) + rotateLeft(m_accumulators[3], 18);
+			for(int i = 0; i < 4; ++i)
+			{
+				hash = mergeRound(hash, m_accumulators[i]);
+			}
+		}
+		else
+		{
+			hash = m_seed + PRIME64_5;
+		}
+		hash += m_totalSize;
+		return finalize(hash, m_stripe, m_stripeSize);
+	}
+}
+
+//  ______________________________
+// |                              |
+// |    ______________________    |       
+// |   |                      |   |
+// |   |         sign         |   |
+// |   |        coding        |   |
+// |   |        dw@rf         |   |
+// |   |         1.0          |   |
+// |   |______________________|   |
+// |                              |
+// |______________________________|
+//               |  |           
+//               |  |             
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |  |
+//               |__|
@@ -13,10 +13,42 @@
  */
 
 #include <iostream>
+#include <fstream>
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <cstring>
+#include <ctime>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
 
 #include "dirParser.h"
+#include "dirWalker.h"
+#include "dirWatcher.h"
+#include "pathBuffer.h"
+#include "treeFingerprint.h"
+#include "xxHash.h"
 #include "menuManager.h"
 
+/*!
+* @def WALK_BENCH_DIRS
+* @brief Number of directories of the benchmark tree, each one in a parent directory holding 100 of them
+*/
+#ifndef WALK_BENCH_DIRS
+#define WALK_BENCH_DIRS 1000
+#endif
+
+/*!
+* @def WALK_BENCH_FILES
+* @brief Number of files in each directory of the benchmark tree
+*/
+#ifndef WALK_BENCH_FILES
+#define WALK_BENCH_FILES 1000
+#endif
+
 using namespace std;
 
 /*! \class applicationDir
@@ -50,6 +82,10 @@ public:
 
 	virtual bool update()
 	{
+		if(!hasChanged()) // Nothing to do, update may be called often
+		{
+			return m_dirLoaded;
+		}
 		m_dirLoaded = true;
 		setDir();
 		setAddDir();
@@ -164,6 +200,454 @@ void testInheritance()
 	}
 }
 
+/*!
+* @brief Directory descriptors example
+*
+* Registers a folder kept open by dirParser, creates files in it with openAt and compares statAt with stat on full paths
+*
+*/
+void testDirFd()
+{
+	cout << "Directory descriptors example" << endl << endl;
+
+	dwf_utils::dirParser fP;
+	int logDir = fP.registerDir(dwf_utils::dirParser::WORKING_DIR, "log/", true); // Created if needed
+	if(!fP.getDirLoaded() || logDir < 0)
+	{
+		cout << "Could not open application folders" << endl;
+		return;
+	}
+	cout << "Log Directory : " << fP.getDirPath(logDir) << " opened as descriptor " << fP.getDirFd(logDir) << endl;
+
+	const unsigned int fileNb = 100;
+	vector<string> names;
+	for(unsigned int i = 0; i < fileNb; ++i)
+	{
+		names.push_back("dirFd_" + to_string(i) + ".log");
+		int fd = fP.openAt(logDir, names.back().c_str(), O_WRONLY | O_CREAT | O_TRUNC);
+		if(fd < 0 || write(fd, "log\n", 4) != 4)
+		{
+			cout << "Could not write " << names.back() << endl;
+		}
+		if(fd >= 0)
+		{
+			close(fd);
+		}
+	}
+
+	const unsigned int loopNb = 2000;
+	struct stat status;
+	unsigned long long bytes = 0;
+	auto start = chrono::steady_clock::now();
+	for(unsigned int loop = 0; loop < loopNb; ++loop)
+	{
+		for(unsigned int i = 0; i < fileNb; ++i)
+		{
+			if(stat((fP.getWDir() + "log/" + names[i]).c_str(), &status) == 0) // Path built and resolved each time
+			{
+				bytes += status.st_size;
+			}
+		}
+	}
+	double pathTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	start = chrono::steady_clock::now();
+	dwf_utils::pathBuffer path(fP.getWDir());
+	path.join("log/");
+	size_t dirSize = path.size();
+	for(unsigned int loop = 0; loop < loopNb; ++loop)
+	{
+		for(unsigned int i = 0; i < fileNb; ++i)
+		{
+			path.truncate(dirSize);
+			path.join(names[i]);
+			if(stat(path.c_str(), &status) == 0) // Path built without allocation, still resolved each time
+			{
+				bytes += status.st_size;
+			}
+		}
+	}
+	double bufferTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	start = chrono::steady_clock::now();
+	for(unsigned int loop = 0; loop < loopNb; ++loop)
+	{
+		for(unsigned int i = 0; i < fileNb; ++i)
+		{
+			if(fP.statAt(logDir, names[i].c_str(), status))
+			{
+				bytes += status.st_size;
+			}
+		}
+	}
+	double fdTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	cout << loopNb * fileNb << " stat on full paths : " << pathTime << " s" << endl;
+	cout << loopNb * fileNb << " stat on pathBuffer paths : " << bufferTime << " s" << endl;
+	cout << loopNb * fileNb << " statAt on the log directory : " << fdTime << " s" << endl;
+	cout << bytes << " bytes seen" << endl;
+
+	for(unsigned int i = 0; i < fileNb; ++i)
+	{
+		unlinkat(fP.getDirFd(logDir), names[i].c_str(), 0);
+	}
+}
+
+/*!
+* @brief Path operations example
+*
+* Shows join, normalization and relative paths of pathBuffer
+*
+*/
+void testPath()
+{
+	cout << "Path operations example" << endl << endl;
+
+	dwf_utils::dirParser fP;
+	dwf_utils::pathBuffer exe(fP.getExeLoc());
+	dwf_utils::pathBuffer images(exe);
+	images.join("../DirParser/./images//");
+	cout << "Joined : " << images.c_str() << endl;
+	images.normalize();
+	cout << "Normalized : " << images.c_str() << " (" << (images.isInline() ? "inline" : "allocated") << ")" << endl;
+
+	dwf_utils::pathBuffer relative;
+	if(images.relativeTo(dwf_utils::pathBuffer(fP.getWDir()), relative) == EXEC_SUCCESS)
+	{
+		cout << "Relative to working directory : " << relative.c_str() << endl;
+	}
+	dwf_utils::pathBuffer parent(exe);
+	cout << "Parent of program location : " << parent.parent().c_str() << endl;
+	dwf_utils::pathBuffer file(images);
+	file.join("dwarf.png");
+	cout << "File name of " << file.c_str() << " : " << file.name() << endl;
+}
+
+/*!
+* @brief Change notification example
+*
+* Shows that update only reloads directories after a change and watches a folder to be told about new files
+*
+*/
+void testWatch()
+{
+	cout << "Change notification example" << endl << endl;
+
+	dwf_utils::dirParser fP;
+	int logDir = fP.registerDir(dwf_utils::dirParser::WORKING_DIR, "log/", true);
+	if(!fP.getDirLoaded() || logDir < 0)
+	{
+		cout << "Could not open application folders" << endl;
+		return;
+	}
+
+	const unsigned int updateNb = 100000;
+	auto start = chrono::steady_clock::now();
+	for(unsigned int i = 0; i < updateNb; ++i)
+	{
+		fP.update(); // Nothing changed
+	}
+	double cachedTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	start = chrono::steady_clock::now();
+	for(unsigned int i = 0; i < updateNb / 100; ++i)
+	{
+		fP.invalidate();
+		fP.update(); // Everything is read again
+	}
+	double reloadTime = chrono::duration<double>(chrono::steady_clock::now() - start).count() * 100;
+	cout << updateNb << " updates without change : " << cachedTime << " s, with reload : " << reloadTime << " s" << endl;
+
+	string previous = fP.getWDir();
+	dwf_utils::dirParser::changeDir(fP.getDirPath(logDir));
+	cout << "After changeDir, changed : " << fP.hasChanged();
+	fP.update();
+	cout << ", working Directory : " << fP.getWDir() << endl;
+	dwf_utils::dirParser::changeDir(previous);
+	fP.update();
+	cout << "Back to working Directory : " << fP.getWDir() << endl << endl;
+
+	dwf_utils::dirWatcher watcher;
+	if(watcher.addWatch(fP.getDirFd(logDir), fP.getDirPath(logDir)) < 0)
+	{
+		cout << "Could not watch " << fP.getDirPath(logDir) << endl;
+		return;
+	}
+	watcher.start([](dwf_utils::watchEvent const& event)
+	{
+		string kind = (event.m_mask & IN_CREATE) ? "created" : (event.m_mask & IN_CLOSE_WRITE) ? "written" : (event.m_mask & IN_MOVED_FROM) ? "moved from" : (event.m_mask & IN_MOVED_TO) ? "moved to" : (event.m_mask & IN_DELETE) ? "deleted" : "other event";
+		cout << "  " << event.path() << " " << kind << endl;
+	});
+	int fd = fP.openAt(logDir, "watched.log", O_WRONLY | O_CREAT | O_TRUNC);
+	if(fd >= 0)
+	{
+		if(write(fd, "log\n", 4) != 4)
+		{
+			cout << "Could not write watched.log" << endl;
+		}
+		close(fd);
+	}
+	renameat(fP.getDirFd(logDir), "watched.log", fP.getDirFd(logDir), "watched.old");
+	unlinkat(fP.getDirFd(logDir), "watched.old", 0);
+	this_thread::sleep_for(chrono::milliseconds(100)); // Let the watcher thread print the events
+	watcher.stop();
+}
+
+/*!
+* @brief Parallel walk example
+*
+* Walks the working directory with dirWalker and counts entries of each type
+*
+*/
+void testWalker()
+{
+	cout << "Parallel walk of the working directory" << endl << endl;
+
+	dwf_utils::dirParser fP;
+	if(!fP.getDirLoaded())
+	{
+		cout << "Could not find application folders" << endl;
+		return;
+	}
+
+	std::atomic<unsigned long long> files(0), directories(0), others(0), bytes(0);
+	dwf_utils::walkerOptions options;
+	options.m_stat = true; // Sizes are needed
+	options.m_maxDepth = 4;
+	dwf_utils::dirWalker walker(options);
+	int result = walker.walk(fP.getWDir(), [&](dwf_utils::dirEntry const& entry)
+	{
+		if(entry.m_type == dwf_utils::ENTRY_FILE)
+		{
+			++files;
+			if(entry.m_stat != NULL)
+			{
+				bytes += entry.m_stat->st_size;
+			}
+		}
+		else if(entry.m_type == dwf_utils::ENTRY_DIRECTORY)
+		{
+			++directories;
+			if(entry.m_depth == 1)
+			{
+				cout << entry.path() + "/\n"; // Single write, other threads may print at the same time
+			}
+			return entry.m_name[0] != '.'; // Skip hidden directories
+		}
+		else
+		{
+			++others;
+		}
+		return true;
+	});
+
+	cout << "Walk " << (result == EXEC_SUCCESS ? "succeeded" : "failed") << " with " << walker.getErrorNb() << " errors" << endl;
+	cout << files << " files (" << bytes << " bytes), " << directories << " directories and " << others << " other entries up to depth " << options.m_maxDepth << endl;
+	cout << walker.getDirectoryNb() << " directories read, " << walker.getStolenNb() << " of them stolen by another thread" << endl;
+}
+
+/*!
+* @brief Create the benchmark tree
+* @param root : path of the tree, ending with '/'
+* @return TRUE if the tree exists and FALSE otherwise
+*
+* The tree is created once and kept for the next runs.
+*
+*/
+bool createBenchTree(string const& root)
+{
+	if(access((root + "complete").c_str(), F_OK) == 0)
+	{
+		return true;
+	}
+	cout << "Creating " << WALK_BENCH_DIRS << " directories of " << WALK_BENCH_FILES << " files in " << root << endl;
+	mkdir(root.c_str(), 0755);
+	for(unsigned int i = 0; i < WALK_BENCH_DIRS; ++i)
+	{
+		string dir = root + "p" + to_string(i / 100) + "/";
+		mkdir(dir.c_str(), 0755);
+		dir += "d" + to_string(i) + "/";
+		mkdir(dir.c_str(), 0755);
+		for(unsigned int j = 0; j < WALK_BENCH_FILES; ++j)
+		{
+			int fd = open((dir + "f" + to_string(j)).c_str(), O_WRONLY | O_CREAT, 0644);
+			if(fd < 0)
+			{
+				cout << "Could not create benchmark files" << endl;
+				return false;
+			}
+			close(fd);
+		}
+	}
+	ofstream((root + "complete").c_str());
+	return true;
+}
+
+/*!
+* @brief Naive recursive walk
+* @param path : path of the directory, ending with '/'
+* @param withStat : get the status of every entry
+* @return Number of entries found
+*
+* Walk as usually written, with opendir/readdir and full paths
+*
+*/
+unsigned long long naiveWalk(string const& path, bool withStat)
+{
+	unsigned long long entries = 0;
+	DIR* dir = opendir(path.c_str());
+	if(dir == NULL)
+	{
+		return 0;
+	}
+	struct dirent* entry;
+	while((entry = readdir(dir)) != NULL)
+	{
+		string name = entry->d_name;
+		if(name == "." || name == "..")
+		{
+			continue;
+		}
+		++entries;
+		bool directory = entry->d_type == DT_DIR;
+		if(withStat)
+		{
+			struct stat status;
+			directory = lstat((path + name).c_str(), &status) == 0 && S_ISDIR(status.st_mode);
+		}
+		if(directory)
+		{
+			entries += naiveWalk(path + name + "/", withStat);
+		}
+	}
+	closedir(dir);
+	return entries;
+}
+
+/*!
+* @brief Walker benchmark
+*
+* Compares the walk of a tree of 1 million files with the naive recursive walk and with dirWalker using 1 thread or all cores.
+* Each walk is run twice and the fastest time is kept, so that directories are in cache for all of them.
+*
+*/
+void benchWalker()
+{
+	cout << "Walk of a tree of " << WALK_BENCH_DIRS * WALK_BENCH_FILES << " files" << endl << endl;
+
+	dwf_utils::dirParser fP;
+	string root = fP.getWDir() + "walkBench/";
+	if(!fP.getDirLoaded() || !createBenchTree(root))
+	{
+		return;
+	}
+
+	unsigned int cores = thread::hardware_concurrency();
+	for(int withStat = 0; withStat < 2; ++withStat)
+	{
+		cout << (withStat ? "With stat of each entry" : "Without stat") << endl;
+		for(int kind = 0; kind < (cores > 1 ? 3 : 2); ++kind) // Parallel walk only with several cores
+		{
+			double best = 0;
+			unsigned long long entries = 0;
+			for(int run = 0; run < 2; ++run)
+			{
+				auto start = chrono::steady_clock::now();
+				if(kind == 0)
+				{
+					entries = naiveWalk(root, withStat);
+				}
+				else
+				{
+					dwf_utils::walkerOptions options;
+					options.m_threadNb = kind == 1 ? 1 : 0;
+					options.m_stat = withStat;
+					dwf_utils::dirWalker walker(options);
+					walker.walk(root, [](dwf_utils::dirEntry const&) { return true; });
+					entries = walker.getEntryNb();
+				}
+				double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+				if(run == 0 || seconds < best)
+				{
+					best = seconds;
+				}
+			}
+			string name = kind == 0 ? "opendir/readdir recursion" : (kind == 1 ? "dirWalker 1 thread" : "dirWalker " + to_string(cores) + " threads");
+			cout << "  " << name << " : " << entries << " entries in " << best << " s (" << static_cast<unsigned long long>(entries / best) << " entries/s)" << endl;
+		}
+	}
+}
+
+/*!
+* @brief Write a file of the fingerprint example
+* @param path : path of the file
+* @param content : content of the file
+* @param age : number of seconds since the last modification
+* @return TRUE if file could be written and FALSE otherwise
+*
+* Files are dated in the past, so that the fingerprint can cache them at once.
+*
+*/
+bool writeDatedFile(string const& path, string const& content, time_t age)
+{
+	ofstream file(path.c_str(), ios::binary | ios::trunc);
+	file << content;
+	file.close();
+	struct timespec times[2];
+	times[0].tv_sec = time(NULL) - age;
+	times[0].tv_nsec = 0;
+	times[1] = times[0];
+	return file && utimensat(AT_FDCWD, path.c_str(), times, 0) == 0;
+}
+
+/*!
+* @brief Tree fingerprint example
+*
+* Computes the digest of a small tree twice, the second time from cache only, then after a file changed and after it was restored.
+*
+*/
+void testFingerprint()
+{
+	cout << "Tree fingerprint example" << endl << endl;
+
+	const char* vectors[] = {"", "a", "abc", "Nobody inspects the spammish repetition"};
+	for(size_t i = 0; i < sizeof(vectors) / sizeof(vectors[0]); ++i)
+	{
+		cout << "xxHash64(\"" << vectors[i] << "\") = " << hex << dwf_utils::xxHash64(vectors[i], strlen(vectors[i])) << dec << endl; // ef46db3751d8e999, d24ec4f1a98c6e5b, 44bc2cf5ad770999 and fbcea83c8a378bf1
+	}
+	cout << endl;
+
+	dwf_utils::dirParser fP;
+	string root = fP.getWDir() + "fingerprint/";
+	mkdir(root.c_str(), 0755);
+	mkdir((root + "sub").c_str(), 0755);
+	bool created = true;
+	for(int i = 0; i < 20; ++i)
+	{
+		created = writeDatedFile(root + (i % 2 ? "sub/" : "") + "file" + to_string(i), string(1000 * i, 'a' + i), 60) && created;
+	}
+	unlink((root + "link").c_str());
+	if(!created || symlink("sub/file1", (root + "link").c_str()) != 0)
+	{
+		cout << "Could not create tree in " << root << endl;
+		return;
+	}
+
+	dwf_utils::fingerprintOptions options;
+	options.m_cacheFile = fP.getWDir() + "fingerprint.cache";
+	unlink(options.m_cacheFile.c_str());
+	dwf_utils::treeFingerprint fingerprint(options);
+	auto compute = [&](string const& step)
+	{
+		uint64_t digest = 0;
+		int result = fingerprint.compute(root, digest);
+		cout << step << " : " << hex << digest << dec << (result == EXEC_SUCCESS ? "" : " with errors") << ", " << fingerprint.getEntryNb() << " entries, ";
+		cout << fingerprint.getHashedNb() << " files hashed (" << fingerprint.getHashedBytes() << " bytes), " << fingerprint.getCachedNb() << " from cache" << endl;
+	};
+	compute("Without cache");
+	compute("With cache"); // Should hash no file
+	writeDatedFile(root + "file4", string(4000, 'z'), 0);
+	compute("After change"); // Should hash one file and give another digest
+	writeDatedFile(root + "file4", string(4000, 'a' + 4), 60);
+	compute("After restore"); // Should give the first digest again
+}
+
 /*!
 * @brief Program Entry point
 * @return EXIT_SUCCESS
@@ -182,6 +666,12 @@ int main()
 	menu.addAction("1", &testDirParser, "Basic dirParser test");
 	menu.addAction("2", &testReload, "dirParser size error and reload example");
 	menu.addAction("3", &testInheritance, "Inheritance example");
+	menu.addAction("4", &testDirFd, "Directory descriptors example");
+	menu.addAction("5", &testWalker, "Parallel walk example");
+	menu.addAction("6", &benchWalker, "Walker benchmark on a 1 million files tree");
+	menu.addAction("7", &testWatch, "Change notification example");
+	menu.addAction("8", &testPath, "Path operations example");
+	menu.addAction("9", &testFingerprint, "Tree fingerprint example");
 
 	menu.enterMenu();	
 
@@ -26,12 +26,33 @@ limitations under the License.
 */
 
 #include <iostream>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <sys/socket.h>
 
 #include "common_defines.h"
 #include "fileSplitter.h"
+#include "concurrentFileSplitter.h"
+#include "splitReader.h"
+#include "fileJoiner.h"
+#include "binaryLogger.h"
+#include "shardedFileSplitter.h"
+#include "recordFraming.h"
 #include "menuManager.h"
 
 using namespace std;
+using dwf_utils::toString;
 
 /*! \class coordinates
 * \brief Example class containing coordinates
@@ -104,6 +125,1424 @@ void testWrite()
 	}
 }
 
+/*!
+* @brief Example of write file splitting based on file size
+*
+* Test of file splitter class with size condition on the number of bytes written.
+*
+*/
+void testByteWrite()
+{
+	cout << "Example of write file splitting based on file size" << endl << endl;
+
+	cout << "Go in the log folder. You should see files named testByteSplit_<Id> : " << endl;
+	cout << "   - each file contains at least 100 bytes except the last one" << endl;
+	cout << "   - each file only contains complete lines" << endl;
+
+	dwf_utils::splitterOptions options;
+	options.m_criterion = dwf_utils::SPLIT_BYTES;
+	dwf_utils::fileSplitter fS("logs/testByteSplit", ".txt", 100, options); // Change file every 100 bytes
+	coordinates c;
+
+	for(unsigned int i = 0; i < 20; ++i)
+	{
+		if(fS.getStatus())
+		{
+			fS << i << " : " << c << endl; // Lines have different sizes but are never split
+		}
+		else
+		{
+			cout << "Error, cannot write in file" << endl;
+		}
+		c.changeCoord(0.5, -0.2, 0.1);
+	}
+}
+
+/*!
+* @brief Example of record based file splitting
+*
+* Test of file splitter class with a size condition that is not a multiple of the number of operator<< calls per line. Records ensure lines are never split.
+*
+*/
+void testRecordWrite()
+{
+	cout << "Example of record based file splitting" << endl << endl;
+
+	cout << "Go in the log folder. You should see 11 files : " << endl;
+	cout << "   - testRecordSplit_0 to testRecordSplit_9 contain 2 complete lines each" << endl;
+	cout << "   - testRecordSplit_10 is empty" << endl;
+
+	dwf_utils::fileSplitter fS("logs/testRecordSplit", ".txt", 6); // 6 is not a multiple of the 4 operator<< calls by line
+	coordinates c;
+
+	for(unsigned int i = 0; i < 20; ++i)
+	{
+		if(fS.getStatus())
+		{
+			dwf_utils::fileSplitter::record r(fS); // File change can only happen when r is destroyed
+			r << i << " : " << c << endl;
+		}
+		else
+		{
+			cout << "Error, cannot write in file" << endl;
+		}
+		c.changeCoord(0.5, -0.2, 0.1);
+	}
+}
+
+/*!
+* @brief Producer thread of the concurrent write example
+* @param cfS : splitter shared by all producers
+* @param producerId : Id of the producer thread
+*
+*/
+void concurrentProducer(dwf_utils::concurrentFileSplitter* cfS, unsigned int producerId)
+{
+	coordinates c;
+	dwf_utils::concurrentFileSplitter::record r(*cfS);
+	for(unsigned int i = 0; i < 10; ++i)
+	{
+		r << "producer " << producerId << " point " << i << " : " << c << endl;
+		r.submit(); // One complete line per record
+		c.changeCoord(0.5, -0.2, 0.1);
+	}
+}
+
+/*!
+* @brief Example of concurrent write file splitting
+*
+* Test of concurrent file splitter class with 4 producer threads writing 10 records each.
+*
+*/
+void testConcurrentWrite()
+{
+	cout << "Example of concurrent write file splitting" << endl << endl;
+
+	cout << "Go in the log folder. You should see 5 files : " << endl;
+	cout << "   - testConcurrentSplit_0 to testConcurrentSplit_3 contain 10 complete lines each" << endl;
+	cout << "   - lines of a given producer are in increasing point order" << endl;
+	cout << "   - testConcurrentSplit_4 is empty" << endl;
+
+	dwf_utils::concurrentFileSplitter cfS("logs/testConcurrentSplit", ".txt", 10);
+	if(!cfS.getStatus())
+	{
+		cout << "Error, cannot write in file" << endl;
+		return;
+	}
+
+	vector<thread> producers;
+	for(unsigned int t = 0; t < 4; ++t)
+	{
+		producers.push_back(thread(&concurrentProducer, &cfS, t));
+	}
+	for(unsigned int t = 0; t < producers.size(); ++t)
+	{
+		producers[t].join();
+	}
+}
+
+/*!
+* @brief Producer thread of the benchmark using a global mutex
+* @param fS : shared splitter
+* @param fSMutex : mutex protecting the splitter
+* @param nbRecords : number of records to write
+*
+*/
+void mutexBenchProducer(dwf_utils::fileSplitter* fS, mutex* fSMutex, unsigned long nbRecords)
+{
+	coordinates c;
+	for(unsigned long i = 0; i < nbRecords; ++i)
+	{
+		lock_guard<mutex> lock(*fSMutex);
+		*fS << i << " : " << c << endl;
+	}
+}
+
+/*!
+* @brief Producer thread of the benchmark using a concurrentFileSplitter
+* @param cfS : shared splitter
+* @param nbRecords : number of records to write
+*
+*/
+void concurrentBenchProducer(dwf_utils::concurrentFileSplitter* cfS, unsigned long nbRecords)
+{
+	coordinates c;
+	dwf_utils::concurrentFileSplitter::record r(*cfS);
+	for(unsigned long i = 0; i < nbRecords; ++i)
+	{
+		r << i << " : " << c << endl;
+		r.submit();
+	}
+}
+
+/*!
+* @brief Multi-producer throughput benchmark
+*
+* Compares the throughput of a fileSplitter protected by a global mutex with the one of a concurrentFileSplitter for 1 to 32 producer threads.
+*
+*/
+void benchConcurrentWrite()
+{
+	cout << "Multi-producer throughput benchmark" << endl << endl;
+
+	const unsigned long nbRecords = 1 << 20; // Total number of records per run
+	cout << "Threads | global mutex (records/s) | concurrentFileSplitter (records/s)" << endl;
+	for(unsigned int nbThreads = 1; nbThreads <= 32; nbThreads *= 2)
+	{
+		double rates[2];
+		for(unsigned int mode = 0; mode < 2; ++mode)
+		{
+			chrono::steady_clock::time_point start = chrono::steady_clock::now();
+			{
+				vector<thread> producers;
+				if(mode == 0)
+				{
+					dwf_utils::fileSplitter fS("logs/benchMutex", ".txt", 1 << 22);
+					mutex fSMutex;
+					for(unsigned int t = 0; t < nbThreads; ++t)
+					{
+						producers.push_back(thread(&mutexBenchProducer, &fS, &fSMutex, nbRecords / nbThreads));
+					}
+					for(unsigned int t = 0; t < producers.size(); ++t)
+					{
+						producers[t].join();
+					}
+				}
+				else
+				{
+					dwf_utils::concurrentFileSplitter cfS("logs/benchConcurrent", ".txt", 1 << 20);
+					for(unsigned int t = 0; t < nbThreads; ++t)
+					{
+						producers.push_back(thread(&concurrentBenchProducer, &cfS, nbRecords / nbThreads));
+					}
+					for(unsigned int t = 0; t < producers.size(); ++t)
+					{
+						producers[t].join();
+					}
+				} // Splitters are destroyed here so all records are written when time is measured
+			}
+			chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+			rates[mode] = nbRecords / elapsed.count();
+		}
+		cout << "   " << nbThreads << "\t| " << rates[0] << "\t\t| " << rates[1] << endl;
+	}
+}
+
+/*!
+* @brief Measure write latencies of a fileSplitter
+* @param options : options of the splitter
+* @param latencies : vector receiving the latency of each line in nanoseconds
+*
+*/
+void measureLatencies(dwf_utils::splitterOptions const& options, vector<double>& latencies)
+{
+	const unsigned int nbLines = 200000;
+	coordinates c;
+	latencies.clear();
+	latencies.reserve(nbLines);
+
+	dwf_utils::fileSplitter fS("logs/benchRotation", ".txt", 400, options); // A file change every 100 lines
+	for(unsigned int i = 0; i < nbLines; ++i)
+	{
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		fS << i << " : " << c << endl;
+		latencies.push_back(chrono::duration<double, nano>(chrono::steady_clock::now() - start).count());
+	}
+	sort(latencies.begin(), latencies.end());
+}
+
+/*!
+* @brief File change latency benchmark
+*
+* Compares the line write latency distribution with files opened and closed inline and with files prepared in advance.
+*
+*/
+void benchRotationLatency()
+{
+	cout << "File change latency benchmark" << endl << endl;
+
+	dwf_utils::splitterOptions inlineOptions;
+	dwf_utils::splitterOptions preparedOptions;
+	preparedOptions.m_prepareNext = true;
+	preparedOptions.m_preallocate = 1 << 20;
+
+	vector<double> latencies;
+	cout << "Mode     | p50 (ns) | p99 (ns) | p99.9 (ns) | max (ns)" << endl;
+	for(unsigned int mode = 0; mode < 2; ++mode)
+	{
+		measureLatencies(mode == 0 ? inlineOptions : preparedOptions, latencies);
+		size_t n = latencies.size();
+		cout << (mode == 0 ? "inline   | " : "prepared | ") << latencies[n / 2] << " | " << latencies[n * 99 / 100] << " | " << latencies[n * 999 / 1000] << " | " << latencies[n - 1] << endl;
+	}
+}
+
+/*!
+* @brief Write lines at a given rate
+* @tparam Writer : type of the flux written. Must contain operator<<.
+* @param out : flux written
+* @param rate : producer rate in bytes per second, 0 for unlimited rate
+* @param total : number of bytes to write
+* @param busy : receives the time spent writing in seconds
+* @return Elapsed time in seconds
+*
+*/
+template <class Writer>
+double writeAtRate(Writer& out, double rate, unsigned long long total, double& busy)
+{
+	const string line = "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ.\n"; // 64 bytes
+	const unsigned long long sliceBytes = rate > 0 ? static_cast<unsigned long long>(rate / 1000) : total; // Lines written every millisecond
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	chrono::steady_clock::time_point deadline = start;
+	busy = 0;
+	unsigned long long written = 0;
+	while(written < total)
+	{
+		chrono::steady_clock::time_point busyStart = chrono::steady_clock::now();
+		for(unsigned long long slice = 0; slice < sliceBytes && written < total; slice += line.size())
+		{
+			out << line;
+			written += line.size();
+		}
+		busy += chrono::duration<double>(chrono::steady_clock::now() - busyStart).count();
+		if(rate > 0)
+		{
+			deadline += chrono::milliseconds(1);
+			this_thread::sleep_until(deadline);
+		}
+	}
+	return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+/*!
+* @brief Write engines benchmark
+*
+* Compares the time spent writing with a plain ofstream and with the fileSplitter buffered, io_uring and mmap engines at several producer rates.
+*
+*/
+void benchWriteEngines()
+{
+	cout << "Write engines benchmark" << endl << endl;
+
+	const double rates[] = {1e6, 4e6, 16e6, 0}; // Bytes per second, 0 is unlimited
+	const char* modeNames[] = {"ofstream", "buffered", "io_uring", "mmap"};
+	const dwf_utils::writerMode writers[] = {dwf_utils::WRITER_BUFFERED, dwf_utils::WRITER_BUFFERED, dwf_utils::WRITER_URING, dwf_utils::WRITER_MMAP};
+	const char* fileNames[] = {"logs/benchEngine_ofstream.txt", "logs/benchEngineBuffered", "logs/benchEngineUring", "logs/benchEngineMmap"};
+	cout << "Rate (MB/s) | Writer   | Busy time (%) | Throughput (MB/s)" << endl;
+	for(unsigned int r = 0; r < 4; ++r)
+	{
+		unsigned long long total = rates[r] > 0 ? static_cast<unsigned long long>(rates[r]) : 256ULL << 20; // One second of data or 256 MB
+		for(unsigned int mode = 0; mode < 4; ++mode)
+		{
+			double busy = 0;
+			double elapsed = 0;
+			if(mode == 0)
+			{
+				ofstream out(fileNames[mode]);
+				elapsed = writeAtRate(out, rates[r], total, busy);
+			}
+			else
+			{
+				dwf_utils::splitterOptions options;
+				options.m_criterion = dwf_utils::SPLIT_BYTES;
+				options.m_writer = writers[mode];
+				dwf_utils::fileSplitter fS(fileNames[mode], ".txt", 64 << 20, options);
+				elapsed = writeAtRate(fS, rates[r], total, busy);
+			}
+			cout << (rates[r] > 0 ? toString(rates[r] / 1e6) : "max") << "\t| " << modeNames[mode] << "\t| " << 100 * busy / elapsed << "\t| " << total / elapsed / 1e6 << endl;
+		}
+	}
+}
+
+/*!
+* @brief Example of memory-mapped file splitting
+*
+* Test of file splitter class writing through a memory mapping. Files are reserved in advance and truncated to their content when changed.
+*
+*/
+void testMmapWrite()
+{
+	cout << "Example of memory-mapped file splitting" << endl << endl;
+
+	cout << "Go in the log folder. You should see files named testMmapSplit_<Id> : " << endl;
+	cout << "   - each file contains 1000 complete lines and is exactly 17000 bytes long" << endl;
+	cout << "   - no file ends with null bytes" << endl;
+
+	dwf_utils::splitterOptions options;
+	options.m_writer = dwf_utils::WRITER_MMAP;
+	dwf_utils::fileSplitter fS("logs/testMmapSplit", ".txt", 1000, options); // 1000 records per file
+	for(unsigned int i = 0; i < 5000; ++i)
+	{
+		if(!fS.getStatus())
+		{
+			cout << "Error, cannot write in file" << endl;
+			return;
+		}
+		fS << "mapped line " + toString(i % 1000 + 1000) + "\n"; // 17 bytes per line
+	}
+}
+
+/*!
+* @brief Get number of bytes of a file present in the page cache
+* @param fileName : name of the file
+* @return Number of cached bytes
+*
+*/
+unsigned long long cachedBytes(const string& fileName)
+{
+	int fd = open(fileName.c_str(), O_RDONLY);
+	struct stat info;
+	if(fd < 0 || fstat(fd, &info) != 0 || info.st_size == 0)
+	{
+		fd >= 0 && close(fd);
+		return 0;
+	}
+	unsigned long long cached = 0;
+	size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+	void* map = mmap(NULL, info.st_size, PROT_READ, MAP_SHARED, fd, 0); // Mapping without access does not load pages
+	if(map != MAP_FAILED)
+	{
+		vector<unsigned char> resident((info.st_size + page - 1) / page);
+		if(mincore(map, info.st_size, &resident[0]) == 0)
+		{
+			for(size_t i = 0; i < resident.size(); ++i)
+			{
+				cached += (resident[i] & 1) * page;
+			}
+		}
+		munmap(map, info.st_size);
+	}
+	close(fd);
+	return cached;
+}
+
+/*!
+* @brief Page cache footprint benchmark
+*
+* Compares the throughput and the amount of written data left in the page cache by the buffered and direct engines.
+*
+*/
+void benchPageCache()
+{
+	cout << "Page cache footprint benchmark" << endl << endl;
+
+	const unsigned long long total = 256ULL << 20;
+	const unsigned long fileSize = 64 << 20;
+	const char* modeNames[] = {"buffered", "direct"};
+	const char* baseNames[] = {"logs/benchCacheBuffered", "logs/benchCacheDirect"};
+	cout << "Writer   | Throughput (MB/s) | Cached (MB)" << endl;
+	for(unsigned int mode = 0; mode < 2; ++mode)
+	{
+		double busy = 0;
+		double elapsed = 0;
+		{
+			dwf_utils::splitterOptions options;
+			options.m_criterion = dwf_utils::SPLIT_BYTES;
+			options.m_writer = mode == 0 ? dwf_utils::WRITER_BUFFERED : dwf_utils::WRITER_DIRECT;
+			dwf_utils::fileSplitter fS(baseNames[mode], ".txt", fileSize, options);
+			elapsed = writeAtRate(fS, 0, total, busy);
+		}
+		unsigned long long cached = 0;
+		for(unsigned long id = 0; id <= total / fileSize; ++id)
+		{
+			cached += cachedBytes(string(baseNames[mode]) + "_" + toString(id) + ".txt");
+		}
+		cout << modeNames[mode] << "\t| " << total / elapsed / 1e6 << "\t| " << cached / 1e6 << endl;
+	}
+}
+
+/*!
+* @brief Group commit benchmark
+*
+* Several threads write records and wait for each of them to be on disk. Waits of different threads share the same flush.
+*
+*/
+void benchGroupCommit()
+{
+	cout << "Group commit benchmark" << endl << endl;
+
+	const unsigned int threadNbs[] = {1, 4, 16};
+	const unsigned int recordNb = 2000; // Durable records per test
+	cout << "Threads | Records/s | Flushes | Mean batch | Mean flush (us) | Max flush (us)" << endl;
+	for(unsigned int t = 0; t < 3; ++t)
+	{
+		unsigned int threadNb = threadNbs[t];
+		dwf_utils::splitterOptions options;
+		options.m_criterion = dwf_utils::SPLIT_BYTES;
+		options.m_durability = dwf_utils::DURABLE_GROUP;
+		dwf_utils::concurrentFileSplitter fS("logs/benchGroupCommit" + toString(threadNb), ".txt", 16 << 20, options);
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		vector<thread> producers;
+		for(unsigned int i = 0; i < threadNb; ++i)
+		{
+			producers.push_back(thread([&fS, i, threadNb, recordNb]()
+			{
+				for(unsigned int r = 0; r < recordNb / threadNb; ++r)
+				{
+					fS.submit("thread " + toString(i) + " record " + toString(r) + "\n");
+					fS.waitDurable();
+				}
+			}));
+		}
+		for(size_t i = 0; i < producers.size(); ++i)
+		{
+			producers[i].join();
+		}
+		double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+		dwf_utils::durabilityStats stats = fS.getDurabilityStats();
+		cout << threadNb << "\t| " << recordNb / elapsed << "\t| " << stats.m_syncNb << "\t| " << (stats.m_syncNb > 0 ? double(stats.m_released) / stats.m_syncNb : 0) << "\t| " << (stats.m_syncNb > 0 ? stats.m_syncTime / stats.m_syncNb : 0) << "\t| " << stats.m_maxSyncTime << endl;
+	}
+}
+
+/*!
+* @brief Example of manifest and record seeking
+*
+* Writes records with and without manifest to compare the write cost, then reads some records back directly with splitReader.
+*
+*/
+void testManifest()
+{
+	cout << "Example of manifest and record seeking" << endl << endl;
+
+	const unsigned int recordNb = 1000000;
+	for(unsigned int mode = 0; mode < 2; ++mode)
+	{
+		dwf_utils::splitterOptions options;
+		options.m_criterion = dwf_utils::SPLIT_BYTES;
+		options.m_manifest = mode == 1;
+		options.m_indexInterval = 128;
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		{
+			dwf_utils::fileSplitter fS(mode == 1 ? "logs/testManifest" : "logs/testNoManifest", ".txt", 1 << 20, options);
+			for(unsigned int i = 0; i < recordNb; ++i)
+			{
+				dwf_utils::fileSplitter::record rec(fS); // Each line is a record
+				rec << "record " << i << "\n";
+			}
+		}
+		double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+		cout << (mode == 1 ? "With manifest    : " : "Without manifest : ") << 1e9 * elapsed / recordNb << " ns per record" << endl;
+	}
+
+	cout << endl << "Go in the log folder. You should see testManifest.manifest listing every testManifest_<Id>.txt file with its .idx index" << endl;
+	cout << "Record i is the line of number i" << endl << endl;
+	dwf_utils::splitReader reader("logs/testManifest");
+	cout << reader.getSegmentNb() << " files, " << reader.getRecordNb() << " records" << endl;
+	const unsigned long long records[] = {0, 12345, 654321, recordNb - 1};
+	for(unsigned int i = 0; i < 4; ++i)
+	{
+		string line;
+		if(reader.seekRecord(records[i]) == EXEC_SUCCESS && reader.getLine(line))
+		{
+			cout << "Record " << records[i] << " : " << line << endl;
+		}
+		else
+		{
+			cout << "Error, cannot read record " << records[i] << endl;
+		}
+	}
+
+	cout << endl << "Without record guards, each line is still a record. Files are read from the log folder" << endl;
+	{
+		dwf_utils::splitterOptions options;
+		options.m_criterion = dwf_utils::SPLIT_BYTES;
+		options.m_manifest = true;
+		options.m_indexInterval = 128;
+		dwf_utils::fileSplitter fS("logs/testManifestLines", ".txt", 1 << 20, options);
+		for(unsigned int i = 0; i < recordNb; ++i)
+		{
+			fS << "line " << i << endl; // Three insertions, one record
+		}
+	}
+	if(chdir("logs") != 0) // Names of the manifest are relative to its folder
+	{
+		return;
+	}
+	dwf_utils::splitReader lineReader("testManifestLines");
+	cout << lineReader.getSegmentNb() << " files, " << lineReader.getRecordNb() << " records" << endl;
+	for(unsigned int i = 0; i < 4; ++i)
+	{
+		string line;
+		if(lineReader.seekRecord(records[i]) == EXEC_SUCCESS && lineReader.getLine(line))
+		{
+			cout << "Record " << records[i] << " : " << line << endl;
+		}
+		else
+		{
+			cout << "Error, cannot read record " << records[i] << endl;
+		}
+	}
+	if(chdir("..") != 0)
+	{
+		cout << "Could not go back to the working directory" << endl;
+	}
+}
+
+/*!
+* @brief Parallel reading benchmark
+*
+* Writes split files then counts their lines with fileJoiner using an increasing number of threads. First line of each unit is gathered in order to check ordering.
+*
+*/
+void benchJoiner()
+{
+	cout << "Parallel reading benchmark" << endl << endl;
+
+	const unsigned int lineNb = 4000000;
+	{
+		dwf_utils::splitterOptions options;
+		options.m_criterion = dwf_utils::SPLIT_BYTES;
+		dwf_utils::fileSplitter fS("logs/benchJoiner", ".txt", 16 << 20, options);
+		for(unsigned int i = 0; i < lineNb; ++i)
+		{
+			fS << "line " << i << " of the parallel reading benchmark\n";
+		}
+	}
+
+	const unsigned int threadNbs[] = {1, 2, 4, 8, 16, 32};
+	cout << "Threads | Lines | Units | Ordered | Throughput (MB/s)" << endl;
+	for(unsigned int t = 0; t < 6; ++t)
+	{
+		dwf_utils::fileJoiner joiner("logs/benchJoiner", ".txt", threadNbs[t], 4 << 20);
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		vector<pair<unsigned long long, string> > results; // Lines and first line of each unit
+		std::function<pair<unsigned long long, string>(dwf_utils::segmentView const&)> task = [](dwf_utils::segmentView const& view)
+		{
+			unsigned long long lines = count(view.m_data, view.m_data + view.m_size, '\n');
+			return make_pair(lines, string(view.m_data, find(view.m_data, view.m_data + view.m_size, ' ') - view.m_data + 12));
+		};
+		joiner.map(task, results);
+		double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+		unsigned long long lines = 0;
+		unsigned long long bytes = 0;
+		bool ordered = true;
+		long previous = -1;
+		for(size_t i = 0; i < results.size(); ++i)
+		{
+			lines += results[i].first;
+			if(results[i].first == 0) // Unit without any line start
+			{
+				continue;
+			}
+			long first = atol(results[i].second.c_str() + 5);
+			ordered = ordered && first > previous;
+			previous = first;
+		}
+		for(size_t i = 0; i < joiner.getSegmentNb(); ++i)
+		{
+			ifstream segment(joiner.getSegment(i).c_str(), ios::binary | ios::ate);
+			bytes += segment.tellg();
+		}
+		cout << threadNbs[t] << "\t| " << lines << "\t| " << results.size() << "\t| " << (ordered ? "yes" : "no") << "\t| " << bytes / elapsed / 1e6 << endl;
+	}
+}
+
+/*!
+* @brief Example of file retention
+*
+* Test of file splitter class keeping a bounded number of files. The oldest file is renamed and reused for each new file.
+*
+*/
+void testRetention()
+{
+	cout << "Example of file retention" << endl << endl;
+
+	cout << "Go in the log folder. You should see : " << endl;
+	cout << "   - only files testRetention_17 to testRetention_20, the first three containing 5 lines and the last one empty" << endl;
+	cout << "   - testRetention.manifest listing these 4 files" << endl;
+	cout << "   - the same files and manifest for testRetention_prepared, written with the next file prepared in advance" << endl << endl;
+
+	const char* baseNames[2] = {"logs/testRetention", "logs/testRetention_prepared"};
+	for(unsigned int p = 0; p < 2; ++p)
+	{
+		{
+			dwf_utils::splitterOptions options;
+			options.m_manifest = true;
+			options.m_maxSegments = 4;
+			options.m_prepareNext = p == 1;
+			dwf_utils::fileSplitter fS(baseNames[p], ".txt", 5, options); // Change file every 5 lines
+			for(unsigned int i = 0; i < 100; ++i)
+			{
+				if(!fS.getStatus())
+				{
+					cout << "Error, cannot write in file" << endl;
+					return;
+				}
+				fS << "line " + toString(i) + "\n";
+			}
+		}
+		unsigned int kept = 0;
+		struct stat info;
+		for(unsigned int id = 0; id <= 21; ++id) // File prepared in advance must not have cost a kept file
+		{
+			kept += stat((string(baseNames[p]) + "_" + toString(id) + ".txt").c_str(), &info) == 0;
+		}
+		cout << baseNames[p] << " : " << kept << " files kept" << endl;
+	}
+}
+
+/*!
+* @brief Example of time based file splitting
+*
+* Test of file splitter class changing file every 2 seconds, with time stamped file names, then comparison of the insertion cost with and without time rotation.
+*
+*/
+void testTimeRotation()
+{
+	cout << "Example of time based file splitting" << endl << endl;
+
+	cout << "Go in the log folder. You should see : " << endl;
+	cout << "   - 3 or 4 files testTimeRotation_<Stamp>_<Id>.txt, stamps being even seconds of UTC time" << endl;
+	cout << "   - about 20 lines per file, the first and last files being partial" << endl << endl;
+
+	dwf_utils::splitterOptions options;
+	options.m_rotatePeriod = 2;
+	options.m_timeNames = true;
+	{
+		dwf_utils::fileSplitter fS("logs/testTimeRotation", ".txt", 1000000, options); // Size never reached
+		for(unsigned int i = 0; i < 60; ++i)
+		{
+			if(!fS.getStatus())
+			{
+				cout << "Error, cannot write in file" << endl;
+				return;
+			}
+			fS << "line " + toString(i) + "\n";
+			this_thread::sleep_for(chrono::milliseconds(100));
+		}
+	}
+
+	const unsigned int lineNb = 5000000;
+	cout << "Time rotation\t| ns per line" << endl;
+	for(unsigned int rotate = 0; rotate < 2; ++rotate)
+	{
+		dwf_utils::splitterOptions benchOptions;
+		benchOptions.m_rotatePeriod = rotate ? 3600 : 0;
+		dwf_utils::fileSplitter fS("logs/benchTimeRotation", ".txt", 1000000, benchOptions);
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		for(unsigned int i = 0; i < lineNb; ++i)
+		{
+			fS << "line\n";
+		}
+		fS.flush();
+		double elapsed = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+		cout << (rotate ? "yes" : "no") << "\t\t| " << elapsed / lineNb << endl;
+	}
+}
+
+/*!
+* @brief Deferred formatting benchmark
+*
+* Compare the time spent by the logging thread with operator<< and with a binaryLogger, by bursts fitting in the logger buffer. Then check that files formatted in background and binary files formatted offline give the same text.
+*
+*/
+void benchBinaryLog()
+{
+	cout << "Deferred formatting benchmark" << endl << endl;
+
+	const unsigned int burstNb = 100;
+	const unsigned int burstSize = 10000;
+	const double recordNb = burstNb * burstSize;
+	string name = "sensor";
+	double loggingTime = 0;
+
+	{
+		dwf_utils::fileSplitter fS("logs/benchOperatorLog", ".txt", 100000000, dwf_utils::splitterOptions()); // Each record is several calls, single file
+		for(unsigned int b = 0; b < burstNb; ++b)
+		{
+			chrono::steady_clock::time_point start = chrono::steady_clock::now();
+			for(unsigned int i = 0; i < burstSize; ++i)
+			{
+				unsigned int n = b * burstSize + i;
+				fS << "record " << n << " of " << name << " value " << n * 0.25 << " flag " << (n % 2 == 0) << "\n";
+			}
+			loggingTime += chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+		}
+	}
+	cout << "Mode\t\t| ns per record on logging thread | waits" << endl;
+	cout << "operator<<\t| " << loggingTime / recordNb << "\t\t\t\t| -" << endl;
+
+	for(unsigned int raw = 0; raw < 2; ++raw)
+	{
+		dwf_utils::binaryLogger logger(raw ? "logs/benchBinaryRaw" : "logs/benchBinaryText", raw ? ".bin" : ".txt", 1000000, raw ? dwf_utils::BINLOG_RAW : dwf_utils::BINLOG_TEXT);
+		loggingTime = 0;
+		for(unsigned int b = 0; b < burstNb; ++b)
+		{
+			chrono::steady_clock::time_point start = chrono::steady_clock::now();
+			for(unsigned int i = 0; i < burstSize; ++i)
+			{
+				unsigned int n = b * burstSize + i;
+				BINARY_LOG(logger, "record {} of {} value {} flag {}\n", n, name, n * 0.25, n % 2 == 0);
+			}
+			loggingTime += chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+			logger.flush(); // Formatting of the burst is not measured
+		}
+		cout << (raw ? "binary raw" : "binary text") << "\t| " << loggingTime / recordNb << "\t\t\t\t| " << logger.getWaits() << endl;
+	}
+
+	ifstream reference("logs/benchBinaryText_0.txt", ios::binary);
+	string expected((istreambuf_iterator<char>(reference)), istreambuf_iterator<char>());
+	ostringstream decoded;
+	vector<string> files(1, "logs/benchBinaryRaw_0.bin");
+	if(dwf_utils::decodeBinaryLog(dwf_utils::formatsName("logs/benchBinaryRaw"), files, decoded) == EXEC_FAILURE)
+	{
+		cout << "Error, cannot decode binary file" << endl;
+		return;
+	}
+	ifstream operatorFile("logs/benchOperatorLog_0.txt", ios::binary);
+	string operatorText((istreambuf_iterator<char>(operatorFile)), istreambuf_iterator<char>());
+	cout << endl << "Offline decoding gives the background text : " << (decoded.str() == expected ? "yes" : "no") << endl;
+	cout << "Background text is the operator<< text : " << (expected == operatorText ? "yes" : "no") << endl;
+}
+
+/*!
+* @brief Producer of the sharded benchmark
+* @param sfS : sharded splitter receiving records
+* @param firstKey : first key of the producer
+* @param keyNb : number of keys of the producer
+* @param nbRecords : number of records to submit
+*
+*/
+void shardedBenchProducer(dwf_utils::shardedFileSplitter* sfS, unsigned int firstKey, unsigned int keyNb, unsigned long nbRecords)
+{
+	for(unsigned long i = 0; i < nbRecords; ++i)
+	{
+		unsigned int key = firstKey + i % keyNb;
+		sfS->submit(static_cast<unsigned long long>(key), "key " + toString(key) + " seq " + toString(i / keyNb) + " value " + toString(i * 0.5) + "\n");
+	}
+}
+
+/*!
+* @brief Sharded writing benchmark
+*
+* Measure throughput of several producers writing keyed records into 1 to 8 shards, then check that the records of each key are in order in the files of its shard.
+*
+*/
+void benchShards()
+{
+	cout << "Sharded writing benchmark" << endl << endl;
+
+	const unsigned int nbThreads = 4;
+	const unsigned int keysPerThread = 16;
+	const unsigned long nbRecords = 1 << 20;
+	cout << "Shards | records/s | per key order" << endl;
+	for(unsigned int shardNb = 1; shardNb <= 8; shardNb *= 2)
+	{
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		{
+			dwf_utils::shardedFileSplitter sfS("logs/benchShards" + toString(shardNb), ".txt", 1 << 18, shardNb);
+			vector<thread> producers;
+			for(unsigned int t = 0; t < nbThreads; ++t)
+			{
+				producers.push_back(thread(&shardedBenchProducer, &sfS, t * keysPerThread, keysPerThread, nbRecords / nbThreads));
+			}
+			for(unsigned int t = 0; t < producers.size(); ++t)
+			{
+				producers[t].join();
+			}
+		} // All records are written when time is measured
+		chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+		vector<long> lastSeq(nbThreads * keysPerThread, -1);
+		bool ordered = true;
+		unsigned long lines = 0;
+		for(unsigned int shard = 0; shard < shardNb; ++shard)
+		{
+			for(unsigned int id = 0; ; ++id)
+			{
+				ifstream in((dwf_utils::shardedFileSplitter::shardName("logs/benchShards" + toString(shardNb), shard) + "_" + toString(id) + ".txt").c_str());
+				if(!in)
+				{
+					break;
+				}
+				string word;
+				unsigned int key;
+				long seq;
+				string line;
+				while(getline(in, line))
+				{
+					istringstream fields(line);
+					fields >> word >> key >> word >> seq;
+					ordered = ordered && key < lastSeq.size() && seq == lastSeq[key] + 1;
+					lastSeq[key] = seq;
+					++lines;
+				}
+			}
+		}
+		cout << "   " << shardNb << "\t| " << nbRecords / elapsed.count() << "\t| " << (ordered && lines == nbRecords ? "yes" : "no") << endl;
+	}
+}
+
+/*!
+* @brief Example of compression of complete files
+*
+* Test of file splitter class compressing its complete files in background with each codec, then check that decompressed files give the written lines.
+*
+*/
+void testCompression()
+{
+	cout << "Example of compression of complete files" << endl << endl;
+
+	const unsigned int lineNb = 400000;
+	const dwf_utils::compressionCodec codecs[2] = {dwf_utils::COMPRESS_LZ, dwf_utils::COMPRESS_ZLIB};
+	const char* codecNames[2] = {"built-in", "zlib"};
+	cout << "Codec\t\t| files | raw MB | compressed MB | MB/s | skipped | identical | reader lines | joiner lines" << endl;
+	for(unsigned int c = 0; c < 2; ++c)
+	{
+		string baseName = string("logs/testCompression_") + codecNames[c];
+		dwf_utils::compressionStats stats;
+		{
+			dwf_utils::splitterOptions options;
+			options.m_compression = codecs[c];
+			options.m_manifest = true;
+			dwf_utils::fileSplitter fS(baseName, ".txt", lineNb / 4, options); // 4 complete files, last empty one is compressed too
+			for(unsigned int i = 0; i < lineNb; ++i)
+			{
+				fS << "time " + toString(1000000 + i * 17) + " sensor " + toString(i % 12) + " value " + toString((i * 7919) % 1000 * 0.125) + " status OK\n";
+			}
+			stats = fS.getCompressionStats(); // Compression may still be running here
+		}
+
+		unsigned int line = 0;
+		bool identical = true;
+		for(unsigned int id = 0; id <= 4; ++id)
+		{
+			vector<char> data;
+			if(dwf_utils::decompressFile(dwf_utils::compressedName(baseName + "_" + toString(id) + ".txt", codecs[c]), data) == EXEC_FAILURE)
+			{
+				identical = false;
+				break;
+			}
+			istringstream lines(string(data.begin(), data.end()));
+			string read;
+			while(getline(lines, read))
+			{
+				identical = identical && read == "time " + toString(1000000 + line * 17) + " sensor " + toString(line % 12) + " value " + toString((line * 7919) % 1000 * 0.125) + " status OK";
+				++line;
+			}
+		}
+
+		// Readers of the manifest decompress the files
+		dwf_utils::splitReader reader(baseName);
+		unsigned int read = 0;
+		string text;
+		while(reader.getLine(text))
+		{
+			++read;
+		}
+		dwf_utils::fileJoiner joiner(baseName, ".txt", 0, 1 << 20);
+		vector<unsigned long long> results;
+		unsigned long long joined = 0;
+		function<unsigned long long(dwf_utils::segmentView const&)> task = [](dwf_utils::segmentView const& view)
+		{
+			return static_cast<unsigned long long>(count(view.m_data, view.m_data + view.m_size, '\n'));
+		};
+		int joinResult = joiner.map(task, results);
+		for(size_t i = 0; i < results.size(); ++i)
+		{
+			joined += results[i];
+		}
+		cout << codecNames[c] << (dwf_utils::availableCodec(codecs[c]) != codecs[c] ? " (LZ)" : "") << "\t| " << stats.m_compressed << "/" << stats.m_queued << "\t| " << stats.m_rawBytes / 1e6 << "\t| " << stats.m_compressedBytes / 1e6 << "\t| " << (stats.m_time > 0 ? stats.m_rawBytes / static_cast<double>(stats.m_time) : 0) << "\t| " << stats.m_skipped << "\t| " << (identical && line == lineNb ? "yes" : "no");
+		cout << "\t| " << read << "\t| " << joined << (joinResult == EXEC_SUCCESS ? "" : " (error)") << endl;
+
+		if(c == 1) // A file of the manifest removed behind the readers is an error, not an empty file
+		{
+			string name = baseName + "_1.txt";
+			unlink(name.c_str());
+			unlink(dwf_utils::compressedName(name, codecs[c]).c_str());
+			dwf_utils::splitReader missingReader(baseName);
+			read = 0;
+			while(missingReader.getLine(text))
+			{
+				++read;
+			}
+			dwf_utils::fileJoiner missingJoiner(baseName, ".txt", 0, 1 << 20);
+			bool discovered = missingJoiner.discover() == EXEC_SUCCESS;
+			cout << endl << "After removal of " << name << " : reader stops after " << read << " lines, joiner discovery " << (discovered ? "succeeds" : "fails") << endl;
+		}
+	}
+
+	// Files removed by retention may still be waiting for compression
+	const string retentionName = "logs/testCompression_retention";
+	const unsigned int fileNb = 200;
+	{
+		dwf_utils::splitterOptions options;
+		options.m_compression = dwf_utils::COMPRESS_LZ;
+		options.m_maxSegments = 3;
+		dwf_utils::fileSplitter fS(retentionName, ".txt", 1000, options);
+		for(unsigned int i = 0; i < fileNb * 1000; ++i)
+		{
+			fS << "time " + toString(1000000 + i * 17) + " sensor " + toString(i % 12) + " status OK\n";
+		}
+	}
+	unsigned int kept = 0;
+	struct stat info;
+	for(unsigned int id = 0; id <= fileNb; ++id)
+	{
+		string name = retentionName + "_" + toString(id) + ".txt";
+		kept += stat(name.c_str(), &info) == 0;
+		kept += stat(dwf_utils::compressedName(name, dwf_utils::COMPRESS_LZ).c_str(), &info) == 0;
+	}
+	cout << endl << "With 3 files kept out of " << fileNb + 1 << " : " << kept << " files left" << endl;
+}
+
+/*!
+* @brief Read the frames of a file
+* @param name : name of the file
+* @param payloads : receives the payloads of the complete frames
+* @return Number of bytes of the file after the last complete frame
+*
+*/
+size_t readFrames(string const& name, vector<string>& payloads)
+{
+	ifstream file(name.c_str(), ios::binary);
+	string data((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+	size_t position = 0;
+	size_t frame;
+	while((frame = dwf_utils::checkFrame(data.data() + position, data.size() - position)) > 0)
+	{
+		payloads.push_back(data.substr(position + FRAME_HEADER_SIZE, frame - FRAME_HEADER_SIZE));
+		position += frame;
+	}
+	return data.size() - position;
+}
+
+/*!
+* @brief Example of framed records and crash recovery
+*
+* Test of file splitter class writing framed binary records, then simulation of torn writes at the end of the last file and recovery of its complete frames.
+*
+*/
+void testFraming()
+{
+	cout << "Example of framed records and crash recovery" << endl << endl;
+
+	const unsigned int recordNb = 100000;
+	const string baseName = "logs/testFraming";
+	unsigned long lastId = 0;
+	{
+		dwf_utils::splitterOptions options;
+		options.m_criterion = dwf_utils::SPLIT_BYTES;
+		dwf_utils::fileSplitter fS(baseName, ".bin", 4 << 20, options);
+		for(unsigned int i = 0; i < recordNb; ++i)
+		{
+			string payload = "record " + toString(i) + string(i % 200, static_cast<char>(i)); // Binary content, new lines included
+			fS.writeFrame(payload.data(), payload.size());
+		}
+		struct stat info;
+		while(stat((baseName + "_" + toString(lastId + 1) + ".bin").c_str(), &info) == 0 && info.st_size > 0)
+		{
+			++lastId;
+		}
+	}
+
+	unsigned int found = 0;
+	bool identical = true;
+	for(unsigned long id = 0; id <= lastId; ++id)
+	{
+		vector<string> payloads;
+		identical = readFrames(baseName + "_" + toString(id) + ".bin", payloads) == 0 && identical;
+		for(size_t i = 0; i < payloads.size(); ++i, ++found)
+		{
+			identical = identical && payloads[i] == "record " + toString(found) + string(found % 200, static_cast<char>(found));
+		}
+	}
+	cout << found << " records in " << lastId + 1 << " files, identical : " << (identical && found == recordNb ? "yes" : "no") << endl << endl;
+
+	string last = baseName + "_" + toString(lastId) + ".bin";
+	struct stat info;
+	stat(last.c_str(), &info);
+	unsigned long long validSize = info.st_size;
+	const char* cases[3] = {"half a frame", "mmap null bytes", "1 MB torn frame"};
+	cout << "Torn end\t\t\t| file bytes | scanned bytes | removed bytes | time (us) | recovered" << endl;
+	for(unsigned int c = 0; c < 3; ++c)
+	{
+		string torn;
+		string payload(c == 2 ? 4 << 20 : 300, 'x');
+		dwf_utils::appendFrame(torn, payload.data(), payload.size());
+		if(c == 1)
+		{
+			torn.assign(65536, '\0');
+		}
+		else
+		{
+			torn.resize(c == 0 ? torn.size() / 2 : (1 << 20) + FRAME_HEADER_SIZE);
+		}
+		{
+			ofstream file(last.c_str(), ios::binary | ios::app);
+			file.write(torn.data(), torn.size());
+		}
+
+		dwf_utils::frameRecovery result;
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		int status = dwf_utils::recoverFramedFile(last, true, result);
+		long long elapsed = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+		stat(last.c_str(), &info);
+		cout << cases[c] << "\t\t" << "| " << result.m_fileSize << "\t| " << result.m_scannedBytes << "\t| " << result.m_fileSize - result.m_validSize << "\t| " << elapsed << "\t| " << (status == EXEC_SUCCESS && static_cast<unsigned long long>(info.st_size) == validSize ? "yes" : "no") << endl;
+	}
+
+	// Crash while writing a recycled file : its previous frames must not be recovered
+	const string retentionName = baseName + "_retention";
+	const unsigned int retentionNb = (7 << 19) / (100 + FRAME_HEADER_SIZE); // 3.5 files of 1 MB
+	for(unsigned long id = 0; id < 8; ++id)
+	{
+		unlink((retentionName + "_" + toString(id) + ".bin").c_str());
+	}
+	pid_t child = fork();
+	if(child == 0)
+	{
+		dwf_utils::splitterOptions options;
+		options.m_criterion = dwf_utils::SPLIT_BYTES;
+		options.m_maxSegments = 2;
+		dwf_utils::fileSplitter fS(retentionName, ".bin", 1 << 20, options);
+		for(unsigned int i = 0; i < retentionNb; ++i)
+		{
+			string payload = "record " + toString(i);
+			payload.resize(100, '.');
+			fS.writeFrame(payload.data(), payload.size());
+		}
+		fS.flush();
+		_exit(0); // Crash : the current file is never released
+	}
+	int childStatus;
+	waitpid(child, &childStatus, 0);
+	unsigned long crashedId = 0;
+	for(unsigned long id = 0; id < 8; ++id) // Oldest files were removed
+	{
+		if(stat((retentionName + "_" + toString(id) + ".bin").c_str(), &info) == 0)
+		{
+			crashedId = id;
+		}
+	}
+	string crashed = retentionName + "_" + toString(crashedId) + ".bin";
+	dwf_utils::frameRecovery result;
+	bool recovered = crashedId > 1 && dwf_utils::recoverFramedFile(crashed, true, result) == EXEC_SUCCESS;
+	vector<string> payloads;
+	recovered = recovered && readFrames(crashed, payloads) == 0 && !payloads.empty();
+	unsigned int next = retentionNb - payloads.size(); // Frames of the crashed file must be the last ones written
+	for(size_t i = 0; i < payloads.size() && recovered; ++i, ++next)
+	{
+		recovered = payloads[i].compare(0, payloads[i].find('.'), "record " + toString(next)) == 0;
+	}
+	cout << endl << "Retention and crash : " << payloads.size() << " frames in " << crashed << ", recovered : " << (recovered ? "yes" : "no") << endl;
+}
+
+/*!
+* @brief Example of files spread over subdirectories
+*
+* Test of file splitter class writing many small files, all in the same directory or in subdirectories of 1000 files, then read them back with splitReader and with fileJoiner, through the manifest and through directory listing.
+*
+*/
+void testFanOut()
+{
+	cout << "Example of files spread over subdirectories" << endl << endl;
+
+	const unsigned int lineNb = 100000;
+	const unsigned long fanOuts[2] = {0, 1000};
+	const char* baseNames[2] = {"logs/testFanOut_flat", "logs/testFanOut_tree"};
+	cout << "Layout\t| files | write (s) | reader lines | joiner lines (manifest) | joiner lines (listing) | listing (ms)" << endl;
+	for(unsigned int l = 0; l < 2; ++l)
+	{
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		{
+			dwf_utils::splitterOptions options;
+			options.m_manifest = true;
+			options.m_fanOut = fanOuts[l];
+			dwf_utils::fileSplitter fS(baseNames[l], ".txt", 10, options); // 10000 files
+			for(unsigned int i = 0; i < lineNb; ++i)
+			{
+				fS << "line " + toString(i) + "\n";
+			}
+		}
+		double written = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+		dwf_utils::splitReader reader(baseNames[l]);
+		unsigned int read = 0;
+		string line;
+		bool ordered = true;
+		while(reader.getLine(line))
+		{
+			ordered = ordered && line == "line " + toString(read);
+			++read;
+		}
+
+		std::function<unsigned long long(dwf_utils::segmentView const&)> task = [](dwf_utils::segmentView const& view) -> unsigned long long
+		{
+			return count(view.m_data, view.m_data + view.m_size, '\n');
+		};
+		unsigned long long joined[2] = {0, 0};
+		double listing = 0;
+		for(unsigned int m = 0; m < 2; ++m)
+		{
+			if(m == 1)
+			{
+				unlink(dwf_utils::manifestName(baseNames[l]).c_str()); // Files are found by listing directories
+			}
+			start = chrono::steady_clock::now();
+			dwf_utils::fileJoiner joiner(baseNames[l], ".txt", 0, 1 << 20);
+			if(m == 1)
+			{
+				listing = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+			}
+			vector<unsigned long long> results;
+			joiner.map(task, results);
+			for(size_t i = 0; i < results.size(); ++i)
+			{
+				joined[m] += results[i];
+			}
+		}
+		cout << (fanOuts[l] == 0 ? "flat" : "tree") << "\t| " << reader.getSegmentNb() << "\t| " << written << "\t| " << read << (ordered ? " ordered" : " unordered") << "\t| " << joined[0] << "\t| " << joined[1] << "\t| " << listing * 1000 << endl;
+	}
+}
+
+/*!
+* @brief Get number of write system calls of the process
+* @return syscw field of /proc/self/io, 0 if not available
+*
+*/
+unsigned long long writeCalls()
+{
+	ifstream io("/proc/self/io");
+	string field;
+	unsigned long long value = 0;
+	while(io >> field >> value)
+	{
+		if(field == "syscw:")
+		{
+			return value;
+		}
+	}
+	return 0;
+}
+
+/*!
+* @brief Write buffer size benchmark
+*
+* Measure throughput and number of write system calls of file splitter class for several buffer sizes, with short lines mixed with blocks larger than the default buffer.
+*
+*/
+void benchBufferSize()
+{
+	cout << "Write buffer size benchmark" << endl << endl;
+
+	const unsigned int lineNb = 2000000;
+	const size_t bufferSizes[4] = {0, 64 << 10, 256 << 10, 1 << 20};
+	string block(12 << 10, 'b'); // Larger than default buffer
+	block[block.size() - 1] = '\n';
+	vector<string> lines(1000); // Formatting is not measured
+	for(unsigned int i = 0; i < lines.size(); ++i)
+	{
+		lines[i] = "time " + toString(1000000 + i) + " sensor " + toString(i % 12) + " OK\n";
+	}
+	cout << "Buffer\t\t| MB/s | write calls | KB per call" << endl;
+	for(unsigned int b = 0; b < 4; ++b)
+	{
+		dwf_utils::splitterOptions options;
+		options.m_criterion = dwf_utils::SPLIT_BYTES;
+		options.m_bufferSize = bufferSizes[b];
+		unsigned long long calls = writeCalls();
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		unsigned long long bytes = 0;
+		{
+			dwf_utils::fileSplitter fS("logs/benchBufferSize" + toString(b), ".txt", 1UL << 30, options);
+			for(unsigned int i = 0; i < lineNb; ++i)
+			{
+				string const& line = lines[i % lines.size()];
+				fS << line;
+				bytes += line.size();
+				if(i % 256 == 255)
+				{
+					fS.write(block.data(), block.size());
+					bytes += block.size();
+				}
+			}
+		}
+		double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+		calls = writeCalls() - calls;
+		cout << (bufferSizes[b] == 0 ? string("default (") + toString(SEGMENTBUF_DEFAULT_SIZE >> 10) + " KB)" : toString(bufferSizes[b] >> 10) + " KB\t") << "\t| " << bytes / elapsed / 1e6 << "\t| " << calls << "\t| " << (calls > 0 ? bytes / 1024.0 / calls : 0) << endl;
+	}
+}
+
+/*!
+* @brief Example of statistics export
+*
+* Test of concurrent file splitter class written by several producers while another thread exports its statistics to a file every 10 ms, then display of the last snapshot and exported file.
+*
+*/
+void testStats()
+{
+	cout << "Example of statistics export" << endl << endl;
+
+	const unsigned int producerNb = 4;
+	const unsigned int recordNb = 200000;
+	dwf_utils::splitterOptions options;
+	options.m_criterion = dwf_utils::SPLIT_BYTES;
+	options.m_prepareNext = true;
+	dwf_utils::concurrentFileSplitter cfS("logs/testStats", ".txt", 1 << 20, options);
+
+	atomic<bool> done(false);
+	unsigned int exports = 0;
+	thread exporter([&cfS, &done, &exports]()
+	{
+		while(!done.load())
+		{
+			vector<pair<string, dwf_utils::splitterStats> > splitters(1, make_pair(string("testStats"), cfS.getStats()));
+			exports += dwf_utils::exportStats("logs/testStats.prom", dwf_utils::formatStats(splitters)) == EXEC_SUCCESS;
+			this_thread::sleep_for(chrono::milliseconds(10));
+		}
+	});
+	vector<thread> producers;
+	for(unsigned int p = 0; p < producerNb; ++p)
+	{
+		producers.push_back(thread([&cfS, p, recordNb]()
+		{
+			for(unsigned int r = 0; r < recordNb; ++r)
+			{
+				cfS.submit("producer " + toString(p) + " record " + toString(r) + "\n");
+			}
+		}));
+	}
+	for(unsigned int p = 0; p < producerNb; ++p)
+	{
+		producers[p].join();
+	}
+	cfS.flush();
+	done.store(true);
+	exporter.join();
+
+	dwf_utils::splitterStats stats = cfS.getStats();
+	vector<pair<string, dwf_utils::splitterStats> > splitters(1, make_pair(string("testStats"), stats));
+	dwf_utils::exportStats("logs/testStats.prom", dwf_utils::formatStats(splitters));
+	cout << "Records : " << stats.m_records << " (expected " << producerNb * recordNb << "), bytes : " << stats.m_bytes << ", files changes : " << stats.m_rotations << endl;
+	cout << "Change latency : mean " << (stats.m_rotations > 0 ? stats.m_rotationTime / stats.m_rotations : 0) << " us, max " << stats.m_maxRotationTime << " us, max queue depth : " << stats.m_maxQueueDepth << ", dropped : " << stats.m_dropped << ", failures : " << stats.m_openFailures + stats.m_closeFailures << endl;
+	cout << exports << " exports during writing, last export :" << endl << endl;
+	ifstream exported("logs/testStats.prom");
+	string line;
+	while(getline(exported, line))
+	{
+		cout << line << endl;
+	}
+}
+
+/*!
+* @brief Read split files as a single block
+* @param baseName : base name of the files
+* @param extension : extension of the files
+* @param fileNb : receives the number of files
+* @return Concatenated content of the files
+*
+*/
+string readSplitFiles(string const& baseName, string const& extension, unsigned int& fileNb)
+{
+	string content;
+	for(fileNb = 0; ; ++fileNb)
+	{
+		ifstream file((baseName + "_" + toString(fileNb) + extension).c_str(), ios::binary);
+		if(!file)
+		{
+			break;
+		}
+		content.append((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+	}
+	return content;
+}
+
+/*!
+* @brief Example of data moved from descriptors
+*
+* Test of file splitter class capturing the output of a child process through a pipe, the content of a file and data received on a socket, without copy through user space, then check of the split files.
+*
+*/
+void testIngest()
+{
+	cout << "Example of data moved from descriptors" << endl << endl;
+
+	string expected;
+	for(unsigned int i = 1; i <= 3000000; ++i)
+	{
+		expected += toString(i) + "\n";
+	}
+	const char* sources[3] = {"child process pipe", "file", "socket"};
+	const char* baseNames[3] = {"logs/testIngest_pipe", "logs/testIngest_file", "logs/testIngest_socket"};
+	cout << "Source\t\t\t| MB | files | MB/s | identical" << endl;
+	for(unsigned int src = 0; src < 3; ++src)
+	{
+		int fds[2] = {-1, -1};
+		pid_t child = -1;
+		thread sender;
+		if(src == 0) // Output of seq command
+		{
+			if(pipe(fds) != 0 || (child = fork()) < 0)
+			{
+				cout << "Could not start child process" << endl;
+				return;
+			}
+			if(child == 0)
+			{
+				dup2(fds[1], STDOUT_FILENO);
+				close(fds[0]);
+				close(fds[1]);
+				execlp("seq", "seq", "1", "3000000", static_cast<char*>(NULL));
+				_exit(1);
+			}
+			close(fds[1]);
+		}
+		else if(src == 1) // Content written by the first case
+		{
+			ofstream source("logs/testIngest_source.txt", ios::binary);
+			source.write(expected.data(), expected.size());
+			source.close();
+			fds[0] = open("logs/testIngest_source.txt", O_RDONLY);
+		}
+		else
+		{
+			if(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0)
+			{
+				cout << "Could not create sockets" << endl;
+				return;
+			}
+			int output = fds[1];
+			sender = thread([output, &expected]()
+			{
+				for(size_t done = 0; done < expected.size(); )
+				{
+					ssize_t sent = write(output, expected.data() + done, min<size_t>(expected.size() - done, 1 << 16));
+					if(sent <= 0)
+					{
+						break;
+					}
+					done += sent;
+				}
+				close(output); // End of data for the receiver
+			});
+		}
+
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		unsigned long long moved = 0;
+		int status;
+		{
+			dwf_utils::splitterOptions options;
+			options.m_criterion = dwf_utils::SPLIT_BYTES;
+			dwf_utils::fileSplitter fS(baseNames[src], ".txt", 4 << 20, options);
+			status = fS.ingest(fds[0], ~0ULL, moved);
+		}
+		double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+		close(fds[0]);
+		if(child > 0)
+		{
+			waitpid(child, NULL, 0);
+		}
+		if(sender.joinable())
+		{
+			sender.join();
+		}
+
+		unsigned int fileNb = 0;
+		bool identical = status == EXEC_SUCCESS && readSplitFiles(baseNames[src], ".txt", fileNb) == expected;
+		cout << sources[src] << (src == 0 ? "\t" : "\t\t\t") << "| " << moved / 1e6 << "\t| " << fileNb << "\t| " << moved / elapsed / 1e6 << "\t| " << (identical ? "yes" : "no") << endl;
+	}
+}
+
 /*!
 * @brief Program Entry point
 * @return EXIT_SUCCESS
@@ -120,6 +1559,27 @@ int main()
 	dwf_utils::menuManager menu(menuHead);
 
 	menu.addAction("1", &testWrite, "Example of write file splitting");
+	menu.addAction("2", &testConcurrentWrite, "Example of concurrent write file splitting");
+	menu.addAction("3", &benchConcurrentWrite, "Multi-producer throughput benchmark");
+	menu.addAction("4", &testByteWrite, "Example of write file splitting based on file size");
+	menu.addAction("5", &testRecordWrite, "Example of record based file splitting");
+	menu.addAction("6", &benchRotationLatency, "File change latency benchmark");
+	menu.addAction("7", &benchWriteEngines, "Write engines benchmark");
+	menu.addAction("8", &testMmapWrite, "Example of memory-mapped file splitting");
+	menu.addAction("9", &benchPageCache, "Page cache footprint benchmark");
+	menu.addAction("10", &benchGroupCommit, "Group commit benchmark");
+	menu.addAction("11", &testManifest, "Example of manifest and record seeking");
+	menu.addAction("12", &benchJoiner, "Parallel reading benchmark");
+	menu.addAction("13", &testRetention, "Example of file retention");
+	menu.addAction("14", &testTimeRotation, "Example of time based file splitting");
+	menu.addAction("15", &benchBinaryLog, "Deferred formatting benchmark");
+	menu.addAction("16", &benchShards, "Sharded writing benchmark");
+	menu.addAction("17", &testCompression, "Example of compression of complete files");
+	menu.addAction("18", &testFraming, "Example of framed records and crash recovery");
+	menu.addAction("19", &testFanOut, "Example of files spread over subdirectories");
+	menu.addAction("20", &benchBufferSize, "Write buffer size benchmark");
+	menu.addAction("21", &testStats, "Example of statistics export");
+	menu.addAction("22", &testIngest, "Example of data moved from descriptors");
 
 	menu.enterMenu();	
 